@@ -181,21 +181,55 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 #endif
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task(ThreadData *p_thread_data) {
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		Task *task = nullptr;
+		if (victim.local_queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_task_lock_free(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->local_queue.pop(task)) {
+		return task;
+	}
+	if (task_queue_size.get() == 0) {
+		return _steal_task(p_thread_data);
+	}
+	// The shared queue needs the lock.
+	return nullptr;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_queued_task(ThreadData *p_thread_data) {
+	// Must be called with task_mutex locked.
+	if (task_queue.first()) {
+		Task *task = task_queue.first()->self();
+		task_queue.remove(task_queue.first());
+		task_queue_size.decrement();
+		return task;
+	}
+	return _steal_task(p_thread_data);
+}
+
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		Task *task_to_process = singleton->_pop_task_lock_free(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
 			}
 			thread_data->signaled = false;
 
-			if (singleton->task_queue.first()) {
-				task_to_process = singleton->task_queue.first()->self();
-				singleton->task_queue.remove(singleton->task_queue.first());
-			} else {
+			// Tasks are pushed to the local queues with the lock held, so checking them again here can't miss a notification.
+			task_to_process = singleton->_pop_queued_task(thread_data);
+			if (!task_to_process) {
 				thread_data->cond_var.wait(lock);
 				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
 			}
@@ -227,8 +261,12 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (p_high_priority && caller_pool_thread && caller_pool_thread->local_queue.push(p_tasks[i])) {
+			// Tasks posted from pool threads stay with them unless other threads steal them.
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
+			task_queue_size.increment();
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -314,6 +352,7 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
 		low_priority_task_queue.remove(low_priority_task_queue.first());
 		task_queue.add_last(&low_prio_task->task_elem);
+		task_queue_size.increment();
 		low_priority_threads_used++;
 		return true;
 	} else {
@@ -329,7 +368,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
-	TaskID id = last_task++;
+	TaskID id = last_task.postincrement();
 	task->self = id;
 	task->callable = p_callable;
 	task->native_func = p_func;
@@ -472,7 +511,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (!exit_threads && was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || !p_caller_pool_thread->local_queue.is_empty()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -491,9 +530,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 					}
 				}
 
-				if (singleton->task_queue.first()) {
-					task_to_process = task_queue.first()->self();
-					task_queue.remove(task_queue.first());
+				if (!p_caller_pool_thread->local_queue.pop(task_to_process)) {
+					task_to_process = _pop_queued_task(p_caller_pool_thread);
 				}
 
 				if (!task_to_process) {
@@ -558,7 +596,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	task_mutex.lock();
 	Group *group = group_allocator.alloc();
-	GroupID id = last_task++;
+	GroupID id = last_task.postincrement();
 	group->max = p_elements;
 	group->self = id;
 
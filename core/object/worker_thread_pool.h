@@ -40,6 +40,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -98,12 +99,14 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
 
 	SelfList<Task>::List low_priority_task_queue;
 	SelfList<Task>::List task_queue;
+	SafeNumeric<uint32_t> task_queue_size; // Lets threads with nothing to do steal without locking when the shared queue is empty.
 
 	BinaryMutex task_mutex;
 
@@ -118,6 +121,7 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
+		WorkStealingDeque<Task *, LOCAL_QUEUE_SIZE> local_queue; // High priority tasks posted from this thread, other threads steal from it.
 
 		ThreadData() :
 				ready_for_scripting(false),
@@ -148,12 +152,16 @@ private:
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
 
-	uint64_t last_task = 1;
+	SafeNumeric<uint64_t> last_task{ 1 };
 
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
 
+	Task *_pop_task_lock_free(ThreadData *p_thread_data);
+	Task *_pop_queued_task(ThreadData *p_thread_data);
+	Task *_steal_task(ThreadData *p_thread_data);
+
 	void _post_tasks_and_unlock(Task **p_tasks, uint32_t p_count, bool p_high_priority);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
@@ -219,6 +219,7 @@ static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+static uint64_t physics_benchmark_frames = 0;
 #ifdef TOOLS_ENABLED
 static bool dump_gdextension_interface = false;
 static bool dump_extension_api = false;
@@ -452,6 +453,7 @@ void Main::print_help(const char *p_binary) {
 #endif
 	print_help_option("--quit", "Quit after the first iteration.\n");
 	print_help_option("--quit-after <int>", "Quit after the given number of iterations. Set to 0 to disable.\n");
+	print_help_option("--physics-benchmark <int>", "Run the scene in headless mode for the given number of physics frames, then print percentiles of the time spent in each stage of the 3D physics step and quit. Combine with --fixed-fps to run faster than real time.\n");
 	print_help_option("-l, --language <locale>", "Use a specific locale (<locale> being a two-letter code).\n");
 	print_help_option("--path <directory>", "Path to a project (<directory> must contain a \"project.godot\" file).\n");
 	print_help_option("-u, --upwards", "Scan folders upwards for project.godot file.\n");
@@ -1391,6 +1393,22 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing number of iterations, aborting.\n");
 				goto error;
 			}
+		} else if (arg == "--physics-benchmark") { // Run headless and report physics step timings after the given number of physics frames
+			if (N) {
+				const int64_t frames = N->get().to_int();
+				if (frames <= 0) {
+					OS::get_singleton()->print("Invalid number of physics frames \"%s\", it must be greater than 0, aborting.\n", N->get().utf8().get_data());
+					goto error;
+				}
+				physics_benchmark_frames = frames;
+				N = N->next();
+
+				audio_driver = NULL_AUDIO_DRIVER;
+				display_driver = NULL_DISPLAY_DRIVER;
+			} else {
+				OS::get_singleton()->print("Missing number of physics frames, aborting.\n");
+				goto error;
+			}
 		} else if (arg.ends_with("project.godot")) {
 			String path;
 			String file = arg;
@@ -3780,6 +3798,52 @@ static uint64_t physics_process_max = 0;
 static uint64_t process_max = 0;
 static uint64_t navigation_process_max = 0;
 
+// For `--physics-benchmark`.
+static const PhysicsServer3D::ProcessInfo physics_benchmark_stages[] = {
+	PhysicsServer3D::INFO_BROADPHASE_TIME,
+	PhysicsServer3D::INFO_NARROWPHASE_TIME,
+	PhysicsServer3D::INFO_SOLVER_TIME,
+	PhysicsServer3D::INFO_CONTACT_CALLBACKS_TIME,
+	PhysicsServer3D::INFO_AREA_OVERLAPS_TIME,
+	PhysicsServer3D::INFO_CALL_QUERIES_TIME,
+};
+static const char *physics_benchmark_stage_names[] = {
+	"Broadphase",
+	"Narrowphase",
+	"Solver",
+	"Contact Callbacks",
+	"Area Overlaps",
+	"Call Queries",
+};
+static constexpr int PHYSICS_BENCHMARK_STAGE_COUNT = sizeof(physics_benchmark_stages) / sizeof(physics_benchmark_stages[0]);
+// One list per stage, plus one for the whole physics frame.
+static LocalVector<uint64_t> physics_benchmark_samples[PHYSICS_BENCHMARK_STAGE_COUNT + 1];
+
+static void _print_physics_benchmark_series(const String &p_name, LocalVector<uint64_t> &p_samples) {
+	if (p_samples.is_empty()) {
+		return;
+	}
+
+	p_samples.sort();
+
+	const uint32_t count = p_samples.size();
+	const auto percentile = [&](double p_percentile) {
+		return rtos(USEC_TO_SEC(p_samples[MIN((uint32_t)(p_percentile * count), count - 1)]) * 1000.0).pad_decimals(3);
+	};
+
+	print_line(vformat("%s: p50 %s ms, p90 %s ms, p99 %s ms, max %s ms", p_name.rpad(20), percentile(0.5), percentile(0.9), percentile(0.99), percentile(1.0)));
+}
+
+static void _print_physics_benchmark() {
+	print_line(vformat("Physics benchmark results over %d physics frames:", physics_benchmark_samples[PHYSICS_BENCHMARK_STAGE_COUNT].size()));
+
+	for (int i = 0; i < PHYSICS_BENCHMARK_STAGE_COUNT; i++) {
+		_print_physics_benchmark_series(physics_benchmark_stage_names[i], physics_benchmark_samples[i]);
+	}
+
+	_print_physics_benchmark_series("Physics Frame", physics_benchmark_samples[PHYSICS_BENCHMARK_STAGE_COUNT]);
+}
+
 // Return false means iterating further, returning true means `OS::run`
 // will terminate the program. In case of failure, the OS exit code needs
 // to be set explicitly here (defaults to EXIT_SUCCESS).
@@ -3838,6 +3902,13 @@ bool Main::iteration() {
 		PhysicsServer3D::get_singleton()->sync();
 		PhysicsServer3D::get_singleton()->flush_queries();
 
+		if (physics_benchmark_frames > 0 && Engine::get_singleton()->_physics_frames > 1) {
+			// The stage timings are reported by `flush_queries`, so they belong to the step of the previous frame.
+			for (int i = 0; i < PHYSICS_BENCHMARK_STAGE_COUNT; i++) {
+				physics_benchmark_samples[i].push_back(PhysicsServer3D::get_singleton()->get_process_info(physics_benchmark_stages[i]));
+			}
+		}
+
 		// Prepare the fixed timestep interpolated nodes BEFORE they are updated
 		// by the physics server, otherwise the current and previous transforms
 		// may be the same, and no interpolation takes place.
@@ -3866,6 +3937,18 @@ bool Main::iteration() {
 		physics_process_max = MAX(OS::get_singleton()->get_ticks_usec() - physics_begin, physics_process_max);
 
 		Engine::get_singleton()->_in_physics = false;
+
+		if (physics_benchmark_frames > 0) {
+			LocalVector<uint64_t> &frame_samples = physics_benchmark_samples[PHYSICS_BENCHMARK_STAGE_COUNT];
+			frame_samples.push_back(OS::get_singleton()->get_ticks_usec() - physics_begin);
+
+			if (frame_samples.size() >= physics_benchmark_frames) {
+				_print_physics_benchmark();
+				physics_benchmark_frames = 0;
+				exit = true;
+				break;
+			}
+		}
 	}
 
 	if (Input::get_singleton()->is_agile_input_event_flushing()) {
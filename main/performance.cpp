@@ -82,6 +82,16 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(NAVIGATION_CLUSTER_COUNT);
+	BIND_ENUM_CONSTANT(NAVIGATION_PATH_CACHE_HIT_COUNT);
+	BIND_ENUM_CONSTANT(NAVIGATION_PATH_CACHE_MISS_COUNT);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_BROADPHASE_TIME);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_NARROWPHASE_TIME);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_SOLVER_TIME);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_CONTACT_CALLBACKS_TIME);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_AREA_OVERLAPS_TIME);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_CALL_QUERIES_TIME);
+	BIND_ENUM_CONSTANT(RENDER_SHADOW_CULL_TIME);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -127,6 +137,16 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation/edges_merged"),
 		PNAME("navigation/edges_connected"),
 		PNAME("navigation/edges_free"),
+		PNAME("navigation/clusters"),
+		PNAME("navigation/path_cache_hits"),
+		PNAME("navigation/path_cache_misses"),
+		PNAME("physics_3d/broadphase_time"),
+		PNAME("physics_3d/narrowphase_time"),
+		PNAME("physics_3d/solver_time"),
+		PNAME("physics_3d/contact_callbacks_time"),
+		PNAME("physics_3d/area_overlaps_time"),
+		PNAME("physics_3d/call_queries_time"),
+		PNAME("raster/shadow_cull_time"),
 
 	};
 
@@ -195,6 +215,26 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case NAVIGATION_CLUSTER_COUNT:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_CLUSTER_COUNT);
+		case NAVIGATION_PATH_CACHE_HIT_COUNT:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_PATH_CACHE_HIT_COUNT);
+		case NAVIGATION_PATH_CACHE_MISS_COUNT:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_PATH_CACHE_MISS_COUNT);
+		case PHYSICS_3D_BROADPHASE_TIME:
+			return USEC_TO_SEC(PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_BROADPHASE_TIME));
+		case PHYSICS_3D_NARROWPHASE_TIME:
+			return USEC_TO_SEC(PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_NARROWPHASE_TIME));
+		case PHYSICS_3D_SOLVER_TIME:
+			return USEC_TO_SEC(PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_SOLVER_TIME));
+		case PHYSICS_3D_CONTACT_CALLBACKS_TIME:
+			return USEC_TO_SEC(PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_CONTACT_CALLBACKS_TIME));
+		case PHYSICS_3D_AREA_OVERLAPS_TIME:
+			return USEC_TO_SEC(PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_AREA_OVERLAPS_TIME));
+		case PHYSICS_3D_CALL_QUERIES_TIME:
+			return USEC_TO_SEC(PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_CALL_QUERIES_TIME));
+		case RENDER_SHADOW_CULL_TIME:
+			return USEC_TO_SEC(RS::get_singleton()->get_rendering_info(RS::RENDERING_INFO_SHADOW_CULL_TIME));
 
 		default: {
 		}
@@ -237,6 +277,16 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
 
 	};
 
@@ -97,6 +97,16 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		NAVIGATION_CLUSTER_COUNT,
+		NAVIGATION_PATH_CACHE_HIT_COUNT,
+		NAVIGATION_PATH_CACHE_MISS_COUNT,
+		PHYSICS_3D_BROADPHASE_TIME,
+		PHYSICS_3D_NARROWPHASE_TIME,
+		PHYSICS_3D_SOLVER_TIME,
+		PHYSICS_3D_CONTACT_CALLBACKS_TIME,
+		PHYSICS_3D_AREA_OVERLAPS_TIME,
+		PHYSICS_3D_CALL_QUERIES_TIME,
+		RENDER_SHADOW_CULL_TIME,
 		MONITOR_MAX
 	};
 
@@ -83,6 +83,10 @@ GodotNavigationServer3D::GodotNavigationServer3D() {}
 
 GodotNavigationServer3D::~GodotNavigationServer3D() {
 	flush_queries();
+
+	for (NavMap::PathQuerySlots *query_slots : free_path_query_caller_slots) {
+		memdelete(query_slots);
+	}
 }
 
 void GodotNavigationServer3D::add_command(SetCommand *command) {
@@ -416,6 +420,9 @@ COMMAND_2(region_set_enter_cost, RID, p_region, real_t, p_enter_cost) {
 	ERR_FAIL_COND(p_enter_cost < 0.0);
 
 	region->set_enter_cost(p_enter_cost);
+	if (region->get_map()) {
+		region->get_map()->clear_path_cache();
+	}
 }
 
 real_t GodotNavigationServer3D::region_get_enter_cost(RID p_region) const {
@@ -431,6 +438,9 @@ COMMAND_2(region_set_travel_cost, RID, p_region, real_t, p_travel_cost) {
 	ERR_FAIL_COND(p_travel_cost < 0.0);
 
 	region->set_travel_cost(p_travel_cost);
+	if (region->get_map()) {
+		region->get_map()->clear_path_cache();
+	}
 }
 
 real_t GodotNavigationServer3D::region_get_travel_cost(RID p_region) const {
@@ -470,6 +480,9 @@ COMMAND_2(region_set_navigation_layers, RID, p_region, uint32_t, p_navigation_la
 	ERR_FAIL_NULL(region);
 
 	region->set_navigation_layers(p_navigation_layers);
+	if (region->get_map()) {
+		region->get_map()->clear_path_cache();
+	}
 }
 
 uint32_t GodotNavigationServer3D::region_get_navigation_layers(RID p_region) const {
@@ -575,6 +588,9 @@ COMMAND_2(link_set_navigation_layers, RID, p_link, uint32_t, p_navigation_layers
 	ERR_FAIL_NULL(link);
 
 	link->set_navigation_layers(p_navigation_layers);
+	if (link->get_map()) {
+		link->get_map()->clear_path_cache();
+	}
 }
 
 uint32_t GodotNavigationServer3D::link_get_navigation_layers(const RID p_link) const {
@@ -617,6 +633,9 @@ COMMAND_2(link_set_enter_cost, RID, p_link, real_t, p_enter_cost) {
 	ERR_FAIL_NULL(link);
 
 	link->set_enter_cost(p_enter_cost);
+	if (link->get_map()) {
+		link->get_map()->clear_path_cache();
+	}
 }
 
 real_t GodotNavigationServer3D::link_get_enter_cost(const RID p_link) const {
@@ -631,6 +650,9 @@ COMMAND_2(link_set_travel_cost, RID, p_link, real_t, p_travel_cost) {
 	ERR_FAIL_NULL(link);
 
 	link->set_travel_cost(p_travel_cost);
+	if (link->get_map()) {
+		link->get_map()->clear_path_cache();
+	}
 }
 
 real_t GodotNavigationServer3D::link_get_travel_cost(const RID p_link) const {
@@ -1105,6 +1127,22 @@ void GodotNavigationServer3D::bake_from_source_geometry_data_async(const Ref<Nav
 	NavMeshGenerator3D::get_singleton()->bake_from_source_geometry_data_async(p_navigation_mesh, p_source_geometry_data, p_callback);
 }
 
+void GodotNavigationServer3D::bake_tiles_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback) {
+	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL(NavMeshGenerator3D::get_singleton());
+	NavMeshGenerator3D::get_singleton()->bake_tiles_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_aabb, p_callback);
+}
+
+void GodotNavigationServer3D::bake_tiles_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback) {
+	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL(NavMeshGenerator3D::get_singleton());
+	NavMeshGenerator3D::get_singleton()->bake_tiles_from_source_geometry_data_async(p_navigation_mesh, p_source_geometry_data, p_aabb, p_callback);
+}
+
 bool GodotNavigationServer3D::is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const {
 	return NavMeshGenerator3D::get_singleton()->is_baking(p_navigation_mesh);
 }
@@ -1264,6 +1302,9 @@ void GodotNavigationServer3D::process(real_t p_delta_time) {
 	int _new_pm_edge_merge_count = 0;
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
+	int _new_pm_cluster_count = 0;
+	int _new_pm_path_cache_hit_count = 0;
+	int _new_pm_path_cache_miss_count = 0;
 
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
@@ -1281,6 +1322,9 @@ void GodotNavigationServer3D::process(real_t p_delta_time) {
 		_new_pm_edge_merge_count += active_maps[i]->get_pm_edge_merge_count();
 		_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
 		_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
+		_new_pm_cluster_count += active_maps[i]->get_pm_cluster_count();
+		_new_pm_path_cache_hit_count += active_maps[i]->get_pm_path_cache_hit_count();
+		_new_pm_path_cache_miss_count += active_maps[i]->get_pm_path_cache_miss_count();
 
 		// Emit a signal if a map changed.
 		const uint32_t new_map_iteration_id = active_maps[i]->get_iteration_id();
@@ -1298,6 +1342,9 @@ void GodotNavigationServer3D::process(real_t p_delta_time) {
 	pm_edge_merge_count = _new_pm_edge_merge_count;
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
+	pm_cluster_count = _new_pm_cluster_count;
+	pm_path_cache_hit_count = _new_pm_path_cache_hit_count;
+	pm_path_cache_miss_count = _new_pm_path_cache_miss_count;
 }
 
 void GodotNavigationServer3D::init() {
@@ -1314,33 +1361,103 @@ void GodotNavigationServer3D::finish() {
 }
 
 PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_map_path(map, p_parameters, nullptr);
+}
+
+void GodotNavigationServer3D::_query_paths(const LocalVector<PathQueryParameters> &p_parameters, LocalVector<PathQueryResult> &r_results) const {
+	r_results.clear();
+	r_results.resize(p_parameters.size());
+
+	PathQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.results = &r_results;
+
+	// Resolve the maps up front so the tasks never touch the RID owner.
+	batch.maps.resize(p_parameters.size());
+	for (uint32_t i = 0; i < p_parameters.size(); i++) {
+		batch.maps[i] = map_owner.get_or_null(p_parameters[i].map);
+		ERR_CONTINUE_MSG(batch.maps[i] == nullptr, vformat("Invalid map in path query %d.", i));
+	}
+
+	WorkerThreadPool *worker_thread_pool = WorkerThreadPool::get_singleton();
+	bool from_pool_thread = WorkerThreadPool::get_thread_index() != -1;
+
+	{
+		MutexLock lock(path_query_batch_mutex);
+
+		// Only grows on the first batch, the thread count doesn't change afterwards.
+		if (path_query_thread_slots.size() < (uint32_t)worker_thread_pool->get_thread_count()) {
+			path_query_thread_slots.resize(worker_thread_pool->get_thread_count());
+		}
+
+		if (!from_pool_thread) {
+			if (free_path_query_caller_slots.is_empty()) {
+				batch.caller_slots = memnew(NavMap::PathQuerySlots);
+			} else {
+				batch.caller_slots = free_path_query_caller_slots[free_path_query_caller_slots.size() - 1];
+				free_path_query_caller_slots.remove_at(free_path_query_caller_slots.size() - 1);
+			}
+		}
+	}
+
+	// Pool threads run the batch themselves, waiting for other pool threads from one could stall the pool.
+	if (p_parameters.size() > 1 && worker_thread_pool->get_thread_count() > 0 && !from_pool_thread) {
+		WorkerThreadPool::GroupID group_task = worker_thread_pool->add_template_group_task(this, &GodotNavigationServer3D::_query_path_batch_task, &batch, p_parameters.size(), -1, true, SNAME("NavigationPathQueries3D"));
+		worker_thread_pool->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < p_parameters.size(); i++) {
+			_query_path_batch_task(i, &batch);
+		}
+	}
+
+	if (batch.caller_slots) {
+		MutexLock lock(path_query_batch_mutex);
+		free_path_query_caller_slots.push_back(batch.caller_slots);
+	}
+}
+
+void GodotNavigationServer3D::_query_path_batch_task(uint32_t p_index, PathQueryBatch *p_batch) const {
+	const NavMap *map = p_batch->maps[p_index];
+	if (map == nullptr) {
+		return;
+	}
+
+	// Threads outside of the pool (like the caller) use the slots of the batch.
+	int thread_index = WorkerThreadPool::get_thread_index();
+	NavMap::PathQuerySlots *query_slots = thread_index == -1 ? p_batch->caller_slots : &path_query_thread_slots[thread_index];
+	(*p_batch->results)[p_index] = _query_map_path(map, (*p_batch->parameters)[p_index], query_slots);
+}
+
+PathQueryResult GodotNavigationServer3D::_query_map_path(const NavMap *p_map, const PathQueryParameters &p_parameters, NavMap::PathQuerySlots *r_query_slots) const {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
 	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
 					p_parameters.navigation_layers,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_TYPES) ? &r_query_result.path_types : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
+					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr,
+					r_query_slots);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
 					p_parameters.navigation_layers,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_TYPES) ? &r_query_result.path_types : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
+					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr,
+					r_query_slots);
 		}
 	} else {
 		return r_query_result;
@@ -1524,6 +1641,15 @@ int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 		case INFO_EDGE_FREE_COUNT: {
 			return pm_edge_free_count;
 		} break;
+		case INFO_CLUSTER_COUNT: {
+			return pm_cluster_count;
+		} break;
+		case INFO_PATH_CACHE_HIT_COUNT: {
+			return pm_path_cache_hit_count;
+		} break;
+		case INFO_PATH_CACHE_MISS_COUNT: {
+			return pm_path_cache_miss_count;
+		} break;
 	}
 
 	return 0;
@@ -82,6 +82,23 @@ class GodotNavigationServer3D : public NavigationServer3D {
 
 	NavMeshGenerator3D *navmesh_generator_3d = nullptr;
 
+	/// State shared by the tasks of a batched path query.
+	struct PathQueryBatch {
+		const LocalVector<NavigationUtilities::PathQueryParameters> *parameters = nullptr;
+		LocalVector<NavigationUtilities::PathQueryResult> *results = nullptr;
+		LocalVector<const NavMap *> maps;
+		/// Working memory of the calling thread, when it isn't a pool thread.
+		NavMap::PathQuerySlots *caller_slots = nullptr;
+	};
+
+	/// Path query working memory of each worker thread, reused across batches.
+	/// A pool thread only runs one query at a time, so concurrent batches can share them.
+	mutable LocalVector<NavMap::PathQuerySlots> path_query_thread_slots;
+	/// Working memory for callers outside of the pool, one per concurrent batch.
+	/// The mutex is only held to hand out and take back slots.
+	mutable Mutex path_query_batch_mutex;
+	mutable LocalVector<NavMap::PathQuerySlots *> free_path_query_caller_slots;
+
 	// Performance Monitor
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -91,6 +108,9 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	int pm_edge_merge_count = 0;
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
+	int pm_cluster_count = 0;
+	int pm_path_cache_hit_count = 0;
+	int pm_path_cache_miss_count = 0;
 
 public:
 	GodotNavigationServer3D();
@@ -255,6 +275,8 @@ public:
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
+	virtual void bake_tiles_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback = Callable()) override;
+	virtual void bake_tiles_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback = Callable()) override;
 	virtual bool is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const override;
 
 	virtual RID source_geometry_parser_create() override;
@@ -278,10 +300,14 @@ public:
 	virtual void finish() override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual void _query_paths(const LocalVector<NavigationUtilities::PathQueryParameters> &p_parameters, LocalVector<NavigationUtilities::PathQueryResult> &r_results) const override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
+	NavigationUtilities::PathQueryResult _query_map_path(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters, NavMap::PathQuerySlots *r_query_slots) const;
+	void _query_path_batch_task(uint32_t p_index, PathQueryBatch *p_batch) const;
+
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
 };
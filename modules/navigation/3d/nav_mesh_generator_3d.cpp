@@ -169,7 +169,7 @@ void NavMeshGenerator3D::parse_source_geometry_data(Ref<NavigationMesh> p_naviga
 	}
 }
 
-void NavMeshGenerator3D::bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback) {
+void NavMeshGenerator3D::generator_bake(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB *p_tiles_aabb, const Callable &p_callback) {
 	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
 	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
 
@@ -188,7 +188,7 @@ void NavMeshGenerator3D::bake_from_source_geometry_data(Ref<NavigationMesh> p_na
 	baking_navmeshes.insert(p_navigation_mesh);
 	baking_navmesh_mutex.unlock();
 
-	generator_bake_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data);
+	generator_bake_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_tiles_aabb);
 
 	baking_navmesh_mutex.lock();
 	baking_navmeshes.erase(p_navigation_mesh);
@@ -199,7 +199,7 @@ void NavMeshGenerator3D::bake_from_source_geometry_data(Ref<NavigationMesh> p_na
 	}
 }
 
-void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback) {
+void NavMeshGenerator3D::generator_bake_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB *p_tiles_aabb, const Callable &p_callback) {
 	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
 	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
 
@@ -212,7 +212,7 @@ void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh
 	}
 
 	if (!use_threads) {
-		bake_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_callback);
+		generator_bake(p_navigation_mesh, p_source_geometry_data, p_tiles_aabb, p_callback);
 		return;
 	}
 
@@ -229,12 +229,32 @@ void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh
 	generator_task->navigation_mesh = p_navigation_mesh;
 	generator_task->source_geometry_data = p_source_geometry_data;
 	generator_task->callback = p_callback;
+	if (p_tiles_aabb) {
+		generator_task->bake_tiles = true;
+		generator_task->tiles_aabb = *p_tiles_aabb;
+	}
 	generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_STARTED;
 	generator_task->thread_task_id = WorkerThreadPool::get_singleton()->add_native_task(&NavMeshGenerator3D::generator_thread_bake, generator_task, NavMeshGenerator3D::baking_use_high_priority_threads, SNAME("NavMeshGeneratorBake3D"));
 	generator_tasks.insert(generator_task->thread_task_id, generator_task);
 	generator_task_mutex.unlock();
 }
 
+void NavMeshGenerator3D::bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback) {
+	generator_bake(p_navigation_mesh, p_source_geometry_data, nullptr, p_callback);
+}
+
+void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback) {
+	generator_bake_async(p_navigation_mesh, p_source_geometry_data, nullptr, p_callback);
+}
+
+void NavMeshGenerator3D::bake_tiles_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback) {
+	generator_bake(p_navigation_mesh, p_source_geometry_data, &p_aabb, p_callback);
+}
+
+void NavMeshGenerator3D::bake_tiles_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback) {
+	generator_bake_async(p_navigation_mesh, p_source_geometry_data, &p_aabb, p_callback);
+}
+
 bool NavMeshGenerator3D::is_baking(Ref<NavigationMesh> p_navigation_mesh) {
 	baking_navmesh_mutex.lock();
 	bool baking = baking_navmeshes.has(p_navigation_mesh);
@@ -245,7 +265,7 @@ bool NavMeshGenerator3D::is_baking(Ref<NavigationMesh> p_navigation_mesh) {
 void NavMeshGenerator3D::generator_thread_bake(void *p_arg) {
 	NavMeshGeneratorTask3D *generator_task = static_cast<NavMeshGeneratorTask3D *>(p_arg);
 
-	generator_bake_from_source_geometry_data(generator_task->navigation_mesh, generator_task->source_geometry_data);
+	generator_bake_from_source_geometry_data(generator_task->navigation_mesh, generator_task->source_geometry_data, generator_task->bake_tiles ? &generator_task->tiles_aabb : nullptr);
 
 	generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_FINISHED;
 }
@@ -665,24 +685,27 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 	}
 };
 
-void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
-	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
-		return;
-	}
-
-	Vector<float> source_geometry_vertices;
-	Vector<int> source_geometry_indices;
-	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
-
-	p_source_geometry_data->get_data(
-			source_geometry_vertices,
-			source_geometry_indices,
-			projected_obstructions);
-
-	if (source_geometry_vertices.size() < 3 || source_geometry_indices.size() < 3) {
-		return;
-	}
+struct NavMeshTileBakeData3D {
+	Ref<NavigationMesh> navigation_mesh;
+	rcConfig cfg;
+	const float *verts = nullptr;
+	int nverts = 0;
+	const int *tris = nullptr;
+	int ntris = 0;
+	// Min x, min z, max x and max z of each triangle to skip triangles outside of a tile.
+	const float *tri_bounds = nullptr;
+	const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> *projected_obstructions = nullptr;
+	float tile_world_size = 0.0;
+	int tile_x_begin = 0;
+	int tile_z_begin = 0;
+	int tile_x_count = 0;
+	// The tiles are aligned to the world grid and can reach past the baking filter.
+	AABB filter_baking_aabb;
+	LocalVector<Vector<Vector3>> tile_vertices;
+	LocalVector<Vector<Vector<int>>> tile_polygons;
+};
 
+static bool _bake_recast_polygons(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons, const AABB *p_filter_aabb = nullptr) {
 	rcHeightfield *hf = nullptr;
 	rcCompactHeightfield *chf = nullptr;
 	rcContourSet *cset = nullptr;
@@ -693,138 +716,76 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	// added to keep track of steps, no functionality right now
 	String bake_state = "";
 
-	bake_state = "Setting up Configuration..."; // step #1
-
-	const float *verts = source_geometry_vertices.ptr();
-	const int nverts = source_geometry_vertices.size() / 3;
-	const int *tris = source_geometry_indices.ptr();
-	const int ntris = source_geometry_indices.size() / 3;
-
-	float bmin[3], bmax[3];
-	rcCalcBounds(verts, nverts, bmin, bmax);
-
-	rcConfig cfg;
-	memset(&cfg, 0, sizeof(cfg));
-
-	cfg.cs = p_navigation_mesh->get_cell_size();
-	cfg.ch = p_navigation_mesh->get_cell_height();
-	if (p_navigation_mesh->get_border_size() > 0.0) {
-		cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
-	}
-	cfg.walkableSlopeAngle = p_navigation_mesh->get_agent_max_slope();
-	cfg.walkableHeight = (int)Math::ceil(p_navigation_mesh->get_agent_height() / cfg.ch);
-	cfg.walkableClimb = (int)Math::floor(p_navigation_mesh->get_agent_max_climb() / cfg.ch);
-	cfg.walkableRadius = (int)Math::ceil(p_navigation_mesh->get_agent_radius() / cfg.cs);
-	cfg.maxEdgeLen = (int)(p_navigation_mesh->get_edge_max_length() / p_navigation_mesh->get_cell_size());
-	cfg.maxSimplificationError = p_navigation_mesh->get_edge_max_error();
-	cfg.minRegionArea = (int)(p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size());
-	cfg.mergeRegionArea = (int)(p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size());
-	cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
-	cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
-	cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
-
-	if (p_navigation_mesh->get_border_size() > 0.0 && Math::fmod(p_navigation_mesh->get_border_size(), p_navigation_mesh->get_cell_size()) != 0.0) {
-		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
-		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableClimb * cfg.ch, p_navigation_mesh->get_agent_max_climb())) {
-		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_navigation_mesh->get_agent_radius())) {
-		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_navigation_mesh->get_edge_max_length())) {
-		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
-		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
-		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
-		WARN_PRINT("Property vertices_per_polygon is converted to int and loses precision.");
-	}
-	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
-		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
-	}
-
-	cfg.bmin[0] = bmin[0];
-	cfg.bmin[1] = bmin[1];
-	cfg.bmin[2] = bmin[2];
-	cfg.bmax[0] = bmax[0];
-	cfg.bmax[1] = bmax[1];
-	cfg.bmax[2] = bmax[2];
-
-	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
-	if (baking_aabb.has_volume()) {
-		Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
-		cfg.bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
-		cfg.bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
-		cfg.bmin[2] = baking_aabb.position[2] + baking_aabb_offset.z;
-		cfg.bmax[0] = cfg.bmin[0] + baking_aabb.size[0];
-		cfg.bmax[1] = cfg.bmin[1] + baking_aabb.size[1];
-		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
-	}
-
-	bake_state = "Calculating grid size..."; // step #2
-	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
-
-	// ~30000000 seems to be around sweetspot where Editor baking breaks
-	if ((cfg.width * cfg.height) > 30000000 && GLOBAL_GET("navigation/baking/use_crash_prevention_checks")) {
-		ERR_FAIL_MSG("Baking interrupted."
-					 "\nNavigationMesh baking process would likely crash the engine."
-					 "\nSource geometry is suspiciously big for the current Cell Size and Cell Height in the NavMesh Resource bake settings."
-					 "\nIf baking does not crash the engine or fail, the resulting NavigationMesh will create serious pathfinding performance issues."
-					 "\nIt is advised to increase Cell Size and/or Cell Height in the NavMesh Resource bake settings or reduce the size / scale of the source geometry."
-					 "\nIf you would like to try baking anyway, disable the 'navigation/baking/use_crash_prevention_checks' project setting.");
-		return;
-	}
-
 	bake_state = "Creating heightfield..."; // step #3
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), false);
 
 	bake_state = "Marking walkable triangles..."; // step #4
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(p_ntris);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_cfg.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+		rcFilterLowHangingWalkableObstacles(&ctx, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+		rcFilterLedgeSpans(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+		rcFilterWalkableLowHeightSpans(&ctx, p_cfg.walkableHeight, *hf);
 	}
 
 	bake_state = "Constructing compact heightfield..."; // step #5
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
+	// Remove the cells outside of the filter before eroding so that the edges erode like the edges of an untiled bake.
+	if (p_filter_aabb) {
+		const float half_cell = p_cfg.cs * 0.5f;
+		const float filter_min_x = p_filter_aabb->position.x;
+		const float filter_min_z = p_filter_aabb->position.z;
+		const float filter_max_x = filter_min_x + p_filter_aabb->size.x;
+		const float filter_max_z = filter_min_z + p_filter_aabb->size.z;
+
+		auto mark_outside = [&](float p_min_x, float p_min_z, float p_max_x, float p_max_z) {
+			const float box_min[3] = { p_min_x, chf->bmin[1], p_min_z };
+			const float box_max[3] = { p_max_x, chf->bmax[1], p_max_z };
+			rcMarkBoxArea(&ctx, box_min, box_max, RC_NULL_AREA, *chf);
+		};
+
+		if (filter_min_x > chf->bmin[0] + p_cfg.cs) {
+			mark_outside(chf->bmin[0], chf->bmin[2], filter_min_x - half_cell, chf->bmax[2]);
+		}
+		if (filter_max_x < chf->bmax[0] - p_cfg.cs) {
+			mark_outside(filter_max_x + half_cell, chf->bmin[2], chf->bmax[0], chf->bmax[2]);
+		}
+		if (filter_min_z > chf->bmin[2] + p_cfg.cs) {
+			mark_outside(chf->bmin[0], chf->bmin[2], chf->bmax[0], filter_min_z - half_cell);
+		}
+		if (filter_max_z < chf->bmax[2] - p_cfg.cs) {
+			mark_outside(chf->bmin[0], filter_max_z + half_cell, chf->bmax[0], chf->bmax[2]);
+		}
+	}
+
 	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
 			if (projected_obstruction.carve) {
 				continue;
 			}
@@ -841,11 +802,11 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Eroding walkable area..."; // step #6
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_cfg.walkableRadius, *chf), false);
 
 	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
 			if (!projected_obstruction.carve) {
 				continue;
 			}
@@ -863,30 +824,30 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	bake_state = "Partitioning..."; // step #7
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea), false);
 	}
 
 	bake_state = "Creating contours..."; // step #8
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *cset), false);
 
 	bake_state = "Creating polymesh..."; // step #9
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_cfg.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
@@ -895,9 +856,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Converting to native navigation mesh..."; // step #10
 
-	Vector<Vector3> nav_vertices;
-	Vector<Vector<int>> nav_polygons;
-
 	HashMap<Vector3, int> recast_vertex_to_native_index;
 	LocalVector<int> recast_index_to_native_index;
 	recast_index_to_native_index.resize(detail_mesh->nverts);
@@ -910,7 +868,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			int new_index = recast_vertex_to_native_index.size();
 			recast_index_to_native_index[i] = new_index;
 			recast_vertex_to_native_index[vertex] = new_index;
-			nav_vertices.push_back(vertex);
+			r_vertices.push_back(vertex);
 		} else {
 			recast_index_to_native_index[i] = *existing_index_ptr;
 		}
@@ -934,12 +892,10 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			nav_indices.write[1] = recast_index_to_native_index[index2];
 			nav_indices.write[2] = recast_index_to_native_index[index3];
 
-			nav_polygons.push_back(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 
-	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
-
 	bake_state = "Cleanup..."; // step #11
 
 	rcFreePolyMesh(poly_mesh);
@@ -947,7 +903,453 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	rcFreePolyMeshDetail(detail_mesh);
 	detail_mesh = nullptr;
 
-	bake_state = "Baking finished."; // step #12
+	return true;
+}
+
+static void _bake_recast_tile(void *p_userdata, uint32_t p_index) {
+	NavMeshTileBakeData3D *data = static_cast<NavMeshTileBakeData3D *>(p_userdata);
+
+	const int tile_x = data->tile_x_begin + (int)p_index % data->tile_x_count;
+	const int tile_z = data->tile_z_begin + (int)p_index / data->tile_x_count;
+
+	// The tile heightfield is extended by the border on all sides so that eroding and partitioning
+	// see the neighbor geometry. Recast removes the border again when building the contours.
+	rcConfig cfg = data->cfg;
+	const float border_world_size = cfg.borderSize * cfg.cs;
+	cfg.bmin[0] = tile_x * data->tile_world_size - border_world_size;
+	cfg.bmin[2] = tile_z * data->tile_world_size - border_world_size;
+	cfg.bmax[0] = (tile_x + 1) * data->tile_world_size + border_world_size;
+	cfg.bmax[2] = (tile_z + 1) * data->tile_world_size + border_world_size;
+
+	LocalVector<int> tile_tris;
+	for (int i = 0; i < data->ntris; i++) {
+		const float *tri_bounds = &data->tri_bounds[i * 4];
+		if (tri_bounds[0] > cfg.bmax[0] || tri_bounds[2] < cfg.bmin[0] || tri_bounds[1] > cfg.bmax[2] || tri_bounds[3] < cfg.bmin[2]) {
+			continue;
+		}
+		tile_tris.push_back(data->tris[i * 3 + 0]);
+		tile_tris.push_back(data->tris[i * 3 + 1]);
+		tile_tris.push_back(data->tris[i * 3 + 2]);
+	}
+
+	if (tile_tris.is_empty()) {
+		return;
+	}
+
+	const AABB &filter_aabb = data->filter_baking_aabb;
+	const bool use_filter = filter_aabb.has_volume() && (filter_aabb.position.x > cfg.bmin[0] || filter_aabb.position.z > cfg.bmin[2] || filter_aabb.position.x + filter_aabb.size.x < cfg.bmax[0] || filter_aabb.position.z + filter_aabb.size.z < cfg.bmax[2]);
+
+	_bake_recast_polygons(data->navigation_mesh, cfg, data->verts, data->nverts, tile_tris.ptr(), tile_tris.size() / 3, *data->projected_obstructions, data->tile_vertices[p_index], data->tile_polygons[p_index], use_filter ? &filter_aabb : nullptr);
+}
+
+void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB *p_tiles_aabb) {
+	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
+		return;
+	}
+
+	Vector<float> source_geometry_vertices;
+	Vector<int> source_geometry_indices;
+	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
+
+	p_source_geometry_data->get_data(
+			source_geometry_vertices,
+			source_geometry_indices,
+			projected_obstructions);
+
+	if (source_geometry_vertices.size() < 3 || source_geometry_indices.size() < 3) {
+		return;
+	}
+
+	// added to keep track of steps, no functionality right now
+	String bake_state = "";
+
+	bake_state = "Setting up Configuration..."; // step #1
+
+	const float *verts = source_geometry_vertices.ptr();
+	const int nverts = source_geometry_vertices.size() / 3;
+	const int *tris = source_geometry_indices.ptr();
+	const int ntris = source_geometry_indices.size() / 3;
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(verts, nverts, bmin, bmax);
+
+	rcConfig cfg;
+	memset(&cfg, 0, sizeof(cfg));
+
+	cfg.cs = p_navigation_mesh->get_cell_size();
+	cfg.ch = p_navigation_mesh->get_cell_height();
+	if (p_navigation_mesh->get_border_size() > 0.0) {
+		cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
+	}
+	cfg.walkableSlopeAngle = p_navigation_mesh->get_agent_max_slope();
+	cfg.walkableHeight = (int)Math::ceil(p_navigation_mesh->get_agent_height() / cfg.ch);
+	cfg.walkableClimb = (int)Math::floor(p_navigation_mesh->get_agent_max_climb() / cfg.ch);
+	cfg.walkableRadius = (int)Math::ceil(p_navigation_mesh->get_agent_radius() / cfg.cs);
+	cfg.maxEdgeLen = (int)(p_navigation_mesh->get_edge_max_length() / p_navigation_mesh->get_cell_size());
+	cfg.maxSimplificationError = p_navigation_mesh->get_edge_max_error();
+	cfg.minRegionArea = (int)(p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size());
+	cfg.mergeRegionArea = (int)(p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size());
+	cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
+	cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
+	cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
+
+	if (p_navigation_mesh->get_border_size() > 0.0 && Math::fmod(p_navigation_mesh->get_border_size(), p_navigation_mesh->get_cell_size()) != 0.0) {
+		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
+		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)cfg.walkableClimb * cfg.ch, p_navigation_mesh->get_agent_max_climb())) {
+		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_navigation_mesh->get_agent_radius())) {
+		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_navigation_mesh->get_edge_max_length())) {
+		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)cfg.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
+		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)cfg.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
+		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)cfg.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
+		WARN_PRINT("Property vertices_per_polygon is converted to int and loses precision.");
+	}
+	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
+		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
+	}
+
+	cfg.bmin[0] = bmin[0];
+	cfg.bmin[1] = bmin[1];
+	cfg.bmin[2] = bmin[2];
+	cfg.bmax[0] = bmax[0];
+	cfg.bmax[1] = bmax[1];
+	cfg.bmax[2] = bmax[2];
+
+	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	if (baking_aabb.has_volume()) {
+		Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
+		cfg.bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
+		cfg.bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
+		cfg.bmin[2] = baking_aabb.position[2] + baking_aabb_offset.z;
+		cfg.bmax[0] = cfg.bmin[0] + baking_aabb.size[0];
+		cfg.bmax[1] = cfg.bmin[1] + baking_aabb.size[1];
+		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
+	}
+
+	const int tile_size = p_navigation_mesh->get_tile_size();
+	if (tile_size <= 0) {
+		bake_state = "Calculating grid size..."; // step #2
+		rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+
+		// ~30000000 seems to be around sweetspot where Editor baking breaks
+		if ((cfg.width * cfg.height) > 30000000 && GLOBAL_GET("navigation/baking/use_crash_prevention_checks")) {
+			ERR_FAIL_MSG("Baking interrupted."
+						 "\nNavigationMesh baking process would likely crash the engine."
+						 "\nSource geometry is suspiciously big for the current Cell Size and Cell Height in the NavMesh Resource bake settings."
+						 "\nIf baking does not crash the engine or fail, the resulting NavigationMesh will create serious pathfinding performance issues."
+						 "\nIt is advised to increase Cell Size and/or Cell Height in the NavMesh Resource bake settings or reduce the size / scale of the source geometry."
+						 "\nIf you would like to try baking anyway, disable the 'navigation/baking/use_crash_prevention_checks' project setting.");
+			return;
+		}
+
+		Vector<Vector3> nav_vertices;
+		Vector<Vector<int>> nav_polygons;
+		if (!_bake_recast_polygons(p_navigation_mesh, cfg, verts, nverts, tris, ntris, projected_obstructions, nav_vertices, nav_polygons)) {
+			return;
+		}
+
+		p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+
+		bake_state = "Baking finished."; // step #12
+		return;
+	}
+
+	bake_state = "Calculating tile grid..."; // step #2
+
+	// Tiles are aligned to the world origin so that rebaking a part of the navigation mesh
+	// produces the same tile layout as the previous bake.
+	// Recast tiles need a border wider than the agent radius to line up seamlessly with their neighbors.
+	if (p_navigation_mesh->get_border_size() > 0.0) {
+		WARN_PRINT("Property border_size is ignored when baking with a tile_size above zero, tiles use a border derived from agent_radius.");
+	}
+	cfg.tileSize = tile_size;
+	cfg.borderSize = cfg.walkableRadius + 3;
+	cfg.width = cfg.tileSize + cfg.borderSize * 2;
+	cfg.height = cfg.tileSize + cfg.borderSize * 2;
+	cfg.bmin[1] = Math::floor(cfg.bmin[1] / cfg.ch) * cfg.ch;
+
+	const float tile_world_size = cfg.tileSize * cfg.cs;
+	int tile_x_begin = (int)Math::floor(cfg.bmin[0] / tile_world_size);
+	int tile_z_begin = (int)Math::floor(cfg.bmin[2] / tile_world_size);
+	int tile_x_end = (int)Math::floor(cfg.bmax[0] / tile_world_size);
+	int tile_z_end = (int)Math::floor(cfg.bmax[2] / tile_world_size);
+
+	if (p_tiles_aabb) {
+		// Changes also affect the neighbor tiles that see them inside of their border.
+		const float border_world_size = cfg.borderSize * cfg.cs;
+		const int changed_x_begin = (int)Math::floor((p_tiles_aabb->position.x - border_world_size) / tile_world_size);
+		const int changed_z_begin = (int)Math::floor((p_tiles_aabb->position.z - border_world_size) / tile_world_size);
+		const int changed_x_end = (int)Math::floor((p_tiles_aabb->position.x + p_tiles_aabb->size.x + border_world_size) / tile_world_size);
+		const int changed_z_end = (int)Math::floor((p_tiles_aabb->position.z + p_tiles_aabb->size.z + border_world_size) / tile_world_size);
+
+		if (baking_aabb.has_volume()) {
+			tile_x_begin = MAX(tile_x_begin, changed_x_begin);
+			tile_z_begin = MAX(tile_z_begin, changed_z_begin);
+			tile_x_end = MIN(tile_x_end, changed_x_end);
+			tile_z_end = MIN(tile_z_end, changed_z_end);
+		} else {
+			// Without a filter the tiles of removed geometry are outside of the current bounds.
+			tile_x_begin = changed_x_begin;
+			tile_z_begin = changed_z_begin;
+			tile_x_end = changed_x_end;
+			tile_z_end = changed_z_end;
+		}
+
+		if (tile_x_begin > tile_x_end || tile_z_begin > tile_z_end) {
+			return;
+		}
+	}
+
+	const int tile_x_count = tile_x_end - tile_x_begin + 1;
+	const int tile_z_count = tile_z_end - tile_z_begin + 1;
+	const uint32_t tile_count = tile_x_count * tile_z_count;
+
+	LocalVector<float> tri_bounds;
+	tri_bounds.resize(ntris * 4);
+	for (int i = 0; i < ntris; i++) {
+		const float *v0 = &verts[tris[i * 3 + 0] * 3];
+		const float *v1 = &verts[tris[i * 3 + 1] * 3];
+		const float *v2 = &verts[tris[i * 3 + 2] * 3];
+		tri_bounds[i * 4 + 0] = MIN(v0[0], MIN(v1[0], v2[0]));
+		tri_bounds[i * 4 + 1] = MIN(v0[2], MIN(v1[2], v2[2]));
+		tri_bounds[i * 4 + 2] = MAX(v0[0], MAX(v1[0], v2[0]));
+		tri_bounds[i * 4 + 3] = MAX(v0[2], MAX(v1[2], v2[2]));
+	}
+
+	bake_state = "Baking tiles..."; // step #3
+
+	NavMeshTileBakeData3D tile_bake_data;
+	tile_bake_data.navigation_mesh = p_navigation_mesh;
+	tile_bake_data.cfg = cfg;
+	tile_bake_data.verts = verts;
+	tile_bake_data.nverts = nverts;
+	tile_bake_data.tris = tris;
+	tile_bake_data.ntris = ntris;
+	tile_bake_data.tri_bounds = tri_bounds.ptr();
+	tile_bake_data.projected_obstructions = &projected_obstructions;
+	tile_bake_data.tile_world_size = tile_world_size;
+	tile_bake_data.tile_x_begin = tile_x_begin;
+	tile_bake_data.tile_z_begin = tile_z_begin;
+	tile_bake_data.tile_x_count = tile_x_count;
+	if (baking_aabb.has_volume()) {
+		tile_bake_data.filter_baking_aabb = AABB(baking_aabb.position + p_navigation_mesh->get_filter_baking_aabb_offset(), baking_aabb.size);
+	}
+	tile_bake_data.tile_vertices.resize(tile_count);
+	tile_bake_data.tile_polygons.resize(tile_count);
+
+	// A single pool thread can not wait on its own group task.
+	const bool use_tile_threads = use_threads && tile_count > 1 && (WorkerThreadPool::get_thread_index() == -1 || WorkerThreadPool::get_singleton()->get_thread_count() > 1);
+	if (use_tile_threads) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_bake_recast_tile, &tile_bake_data, tile_count, -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < tile_count; i++) {
+			_bake_recast_tile(&tile_bake_data, i);
+		}
+	}
+
+	bake_state = "Merging tiles..."; // step #4
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+
+	// Neighbor tiles do not produce bit identical vertices on their shared border,
+	// so weld vertices that fall into the same cell.
+	HashMap<Vector3i, int> cell_to_index;
+
+	auto add_vertex = [&](const Vector3 &p_vertex) -> int {
+		const Vector3i cell = Vector3i((int)Math::round(p_vertex.x / cfg.cs), (int)Math::round(p_vertex.y / cfg.ch), (int)Math::round(p_vertex.z / cfg.cs));
+		for (int offset_y : { 0, -1, 1 }) {
+			int *existing_index_ptr = cell_to_index.getptr(cell + Vector3i(0, offset_y, 0));
+			if (existing_index_ptr && Math::abs(nav_vertices[*existing_index_ptr].y - p_vertex.y) <= cfg.ch) {
+				return *existing_index_ptr;
+			}
+		}
+		int new_index = nav_vertices.size();
+		cell_to_index[cell] = new_index;
+		nav_vertices.push_back(p_vertex);
+		return new_index;
+	};
+
+	auto add_polygon = [&](const Vector<Vector3> &p_vertices, const Vector<int> &p_polygon) {
+		Vector<int> nav_indices;
+		for (int vertex_index : p_polygon) {
+			const int nav_index = add_vertex(p_vertices[vertex_index]);
+			if (nav_indices.is_empty() || (nav_indices[nav_indices.size() - 1] != nav_index && nav_indices[0] != nav_index)) {
+				nav_indices.push_back(nav_index);
+			}
+		}
+		// Welding can collapse small polygons.
+		if (nav_indices.size() >= 3) {
+			nav_polygons.push_back(nav_indices);
+		}
+	};
+
+	if (p_tiles_aabb) {
+		// Keep the polygons of all tiles that were not rebaked.
+		// Polygons touching the rebaked tiles are dropped, those tiles bake them again.
+		const float overlap_margin = cfg.cs * 0.5f;
+		const float rebaked_min_x = tile_x_begin * tile_world_size + overlap_margin;
+		const float rebaked_min_z = tile_z_begin * tile_world_size + overlap_margin;
+		const float rebaked_max_x = (tile_x_end + 1) * tile_world_size - overlap_margin;
+		const float rebaked_max_z = (tile_z_end + 1) * tile_world_size - overlap_margin;
+
+		Vector<Vector3> old_vertices;
+		Vector<Vector<int>> old_polygons;
+		p_navigation_mesh->get_data(old_vertices, old_polygons);
+
+		for (const Vector<int> &old_polygon : old_polygons) {
+			if (old_polygon.is_empty()) {
+				continue;
+			}
+
+			float polygon_min_x = FLT_MAX;
+			float polygon_min_z = FLT_MAX;
+			float polygon_max_x = -FLT_MAX;
+			float polygon_max_z = -FLT_MAX;
+			bool polygon_valid = true;
+			for (int old_index : old_polygon) {
+				if (old_index < 0 || old_index >= old_vertices.size()) {
+					polygon_valid = false;
+					break;
+				}
+				const Vector3 &old_vertex = old_vertices[old_index];
+				polygon_min_x = MIN(polygon_min_x, old_vertex.x);
+				polygon_min_z = MIN(polygon_min_z, old_vertex.z);
+				polygon_max_x = MAX(polygon_max_x, old_vertex.x);
+				polygon_max_z = MAX(polygon_max_z, old_vertex.z);
+			}
+			if (!polygon_valid) {
+				continue;
+			}
+
+			if (polygon_max_x > rebaked_min_x && polygon_min_x < rebaked_max_x && polygon_max_z > rebaked_min_z && polygon_min_z < rebaked_max_z) {
+				continue;
+			}
+
+			add_polygon(old_vertices, old_polygon);
+		}
+	}
+
+	for (uint32_t tile_index = 0; tile_index < tile_count; tile_index++) {
+		const Vector<Vector3> &tile_vertices = tile_bake_data.tile_vertices[tile_index];
+		for (const Vector<int> &tile_polygon : tile_bake_data.tile_polygons[tile_index]) {
+			add_polygon(tile_vertices, tile_polygon);
+		}
+	}
+
+	bake_state = "Connecting tile borders..."; // step #5
+
+	// Neighbor tiles split their shared border at different vertices. Insert the vertices of the
+	// other side into the border edges so that the polygons of both tiles share the same edges.
+	const float border_epsilon = cfg.cs * 0.01f;
+	const float border_height = MAX(cfg.ch, cfg.walkableClimb * cfg.ch);
+	HashMap<int, LocalVector<int>> border_x_vertices;
+	HashMap<int, LocalVector<int>> border_z_vertices;
+
+	auto get_border = [&](float p_coordinate, int &r_border) -> bool {
+		r_border = (int)Math::round(p_coordinate / tile_world_size);
+		return Math::abs(p_coordinate - r_border * tile_world_size) <= border_epsilon;
+	};
+
+	for (int i = 0; i < nav_vertices.size(); i++) {
+		int border;
+		if (get_border(nav_vertices[i].x, border)) {
+			border_x_vertices[border].push_back(i);
+		}
+		if (get_border(nav_vertices[i].z, border)) {
+			border_z_vertices[border].push_back(i);
+		}
+	}
+
+	struct EdgeSplit {
+		float weight = 0.0;
+		int index = 0;
+
+		bool operator<(const EdgeSplit &p_other) const { return weight < p_other.weight; }
+	};
+
+	LocalVector<EdgeSplit> edge_splits;
+	for (Vector<int> &nav_polygon : nav_polygons) {
+		Vector<int> split_polygon;
+		bool polygon_split = false;
+
+		for (int i = 0; i < nav_polygon.size(); i++) {
+			const int index_a = nav_polygon[i];
+			const int index_b = nav_polygon[(i + 1) % nav_polygon.size()];
+			split_polygon.push_back(index_a);
+
+			const Vector3 &vertex_a = nav_vertices[index_a];
+			const Vector3 &vertex_b = nav_vertices[index_b];
+
+			// Border edges run along x or z, use the other axis to order the vertices on them.
+			const LocalVector<int> *border_vertices = nullptr;
+			int axis = 0;
+			int border_a;
+			int border_b;
+			if (get_border(vertex_a.x, border_a) && get_border(vertex_b.x, border_b) && border_a == border_b) {
+				border_vertices = border_x_vertices.getptr(border_a);
+				axis = Vector3::AXIS_Z;
+			} else if (get_border(vertex_a.z, border_a) && get_border(vertex_b.z, border_b) && border_a == border_b) {
+				border_vertices = border_z_vertices.getptr(border_a);
+				axis = Vector3::AXIS_X;
+			}
+			if (!border_vertices) {
+				continue;
+			}
+
+			const float edge_length = vertex_b[axis] - vertex_a[axis];
+			if (Math::abs(edge_length) <= border_epsilon) {
+				continue;
+			}
+
+			edge_splits.clear();
+			for (int index_c : *border_vertices) {
+				if (index_c == index_a || index_c == index_b) {
+					continue;
+				}
+				const Vector3 &vertex_c = nav_vertices[index_c];
+				const float weight = (vertex_c[axis] - vertex_a[axis]) / edge_length;
+				if (weight * Math::abs(edge_length) <= border_epsilon || (1.0f - weight) * Math::abs(edge_length) <= border_epsilon) {
+					continue;
+				}
+				if (Math::abs(vertex_c.y - Math::lerp(vertex_a.y, vertex_b.y, weight)) > border_height) {
+					continue;
+				}
+				edge_splits.push_back({ weight, index_c });
+			}
+			if (edge_splits.is_empty()) {
+				continue;
+			}
+
+			edge_splits.sort();
+			for (const EdgeSplit &edge_split : edge_splits) {
+				split_polygon.push_back(edge_split.index);
+			}
+			polygon_split = true;
+		}
+
+		if (polygon_split) {
+			nav_polygon = split_polygon;
+		}
+	}
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+
+	bake_state = "Baking finished."; // step #6
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
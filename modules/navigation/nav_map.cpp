@@ -117,7 +117,39 @@ void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
 		return;
 	}
 	link_connection_radius = p_link_connection_radius;
-	regenerate_links = true;
+	links_dirty = true;
+}
+
+void NavMap::set_path_cache_size(uint32_t p_path_cache_size) {
+	MutexLock lock(path_cache_mutex);
+	path_cache_size.set(p_path_cache_size);
+	if (p_path_cache_size == 0) {
+		path_cache.clear();
+	} else {
+		path_cache.set_capacity(p_path_cache_size);
+	}
+}
+
+void NavMap::clear_path_cache() {
+	MutexLock lock(path_cache_mutex);
+	path_cache.clear();
+}
+
+void NavMap::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	links_dirty = true;
+}
+
+void NavMap::set_hierarchical_cluster_size(uint32_t p_cluster_size) {
+	ERR_FAIL_COND_MSG(p_cluster_size == 0, "Hierarchical cluster size must be greater than 0.");
+	if (hierarchical_cluster_size == p_cluster_size) {
+		return;
+	}
+	hierarchical_cluster_size = p_cluster_size;
+	links_dirty = true;
 }
 
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
@@ -133,7 +165,164 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
-Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const {
+static _FORCE_INLINE_ void _reset_navigation_poly(gd::NavigationPoly &r_navigation_poly, uint32_t p_query_id, const gd::Polygon *p_poly) {
+	r_navigation_poly = gd::NavigationPoly();
+	r_navigation_poly.poly = p_poly;
+	r_navigation_poly.query_id = p_query_id;
+}
+
+void NavMap::_begin_path_query(PathQuerySlots &r_query_slots) {
+	r_query_slots.traversable_polys.clear();
+	r_query_slots.traversable_clusters.clear();
+
+	// Slots stamped by previous queries now count as not visited, only a wrap around of the id requires clearing them.
+	r_query_slots.query_id++;
+	if (r_query_slots.query_id == 0) {
+		for (gd::NavigationPoly &navigation_poly : r_query_slots.navigation_polys) {
+			navigation_poly.query_id = 0;
+		}
+		for (gd::NavigationCluster &navigation_cluster : r_query_slots.navigation_clusters) {
+			navigation_cluster.query_id = 0;
+			navigation_cluster.corridor_query_id = 0;
+		}
+		r_query_slots.query_id = 1;
+	}
+}
+
+NavMap::PathQuerySlots *NavMap::_acquire_path_query_slots() const {
+	{
+		MutexLock lock(path_query_slots_mutex);
+		if (!free_path_query_slots.is_empty()) {
+			PathQuerySlots *query_slots = free_path_query_slots[free_path_query_slots.size() - 1];
+			free_path_query_slots.resize(free_path_query_slots.size() - 1);
+			return query_slots;
+		}
+	}
+	return memnew(PathQuerySlots);
+}
+
+void NavMap::_release_path_query_slots(PathQuerySlots *p_query_slots) const {
+	p_query_slots->traversable_polys.clear();
+	p_query_slots->traversable_clusters.clear();
+
+	MutexLock lock(path_query_slots_mutex);
+	free_path_query_slots.push_back(p_query_slots);
+}
+
+const gd::Polygon *NavMap::_get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, Vector3 &r_closest_point) const {
+	const gd::Polygon *closest_polygon = nullptr;
+
+	auto polygon_query = [&](uint32_t p_polygon_index, real_t &r_closest_distance_squared) {
+		const gd::Polygon &p = *polygons[p_polygon_index];
+		// Only consider the polygon if it in a region with compatible layers.
+		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+			return;
+		}
+
+		// For each face check the distance to the point.
+		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
+			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+			const Vector3 point = face.get_closest_point_to(p_point);
+			const real_t distance_squared = point.distance_squared_to(p_point);
+			// Ties go to the lowest polygon id so the result does not depend on the tree layout.
+			if (distance_squared < r_closest_distance_squared || (distance_squared == r_closest_distance_squared && closest_polygon && p.id < closest_polygon->id)) {
+				r_closest_distance_squared = distance_squared;
+				closest_polygon = &p;
+				r_closest_point = point;
+			}
+		}
+	};
+	polygons_bvh.closest_query(p_point, polygon_query);
+
+	return closest_polygon;
+}
+
+bool NavMap::_find_cluster_corridor(PathQuerySlots &r_query_slots, uint32_t p_begin_cluster_id, uint32_t p_end_cluster_id, uint32_t p_navigation_layers) const {
+	LocalVector<gd::NavigationCluster> &navigation_clusters = r_query_slots.navigation_clusters;
+	if (navigation_clusters.size() < clusters.size()) {
+		navigation_clusters.resize(clusters.size());
+	}
+	gd::Heap<gd::NavigationCluster *, gd::NavClusterTravelCostGreaterThan, gd::NavClusterHeapIndexer> &traversable_clusters = r_query_slots.traversable_clusters;
+	traversable_clusters.clear();
+
+	const uint32_t query_id = r_query_slots.query_id;
+	const Vector3 &end_center = clusters[p_end_cluster_id].center;
+
+	gd::NavigationCluster &begin_navigation_cluster = navigation_clusters[p_begin_cluster_id];
+	begin_navigation_cluster.query_id = query_id;
+	begin_navigation_cluster.cluster_id = p_begin_cluster_id;
+	begin_navigation_cluster.back_cluster_id = -1;
+	begin_navigation_cluster.traveled_distance = 0.0;
+	begin_navigation_cluster.distance_to_destination = 0.0;
+	begin_navigation_cluster.traversable_cluster_index = UINT32_MAX;
+	traversable_clusters.push(&begin_navigation_cluster);
+
+	// This is the same A* as for polygons, only over the much smaller graph of clusters.
+	while (!traversable_clusters.is_empty()) {
+		const gd::NavigationCluster *least_cost_cluster = traversable_clusters.pop();
+		if (least_cost_cluster->cluster_id == p_end_cluster_id) {
+			// Mark the clusters along the route, the polygon search will only expand polygons inside them.
+			int cluster_id = p_end_cluster_id;
+			while (cluster_id != -1) {
+				navigation_clusters[cluster_id].corridor_query_id = query_id;
+				cluster_id = navigation_clusters[cluster_id].back_cluster_id;
+			}
+			return true;
+		}
+
+		const gd::Cluster &cluster = clusters[least_cost_cluster->cluster_id];
+		const real_t travel_cost = cluster.owner->get_travel_cost();
+		for (const gd::ClusterPortal &portal : cluster.portals) {
+			const gd::Cluster &neighbor_cluster = clusters[portal.cluster_id];
+			// Layers, travel costs and enter costs can change without a map update so they are read from the owners.
+			if ((p_navigation_layers & neighbor_cluster.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			real_t enter_cost = 0.0;
+			if (neighbor_cluster.owner->get_self() != cluster.owner->get_self()) {
+				enter_cost = neighbor_cluster.owner->get_enter_cost();
+			}
+			const real_t neighbor_travel_cost = neighbor_cluster.owner->get_travel_cost();
+			const real_t new_distance = least_cost_cluster->traveled_distance + portal.distance_from * travel_cost + portal.distance_to * neighbor_travel_cost + enter_cost;
+
+			gd::NavigationCluster &neighbor = navigation_clusters[portal.cluster_id];
+			if (neighbor.query_id == query_id) {
+				if (neighbor.traversable_cluster_index != UINT32_MAX && new_distance < neighbor.traveled_distance) {
+					neighbor.back_cluster_id = least_cost_cluster->cluster_id;
+					neighbor.traveled_distance = new_distance;
+					traversable_clusters.shift(neighbor.traversable_cluster_index);
+				}
+			} else {
+				neighbor.query_id = query_id;
+				neighbor.cluster_id = portal.cluster_id;
+				neighbor.back_cluster_id = least_cost_cluster->cluster_id;
+				neighbor.traveled_distance = new_distance;
+				neighbor.distance_to_destination = neighbor_cluster.center.distance_to(end_center) * neighbor_travel_cost;
+				neighbor.traversable_cluster_index = UINT32_MAX;
+				traversable_clusters.push(&neighbor);
+			}
+		}
+	}
+
+	return false;
+}
+
+Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, PathQuerySlots *r_query_slots) const {
+	if (r_query_slots) {
+		Vector<Vector3> path = _get_path(*r_query_slots, p_origin, p_destination, p_optimize, p_navigation_layers, r_path_types, r_path_rids, r_path_owners);
+		r_query_slots->traversable_polys.clear();
+		r_query_slots->traversable_clusters.clear();
+		return path;
+	}
+
+	PathQuerySlots *query_slots = _acquire_path_query_slots();
+	Vector<Vector3> path = _get_path(*query_slots, p_origin, p_destination, p_optimize, p_navigation_layers, r_path_types, r_path_rids, r_path_owners);
+	_release_path_query_slots(query_slots);
+	return path;
+}
+
+Vector<Vector3> NavMap::_get_path(PathQuerySlots &r_query_slots, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const {
 	RWLockRead read_lock(map_rwlock);
 	if (iteration_id == 0) {
 		NAVMAP_ITERATION_ZERO_ERROR_MSG();
@@ -152,40 +341,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	}
 
 	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
-	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
+	const gd::Polygon *begin_poly = _get_closest_polygon(p_origin, p_navigation_layers, begin_point);
+	const gd::Polygon *end_poly = _get_closest_polygon(p_destination, p_navigation_layers, end_point);
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -217,24 +376,25 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
-	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	// Make sure every map and link polygon has a slot, then start a new query so all slots count as not visited.
+	LocalVector<gd::NavigationPoly> &navigation_polys = r_query_slots.navigation_polys;
+	if (navigation_polys.size() < polygons.size() + link_polygons.size()) {
+		navigation_polys.resize(polygons.size() + link_polygons.size());
+	}
+	_begin_path_query(r_query_slots);
 
-	// Add the start polygon to the reachable navigation polygons.
-	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
-	begin_navigation_poly.self_id = 0;
+	// Initialize the matching navigation polygon.
+	gd::NavigationPoly &begin_navigation_poly = navigation_polys[begin_poly->id];
+	_reset_navigation_poly(begin_navigation_poly, r_query_slots.query_id, begin_poly);
 	begin_navigation_poly.entry = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
-	navigation_polys.push_back(begin_navigation_poly);
 
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
-	to_visit.push_back(0);
+	// Heap of polygons to travel next.
+	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> &traversable_polys = r_query_slots.traversable_polys;
 
 	// This is an implementation of the A* algorithm.
-	int least_cost_id = 0;
+	int least_cost_id = begin_poly->id;
 	int prev_least_cost_id = -1;
 	bool found_route = false;
 
@@ -242,7 +402,65 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	real_t reachable_d = FLT_MAX;
 	bool is_reachable = true;
 
-	while (true) {
+	// Routes between the same polygons are searched again and again by agents, reuse a recent one if possible.
+	gd::PathCacheKey path_cache_key;
+	path_cache_key.begin_polygon_id = begin_poly->id;
+	path_cache_key.end_polygon_id = end_poly->id;
+	path_cache_key.navigation_layers = p_navigation_layers;
+	path_cache_key.iteration_id = iteration_id;
+
+	// Read once, the size may be changed from another thread during the query.
+	const bool use_path_cache = path_cache_size.get() > 0;
+	bool path_cache_hit = false;
+	if (use_path_cache) {
+		Vector<gd::PathCacheStep> cached_route;
+		{
+			MutexLock lock(path_cache_mutex);
+			const Vector<gd::PathCacheStep> *cached_route_ptr = path_cache.getptr(path_cache_key);
+			if (cached_route_ptr) {
+				cached_route = *cached_route_ptr;
+			}
+		}
+
+		if (cached_route.is_empty()) {
+			path_cache_miss_count.increment();
+		} else {
+			path_cache_hit_count.increment();
+			path_cache_hit = true;
+
+			// Rebuild the back links of the route as if the search just found it, the begin polygon is already set up.
+			// The route is stored from the end polygon back to the begin polygon, walk it forward so the entry points
+			// are computed from this query's begin point, the same way the search computes them.
+			Vector3 entry = begin_point;
+			for (int step_index = cached_route.size() - 2; step_index >= 0; step_index--) {
+				const gd::PathCacheStep &step = cached_route[step_index];
+				const gd::Polygon *poly = step.polygon_id < polygons.size() ? polygons[step.polygon_id] : &link_polygons[step.polygon_id - polygons.size()];
+
+				Vector3 pathway[2] = { step.back_navigation_edge_pathway_start, step.back_navigation_edge_pathway_end };
+				entry = Geometry3D::get_closest_point_to_segment(entry, pathway);
+
+				gd::NavigationPoly &navigation_poly = navigation_polys[step.polygon_id];
+				_reset_navigation_poly(navigation_poly, r_query_slots.query_id, poly);
+				navigation_poly.back_navigation_poly_id = cached_route[step_index + 1].polygon_id;
+				navigation_poly.back_navigation_edge = step.back_navigation_edge;
+				navigation_poly.back_navigation_edge_pathway_start = step.back_navigation_edge_pathway_start;
+				navigation_poly.back_navigation_edge_pathway_end = step.back_navigation_edge_pathway_end;
+				navigation_poly.entry = entry;
+			}
+			least_cost_id = end_poly->id;
+			found_route = true;
+		}
+	}
+
+	// For long paths first find a corridor of clusters and only expand the polygons inside it.
+	// Not needed when the route came from the cache.
+	bool use_corridor = false;
+	if (!path_cache_hit && use_hierarchical_pathfinding && !clusters.is_empty() && begin_poly->cluster_id != end_poly->cluster_id) {
+		use_corridor = _find_cluster_corridor(r_query_slots, begin_poly->cluster_id, end_poly->cluster_id, p_navigation_layers);
+	}
+	const LocalVector<gd::NavigationCluster> &navigation_clusters = r_query_slots.navigation_clusters;
+
+	while (!found_route) {
 		// Takes the current least_cost_poly neighbors (iterating over its edges) and compute the traveled_distance.
 		for (const gd::Edge &edge : navigation_polys[least_cost_id].poly->edges) {
 			// Iterate over connections in this edge, then compute the new optimized travel distance assigned to this polygon.
@@ -254,6 +472,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				// Skip polygons outside the cluster corridor.
+				if (use_corridor && navigation_clusters[connection.polygon->cluster_id].corridor_query_id != r_query_slots.query_id) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -267,42 +490,57 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const real_t new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
-
-				if (already_visited_polygon_index != -1) {
-					// Polygon already visited, check if we can reduce the travel cost.
-					gd::NavigationPoly &avp = navigation_polys[already_visited_polygon_index];
-					if (new_distance < avp.traveled_distance) {
-						avp.back_navigation_poly_id = least_cost_id;
-						avp.back_navigation_edge = connection.edge;
-						avp.back_navigation_edge_pathway_start = connection.pathway_start;
-						avp.back_navigation_edge_pathway_end = connection.pathway_end;
-						avp.traveled_distance = new_distance;
-						avp.entry = new_entry;
+				gd::NavigationPoly &neighbor_poly = navigation_polys[connection.polygon->id];
+				if (neighbor_poly.query_id == r_query_slots.query_id) {
+					// Polygon already reached, if it is still waiting in the heap check if we can reduce the travel cost.
+					if (neighbor_poly.traversable_poly_index != UINT32_MAX && new_distance < neighbor_poly.traveled_distance) {
+						neighbor_poly.back_navigation_poly_id = least_cost_id;
+						neighbor_poly.back_navigation_edge = connection.edge;
+						neighbor_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+						neighbor_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+						neighbor_poly.traveled_distance = new_distance;
+						neighbor_poly.distance_to_destination = new_entry.distance_to(end_point) * neighbor_poly.poly->owner->get_travel_cost();
+						neighbor_poly.entry = new_entry;
+
+						// Update the priority of the polygon in the heap.
+						traversable_polys.shift(neighbor_poly.traversable_poly_index);
 					}
 				} else {
 					// Add the neighbor polygon to the reachable ones.
-					gd::NavigationPoly new_navigation_poly = gd::NavigationPoly(connection.polygon);
-					new_navigation_poly.self_id = navigation_polys.size();
-					new_navigation_poly.back_navigation_poly_id = least_cost_id;
-					new_navigation_poly.back_navigation_edge = connection.edge;
-					new_navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
-					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
-					new_navigation_poly.traveled_distance = new_distance;
-					new_navigation_poly.entry = new_entry;
-					navigation_polys.push_back(new_navigation_poly);
+					_reset_navigation_poly(neighbor_poly, r_query_slots.query_id, connection.polygon);
+					neighbor_poly.back_navigation_poly_id = least_cost_id;
+					neighbor_poly.back_navigation_edge = connection.edge;
+					neighbor_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+					neighbor_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+					neighbor_poly.traveled_distance = new_distance;
+					neighbor_poly.distance_to_destination = new_entry.distance_to(end_point) * neighbor_poly.poly->owner->get_travel_cost();
+					neighbor_poly.entry = new_entry;
 
 					// Add the neighbor polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					traversable_polys.push(&neighbor_poly);
 				}
 			}
 		}
 
-		// Removes the least cost polygon from the list of polygons to visit so we can advance.
-		to_visit.erase(least_cost_id);
+		// The corridor can miss a route the clusters don't show, search again without it before giving up.
+		if (traversable_polys.is_empty() && use_corridor) {
+			use_corridor = false;
 
-		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
-		if (to_visit.size() == 0) {
+			gd::NavigationPoly np = navigation_polys[begin_poly->id];
+			_begin_path_query(r_query_slots);
+			np.query_id = r_query_slots.query_id;
+			navigation_polys[begin_poly->id] = np;
+			least_cost_id = begin_poly->id;
+			prev_least_cost_id = -1;
+
+			reachable_end = nullptr;
+			reachable_d = FLT_MAX;
+
+			continue;
+		}
+
+		// When the heap of polygons to visit is empty at this point it means the End Polygon is not reachable
+		if (traversable_polys.is_empty()) {
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -313,7 +551,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 			// Set as end point the furthest reachable point.
 			end_poly = reachable_end;
-			end_d = FLT_MAX;
+			real_t end_d = FLT_MAX;
 			for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
 				Face3 f(end_poly->points[0].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
 				Vector3 spoint = f.get_closest_point_to(p_destination);
@@ -364,13 +602,12 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				return path;
 			}
 
-			// Reset open and navigation_polys
-			gd::NavigationPoly np = navigation_polys[0];
-			navigation_polys.clear();
-			navigation_polys.push_back(np);
-			to_visit.clear();
-			to_visit.push_back(0);
-			least_cost_id = 0;
+			// Reset open and navigation_polys, only the begin polygon is kept.
+			gd::NavigationPoly np = navigation_polys[begin_poly->id];
+			_begin_path_query(r_query_slots);
+			np.query_id = r_query_slots.query_id;
+			navigation_polys[begin_poly->id] = np;
+			least_cost_id = begin_poly->id;
 			prev_least_cost_id = -1;
 
 			reachable_end = nullptr;
@@ -378,20 +615,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			continue;
 		}
 
-		// Find the polygon with the minimum cost from the list of polygons to visit.
-		least_cost_id = -1;
-		real_t least_cost = FLT_MAX;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			real_t cost = np->traveled_distance;
-			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
-			}
-		}
-
-		ERR_BREAK(least_cost_id == -1);
+		// Pop the polygon with the minimum cost from the heap of polygons to visit.
+		least_cost_id = traversable_polys.pop()->poly->id;
 
 		// Stores the further reachable end polygon, in case our goal is not reachable.
 		if (is_reachable) {
@@ -409,10 +634,29 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		}
 	}
 
+	// Only routes to the requested end polygon are cached, routes to the closest reachable polygon are searched again.
+	if (found_route && is_reachable && !path_cache_hit && use_path_cache) {
+		Vector<gd::PathCacheStep> route;
+		int np_id = least_cost_id;
+		while (np_id != -1) {
+			const gd::NavigationPoly &navigation_poly = navigation_polys[np_id];
+			gd::PathCacheStep step;
+			step.polygon_id = np_id;
+			step.back_navigation_edge = navigation_poly.back_navigation_edge;
+			step.back_navigation_edge_pathway_start = navigation_poly.back_navigation_edge_pathway_start;
+			step.back_navigation_edge_pathway_end = navigation_poly.back_navigation_edge_pathway_end;
+			route.push_back(step);
+			np_id = navigation_poly.back_navigation_poly_id;
+		}
+
+		MutexLock lock(path_cache_mutex);
+		path_cache.insert(path_cache_key, route);
+	}
+
 	// We did not find a route but we have both a start polygon and an end polygon at this point.
 	// Usually this happens because there was not a single external or internal connected edge, e.g. our start polygon is an isolated, single convex polygon.
 	if (!found_route) {
-		end_d = FLT_MAX;
+		real_t end_d = FLT_MAX;
 		// Search all faces of the start polygon for the closest point to our target position.
 		for (size_t point_id = 2; point_id < begin_poly->points.size(); point_id++) {
 			Face3 f(begin_poly->points[0].pos, begin_poly->points[point_id - 1].pos, begin_poly->points[point_id].pos);
@@ -609,7 +853,8 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 	Vector3 closest_point;
 	real_t closest_point_d = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
+	for (const gd::Polygon *polygon : polygons) {
+		const gd::Polygon &p = *polygon;
 		// For each face check the distance to the segment
 		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
 			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
@@ -701,49 +946,53 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	RWLockRead read_lock(map_rwlock);
 
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = FLT_MAX;
+	const gd::Polygon *closest_polygon = nullptr;
 
-	for (const gd::Polygon &p : polygons) {
+	auto polygon_query = [&](uint32_t p_polygon_index, real_t &r_closest_distance_squared) {
+		const gd::Polygon &p = *polygons[p_polygon_index];
 		// For each face check the distance to the point
 		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
 			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
 			const Vector3 inters = f.get_closest_point_to(p_point);
 			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
+			if (ds < r_closest_distance_squared || (ds == r_closest_distance_squared && closest_polygon && p.id < closest_polygon->id)) {
 				result.point = inters;
 				result.normal = f.get_plane().normal;
 				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
+				r_closest_distance_squared = ds;
+				closest_polygon = &p;
 			}
 		}
-	}
+	};
+	polygons_bvh.closest_query(p_point, polygon_query);
 
 	return result;
 }
 
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
-	regenerate_links = true;
+	changed_regions.push_back(p_region);
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+		changed_regions.erase(p_region);
+		removed_regions.push_back(p_region);
 	}
 }
 
 void NavMap::add_link(NavLink *p_link) {
 	links.push_back(p_link);
-	regenerate_links = true;
+	links_dirty = true;
 }
 
 void NavMap::remove_link(NavLink *p_link) {
 	int64_t link_index = links.find(p_link);
 	if (link_index >= 0) {
 		links.remove_at_unordered(link_index);
-		regenerate_links = true;
+		links_dirty = true;
 	}
 }
 
@@ -894,6 +1143,12 @@ void NavMap::sync() {
 	int _new_pm_edge_merge_count = pm_edge_merge_count;
 	int _new_pm_edge_connection_count = pm_edge_connection_count;
 	int _new_pm_edge_free_count = pm_edge_free_count;
+	int _new_pm_cluster_count = pm_cluster_count;
+	// Path cache counters cover the queries since the previous sync, no query runs while the map is locked for writing.
+	int _new_pm_path_cache_hit_count = path_cache_hit_count.get();
+	int _new_pm_path_cache_miss_count = path_cache_miss_count.get();
+	path_cache_hit_count.set(0);
+	path_cache_miss_count.set(0);
 
 	// Check if we need to update the links.
 	if (regenerate_polygons) {
@@ -903,272 +1158,91 @@ void NavMap::sync() {
 		regenerate_links = true;
 	}
 
+	// Only the regions that changed are merged again with the rest of the map.
 	for (NavRegion *region : regions) {
-		if (region->sync()) {
-			regenerate_links = true;
+		if (region->sync() && !changed_regions.has(region)) {
+			changed_regions.push_back(region);
 		}
 	}
 
 	for (NavLink *link : links) {
 		if (link->check_dirty()) {
-			regenerate_links = true;
+			links_dirty = true;
 		}
 	}
 
 	if (regenerate_links) {
-		_new_pm_polygon_count = 0;
-		_new_pm_edge_count = 0;
-		_new_pm_edge_merge_count = 0;
-		_new_pm_edge_connection_count = 0;
-		_new_pm_edge_free_count = 0;
-
-		// Remove regions connections.
+		// Merge every region again, e.g. after the edge connection margin changed.
 		for (NavRegion *region : regions) {
-			region->get_connections().clear();
-		}
-
-		// Resize the polygon count.
-		int count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
+			if (!changed_regions.has(region)) {
+				changed_regions.push_back(region);
 			}
-			count += region->get_polygons().size();
 		}
-		polygons.resize(count);
+	}
 
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
-			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
+	const bool regions_changed = regenerate_links || !changed_regions.is_empty() || !removed_regions.is_empty();
+	if (regions_changed || links_dirty) {
+		// Link connections point into region polygons, remove them while all polygons still exist.
+		_remove_link_connections();
+
+		LocalVector<gd::Edge::Connection> new_free_edges;
+		if (regenerate_links) {
+			region_polygons.clear();
+			edge_connections.clear();
+			free_edges.clear();
+			edge_merge_count = 0;
+			edge_connection_count = 0;
+		} else {
+			// Disconnect the old polygons of removed and changed regions before any of them is released.
+			LocalVector<const NavRegion *> detached_regions;
+			for (const NavRegion *region : removed_regions) {
+				detached_regions.push_back(region);
 			}
-			count += region->get_polygons().size();
-		}
-
-		_new_pm_polygon_count = polygons.size();
-
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
-				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+			for (const NavRegion *region : changed_regions) {
+				if (!detached_regions.has(region)) {
+					detached_regions.push_back(region);
 				}
 			}
-		}
-
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
-				}
+			for (const NavRegion *region : detached_regions) {
+				_detach_region_polygons(region, detached_regions, new_free_edges);
+			}
+			for (const NavRegion *region : detached_regions) {
+				region_polygons.erase(region);
 			}
 		}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
-
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
-
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
-
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
-
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
-				}
-
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
-				}
-
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
-				}
-
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
-
-				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+		// Merge the new polygons of the changed regions with the rest of the map.
+		for (NavRegion *region : changed_regions) {
+			if (region->get_enabled() && region->get_map() == this) {
+				_attach_region_polygons(region, new_free_edges);
 			}
 		}
+		if (regions_changed) {
+			_connect_free_edges(new_free_edges);
+			_update_region_connections();
+			_update_polygons();
+		}
 
-		uint32_t link_poly_idx = 0;
-		link_polygons.resize(links.size());
-
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
-			if (!link->get_enabled()) {
-				continue;
-			}
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
-
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
+		const uint32_t link_polygon_count = _update_links();
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
-			}
+		_new_pm_polygon_count = polygons.size();
+		_new_pm_edge_count = edge_connections.size();
+		_new_pm_edge_merge_count = edge_merge_count;
+		_new_pm_edge_connection_count = edge_connection_count;
+		_new_pm_edge_free_count = free_edges.size();
 
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.owner = link;
-
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
-
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
-				}
+		changed_regions.clear();
+		removed_regions.clear();
 
-				// If the link is bi-directional, create connections from the end to the start.
-				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
-				}
-			}
+		if (use_hierarchical_pathfinding) {
+			_build_clusters(link_polygon_count);
+		} else {
+			clusters.clear();
 		}
+		_new_pm_cluster_count = clusters.size();
+
+		// Cached routes point into the old polygons, the iteration id in their keys would never match again anyway.
+		clear_path_cache();
 
 		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
 		iteration_id = iteration_id % UINT32_MAX + 1;
@@ -1194,6 +1268,7 @@ void NavMap::sync() {
 
 	regenerate_polygons = false;
 	regenerate_links = false;
+	links_dirty = false;
 	obstacles_dirty = false;
 	agents_dirty = false;
 
@@ -1206,6 +1281,518 @@ void NavMap::sync() {
 	pm_edge_merge_count = _new_pm_edge_merge_count;
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
+	pm_cluster_count = _new_pm_cluster_count;
+	pm_path_cache_hit_count = _new_pm_path_cache_hit_count;
+	pm_path_cache_miss_count = _new_pm_path_cache_miss_count;
+}
+
+void NavMap::_detach_region_polygons(const NavRegion *p_region, const LocalVector<const NavRegion *> &p_detached_regions, LocalVector<gd::Edge::Connection> &r_new_free_edges) {
+	LocalVector<gd::Polygon> *map_polygons = region_polygons.getptr(p_region);
+	if (!map_polygons) {
+		return;
+	}
+
+	// Unmerge the edges shared with polygons that stay in the map, those edges become free edges.
+	for (gd::Polygon &poly : *map_polygons) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			const int next_point = (p + 1) % poly.points.size();
+			const gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = edge_connections.find(ek);
+			if (!connection) {
+				continue;
+			}
+			LocalVector<gd::Edge::Connection> &edge_connection = connection->value;
+
+			int64_t connection_index = -1;
+			for (uint32_t i = 0; i < edge_connection.size(); i++) {
+				if (edge_connection[i].polygon == &poly && edge_connection[i].edge == int(p)) {
+					connection_index = i;
+					break;
+				}
+			}
+			if (connection_index == -1) {
+				// The edge was skipped when it was merged.
+				continue;
+			}
+
+			if (edge_connection.size() == 2) {
+				const gd::Edge::Connection &other = edge_connection[1 - connection_index];
+				Vector<gd::Edge::Connection> &other_connections = other.polygon->edges[other.edge].connections;
+				for (uint32_t i = 0; i < other_connections.size(); i++) {
+					if (other_connections[i].polygon == &poly) {
+						other_connections.remove_at(i);
+						break;
+					}
+				}
+				edge_merge_count -= 1;
+
+				if (!p_detached_regions.has((const NavRegion *)other.polygon->owner)) {
+					r_new_free_edges.push_back(other);
+				}
+			}
+
+			edge_connection.remove_at(connection_index);
+			if (edge_connection.is_empty()) {
+				edge_connections.remove(connection);
+			}
+		}
+	}
+
+	// Remove the free edges of the region and the edge connections of other regions to it.
+	for (uint32_t i = 0; i < free_edges.size();) {
+		const gd::Edge::Connection &free_edge = free_edges[i];
+		if (free_edge.polygon->owner == p_region) {
+			edge_connection_count -= free_edge.polygon->edges[free_edge.edge].connections.size();
+			free_edges.remove_at_unordered(i);
+			continue;
+		}
+
+		Vector<gd::Edge::Connection> &connections = free_edge.polygon->edges[free_edge.edge].connections;
+		for (uint32_t j = 0; j < connections.size();) {
+			if (connections[j].polygon->owner == p_region) {
+				connections.remove_at(j);
+				edge_connection_count -= 1;
+			} else {
+				j++;
+			}
+		}
+		i++;
+	}
+}
+
+void NavMap::_attach_region_polygons(NavRegion *p_region, LocalVector<gd::Edge::Connection> &r_new_free_edges) {
+	LocalVector<gd::Polygon> &map_polygons = region_polygons[p_region];
+	map_polygons = p_region->get_polygons();
+
+	// Group the edges per key, edges sharing a key with another edge are merged.
+	for (gd::Polygon &poly : map_polygons) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			const int next_point = (p + 1) % poly.points.size();
+			const gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			gd::Edge::Connection new_connection;
+			new_connection.polygon = &poly;
+			new_connection.edge = p;
+			new_connection.pathway_start = poly.points[p].pos;
+			new_connection.pathway_end = poly.points[next_point].pos;
+
+			HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = edge_connections.find(ek);
+			if (!connection) {
+				edge_connections.insert(ek, LocalVector<gd::Edge::Connection>())->value.push_back(new_connection);
+				continue;
+			}
+
+			LocalVector<gd::Edge::Connection> &edge_connection = connection->value;
+			if (edge_connection.size() == 1) {
+				// The other edge is not free anymore.
+				const gd::Edge::Connection &other = edge_connection[0];
+				_remove_free_edge(other);
+				for (uint32_t i = 0; i < r_new_free_edges.size(); i++) {
+					if (r_new_free_edges[i].polygon == other.polygon && r_new_free_edges[i].edge == other.edge) {
+						r_new_free_edges.remove_at_unordered(i);
+						break;
+					}
+				}
+
+				// Connect edge that are shared in different polygons.
+				// Note: The pathway_start/end are full for those connection and do not need to be modified.
+				other.polygon->edges[other.edge].connections.push_back(new_connection);
+				poly.edges[p].connections.push_back(other);
+				edge_connection.push_back(new_connection);
+				edge_merge_count += 1;
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+			}
+		}
+	}
+
+	// The edges that are alone on their key are the free edges of the region.
+	for (gd::Polygon &poly : map_polygons) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			const int next_point = (p + 1) % poly.points.size();
+			const LocalVector<gd::Edge::Connection> *edge_connection = edge_connections.getptr(gd::EdgeKey(poly.points[p].key, poly.points[next_point].key));
+			if (edge_connection && edge_connection->size() == 1 && (*edge_connection)[0].polygon == &poly) {
+				r_new_free_edges.push_back((*edge_connection)[0]);
+			}
+		}
+	}
+}
+
+void NavMap::_remove_free_edge(const gd::Edge::Connection &p_edge) {
+	int64_t free_edge_index = -1;
+	for (uint32_t i = 0; i < free_edges.size(); i++) {
+		if (free_edges[i].polygon == p_edge.polygon && free_edges[i].edge == p_edge.edge) {
+			free_edge_index = i;
+			break;
+		}
+	}
+	if (free_edge_index == -1) {
+		return;
+	}
+
+	// Free edges only have edge connections by proximity, links are connected afterwards.
+	Vector<gd::Edge::Connection> &edge_connections_by_proximity = p_edge.polygon->edges[p_edge.edge].connections;
+	edge_connection_count -= edge_connections_by_proximity.size();
+	edge_connections_by_proximity.clear();
+	free_edges.remove_at_unordered(free_edge_index);
+
+	for (const gd::Edge::Connection &free_edge : free_edges) {
+		Vector<gd::Edge::Connection> &connections = free_edge.polygon->edges[free_edge.edge].connections;
+		for (uint32_t i = 0; i < connections.size();) {
+			if (connections[i].polygon == p_edge.polygon && connections[i].edge == p_edge.edge) {
+				connections.remove_at(i);
+				edge_connection_count -= 1;
+			} else {
+				i++;
+			}
+		}
+	}
+}
+
+void NavMap::_connect_free_edges(const LocalVector<gd::Edge::Connection> &p_new_free_edges) {
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	const uint32_t first_new_free_edge = free_edges.size();
+	for (const gd::Edge::Connection &new_free_edge : p_new_free_edges) {
+		if (use_edge_connections && new_free_edge.polygon->owner->get_use_edge_connections()) {
+			free_edges.push_back(new_free_edge);
+		}
+	}
+
+	// Only pairs with at least one new free edge need to be checked, the other pairs are already connected.
+	for (uint32_t i = first_new_free_edge; i < free_edges.size(); i++) {
+		for (uint32_t j = 0; j < i; j++) {
+			if (free_edges[i].polygon->owner == free_edges[j].polygon->owner) {
+				continue;
+			}
+			_connect_edge_by_proximity(free_edges[i], free_edges[j]);
+			_connect_edge_by_proximity(free_edges[j], free_edges[i]);
+		}
+	}
+}
+
+void NavMap::_connect_edge_by_proximity(const gd::Edge::Connection &p_free_edge, const gd::Edge::Connection &p_other_edge) {
+	Vector3 edge_p1 = p_free_edge.polygon->points[p_free_edge.edge].pos;
+	Vector3 edge_p2 = p_free_edge.polygon->points[(p_free_edge.edge + 1) % p_free_edge.polygon->points.size()].pos;
+
+	Vector3 other_edge_p1 = p_other_edge.polygon->points[p_other_edge.edge].pos;
+	Vector3 other_edge_p2 = p_other_edge.polygon->points[(p_other_edge.edge + 1) % p_other_edge.polygon->points.size()].pos;
+
+	// Compute the projection of the opposite edge on the current one
+	Vector3 edge_vector = edge_p2 - edge_p1;
+	real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+	real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+	if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		return;
+	}
+
+	// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+	Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other1;
+	if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+		other1 = other_edge_p1;
+	} else {
+		other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other1.distance_to(self1) > edge_connection_margin) {
+		return;
+	}
+
+	Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other2;
+	if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+		other2 = other_edge_p2;
+	} else {
+		other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other2.distance_to(self2) > edge_connection_margin) {
+		return;
+	}
+
+	// The edges can now be connected.
+	gd::Edge::Connection new_connection = p_other_edge;
+	new_connection.pathway_start = (self1 + other1) / 2.0;
+	new_connection.pathway_end = (self2 + other2) / 2.0;
+	p_free_edge.polygon->edges[p_free_edge.edge].connections.push_back(new_connection);
+	edge_connection_count += 1;
+}
+
+void NavMap::_update_region_connections() {
+	for (NavRegion *region : regions) {
+		region->get_connections().clear();
+	}
+
+	// Add the edge connections to the region_connection map.
+	for (const gd::Edge::Connection &free_edge : free_edges) {
+		Vector<gd::Edge::Connection> &region_connections = ((NavRegion *)free_edge.polygon->owner)->get_connections();
+		for (const gd::Edge::Connection &connection : free_edge.polygon->edges[free_edge.edge].connections) {
+			region_connections.push_back(connection);
+		}
+	}
+}
+
+void NavMap::_update_polygons() {
+	polygons.clear();
+	for (const NavRegion *region : regions) {
+		LocalVector<gd::Polygon> *map_polygons = region_polygons.getptr(region);
+		if (!map_polygons) {
+			continue;
+		}
+		for (gd::Polygon &poly : *map_polygons) {
+			poly.id = polygons.size();
+			polygons.push_back(&poly);
+		}
+	}
+
+	polygons_bvh.build(polygons);
+}
+
+void NavMap::_remove_link_connections() {
+	const gd::Polygon *link_polygons_begin = link_polygons.ptr();
+	const gd::Polygon *link_polygons_end = link_polygons_begin + link_polygons.size();
+	for (gd::Polygon *link_entry_polygon : link_entry_polygons) {
+		Vector<gd::Edge::Connection> &connections = link_entry_polygon->edges[0].connections;
+		for (uint32_t i = 0; i < connections.size();) {
+			if (connections[i].polygon >= link_polygons_begin && connections[i].polygon < link_polygons_end) {
+				connections.remove_at(i);
+			} else {
+				i++;
+			}
+		}
+	}
+	link_entry_polygons.clear();
+}
+
+uint32_t NavMap::_update_links() {
+	uint32_t link_poly_idx = 0;
+	link_polygons.resize(links.size());
+
+	// Search for polygons within range of a nav link.
+	for (const NavLink *link : links) {
+		if (!link->get_enabled()) {
+			continue;
+		}
+		const Vector3 start = link->get_start_position();
+		const Vector3 end = link->get_end_position();
+
+		gd::Polygon *closest_start_polygon = nullptr;
+		real_t closest_start_distance = link_connection_radius;
+		Vector3 closest_start_point;
+
+		gd::Polygon *closest_end_polygon = nullptr;
+		real_t closest_end_distance = link_connection_radius;
+		Vector3 closest_end_point;
+
+		// Create link to any polygons within the search radius of the start point.
+		const Vector3 search_extents = Vector3(link_connection_radius, link_connection_radius, link_connection_radius);
+		auto start_polygon_query = [&](uint32_t p_polygon_index) {
+			gd::Polygon &start_poly = *polygons[p_polygon_index];
+
+			// For each face check the distance to the start
+			for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
+				const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
+				const Vector3 start_point = start_face.get_closest_point_to(start);
+				const real_t start_distance = start_point.distance_to(start);
+
+				// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+				if (start_distance <= link_connection_radius && (start_distance < closest_start_distance || (start_distance == closest_start_distance && closest_start_polygon && start_poly.id < closest_start_polygon->id))) {
+					closest_start_distance = start_distance;
+					closest_start_point = start_point;
+					closest_start_polygon = &start_poly;
+				}
+			}
+		};
+		polygons_bvh.aabb_query(AABB(start - search_extents, search_extents * 2.0), start_polygon_query);
+
+		// Find any polygons within the search radius of the end point.
+		auto end_polygon_query = [&](uint32_t p_polygon_index) {
+			gd::Polygon &end_poly = *polygons[p_polygon_index];
+
+			// For each face check the distance to the end
+			for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
+				const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
+				const Vector3 end_point = end_face.get_closest_point_to(end);
+				const real_t end_distance = end_point.distance_to(end);
+
+				// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+				if (end_distance <= link_connection_radius && (end_distance < closest_end_distance || (end_distance == closest_end_distance && closest_end_polygon && end_poly.id < closest_end_polygon->id))) {
+					closest_end_distance = end_distance;
+					closest_end_point = end_point;
+					closest_end_polygon = &end_poly;
+				}
+			}
+		};
+		polygons_bvh.aabb_query(AABB(end - search_extents, search_extents * 2.0), end_polygon_query);
+
+		// If we have both a start and end point, then create a synthetic polygon to route through.
+		if (closest_start_polygon && closest_end_polygon) {
+			gd::Polygon &new_polygon = link_polygons[link_poly_idx];
+			new_polygon.id = polygons.size() + link_poly_idx;
+			new_polygon.owner = link;
+			link_poly_idx++;
+
+			new_polygon.edges.clear();
+			new_polygon.edges.resize(4);
+			new_polygon.points.clear();
+			new_polygon.points.reserve(4);
+
+			// Build a set of vertices that create a thin polygon going from the start to the end point.
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+
+			// Setup connections to go forward in the link.
+			{
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[0].pos;
+				entry_connection.pathway_end = new_polygon.points[1].pos;
+				closest_start_polygon->edges[0].connections.push_back(entry_connection);
+				link_entry_polygons.push_back(closest_start_polygon);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_end_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[2].pos;
+				exit_connection.pathway_end = new_polygon.points[3].pos;
+				new_polygon.edges[2].connections.push_back(exit_connection);
+			}
+
+			// If the link is bi-directional, create connections from the end to the start.
+			if (link->is_bidirectional()) {
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[2].pos;
+				entry_connection.pathway_end = new_polygon.points[3].pos;
+				closest_end_polygon->edges[0].connections.push_back(entry_connection);
+				link_entry_polygons.push_back(closest_end_polygon);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_start_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[0].pos;
+				exit_connection.pathway_end = new_polygon.points[1].pos;
+				new_polygon.edges[0].connections.push_back(exit_connection);
+			}
+		}
+	}
+
+	return link_poly_idx;
+}
+
+void NavMap::_build_clusters(uint32_t p_link_polygon_count) {
+	clusters.clear();
+
+	// Grow clusters breadth first over connected polygons of the same region, so each cluster is a compact connected patch.
+	for (gd::Polygon *polygon : polygons) {
+		polygon->cluster_id = UINT32_MAX;
+	}
+
+	LocalVector<gd::Polygon *> frontier;
+	for (gd::Polygon *seed_polygon : polygons) {
+		gd::Polygon &seed = *seed_polygon;
+		if (seed.cluster_id != UINT32_MAX) {
+			continue;
+		}
+
+		const uint32_t cluster_id = clusters.size();
+		clusters.push_back(gd::Cluster());
+		gd::Cluster &cluster = clusters[cluster_id];
+		cluster.owner = seed.owner;
+
+		uint32_t polygon_count = 0;
+		frontier.clear();
+		frontier.push_back(&seed);
+		seed.cluster_id = cluster_id;
+		for (uint32_t frontier_index = 0; frontier_index < frontier.size(); frontier_index++) {
+			const gd::Polygon *polygon = frontier[frontier_index];
+			Vector3 polygon_center;
+			for (const gd::Point &point : polygon->points) {
+				polygon_center += point.pos;
+			}
+			if (!polygon->points.is_empty()) {
+				cluster.center += polygon_center / polygon->points.size();
+				polygon_count++;
+			}
+
+			for (const gd::Edge &edge : polygon->edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					gd::Polygon *neighbor = connection.polygon;
+					if (frontier.size() >= hierarchical_cluster_size) {
+						break;
+					}
+					if (neighbor->cluster_id != UINT32_MAX || neighbor->owner != seed.owner || neighbor->id >= polygons.size()) {
+						continue;
+					}
+					neighbor->cluster_id = cluster_id;
+					frontier.push_back(neighbor);
+				}
+			}
+		}
+		if (polygon_count > 0) {
+			cluster.center /= polygon_count;
+		}
+	}
+
+	// Every link gets its own cluster, they are the shortcuts between far away clusters.
+	for (uint32_t link_poly_idx = 0; link_poly_idx < p_link_polygon_count; link_poly_idx++) {
+		gd::Polygon &link_polygon = link_polygons[link_poly_idx];
+		link_polygon.cluster_id = clusters.size();
+
+		gd::Cluster cluster;
+		cluster.owner = link_polygon.owner;
+		cluster.center = (link_polygon.points[0].pos + link_polygon.points[2].pos) * 0.5;
+		clusters.push_back(cluster);
+	}
+
+	// Connect the clusters, keeping the shortest portal between two clusters.
+	auto add_portals = [&](const gd::Polygon &p_polygon) {
+		gd::Cluster &cluster = clusters[p_polygon.cluster_id];
+		for (const gd::Edge &edge : p_polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t neighbor_cluster_id = connection.polygon->cluster_id;
+				if (neighbor_cluster_id == p_polygon.cluster_id) {
+					continue;
+				}
+
+				const Vector3 portal_point = (connection.pathway_start + connection.pathway_end) * 0.5;
+				gd::ClusterPortal new_portal;
+				new_portal.cluster_id = neighbor_cluster_id;
+				new_portal.distance_from = cluster.center.distance_to(portal_point);
+				new_portal.distance_to = portal_point.distance_to(clusters[neighbor_cluster_id].center);
+
+				bool found = false;
+				for (gd::ClusterPortal &portal : cluster.portals) {
+					if (portal.cluster_id == neighbor_cluster_id) {
+						if (new_portal.distance_from + new_portal.distance_to < portal.distance_from + portal.distance_to) {
+							portal = new_portal;
+						}
+						found = true;
+						break;
+					}
+				}
+				if (!found) {
+					cluster.portals.push_back(new_portal);
+				}
+			}
+		}
+	};
+	for (const gd::Polygon *polygon : polygons) {
+		add_portals(*polygon);
+	}
+	for (uint32_t link_poly_idx = 0; link_poly_idx < p_link_polygon_count; link_poly_idx++) {
+		add_portals(link_polygons[link_poly_idx]);
+	}
 }
 
 void NavMap::_update_rvo_agents_tree_3d() {
@@ -1298,7 +1885,15 @@ void NavMap::_update_merge_rasterizer_cell_dimensions() {
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/3d/use_hierarchical_pathfinding");
+	hierarchical_cluster_size = MAX(1, int(GLOBAL_GET("navigation/3d/hierarchical_cluster_size")));
+
+	set_path_cache_size(MAX(0, int(GLOBAL_GET("navigation/3d/path_cache_size"))));
 }
 
 NavMap::~NavMap() {
+	for (PathQuerySlots *query_slots : free_path_query_slots) {
+		memdelete(query_slots);
+	}
 }
@@ -31,11 +31,14 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_polygon_bvh.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/lru.h"
+#include "core/templates/safe_refcount.h"
 
 #include <KdTree3d.h>
 #include <RVOSimulator3d.h>
@@ -70,17 +73,51 @@ class NavMap : public NavRid {
 	real_t link_connection_radius = 1.0;
 
 	bool regenerate_polygons = true;
+	/// Merges all regions again instead of only the changed ones.
 	bool regenerate_links = true;
+	/// Connects the links again, without merging the regions.
+	bool links_dirty = true;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
 
+	/// Regions added or changed since the last sync, only these are merged again with the rest of the map.
+	LocalVector<NavRegion *> changed_regions;
+	/// Regions removed since the last sync, their polygons are disconnected from the map on the next sync.
+	LocalVector<const NavRegion *> removed_regions;
+
 	/// Map links
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
 
-	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	/// Map copies of the polygons of each enabled region. They are kept between syncs
+	/// so the polygons of unchanged regions keep their connections.
+	HashMap<const NavRegion *, LocalVector<gd::Polygon>> region_polygons;
+
+	/// Map polygons, indexed by polygon id.
+	LocalVector<gd::Polygon *> polygons;
+
+	/// Polygon edges grouped by edge key. Keys with two connections are merged edges, keys with one are not.
+	HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey> edge_connections;
+	/// Edges not merged with another edge that may connect to edges of other regions by proximity.
+	LocalVector<gd::Edge::Connection> free_edges;
+	/// Number of merged edges and of edge connections by proximity, updated as regions are merged and removed.
+	int edge_merge_count = 0;
+	int edge_connection_count = 0;
+
+	/// Polygons that got the entry connection of a link, so link connections can be removed without touching the other polygons.
+	LocalVector<gd::Polygon *> link_entry_polygons;
+
+	/// Spatial index over the map polygons, used to find the polygons closest to a position.
+	NavPolygonBVH polygons_bvh;
+
+	/// When enabled, path queries first search a corridor over clusters of polygons and only expand the polygons inside it.
+	bool use_hierarchical_pathfinding = false;
+	/// Maximum number of polygons grouped in a cluster.
+	uint32_t hierarchical_cluster_size = 64;
+
+	/// Map clusters, only built when hierarchical pathfinding is used.
+	LocalVector<gd::Cluster> clusters;
 
 	/// RVO avoidance worlds
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -119,8 +156,26 @@ class NavMap : public NavRid {
 	int pm_edge_merge_count = 0;
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
+	int pm_cluster_count = 0;
+	int pm_path_cache_hit_count = 0;
+	int pm_path_cache_miss_count = 0;
 
 public:
+	/// Reusable working memory of a path query, it can be shared by queries against different maps
+	/// as long as they don't run at the same time.
+	struct PathQuerySlots {
+		/// Search state of every map and link polygon, indexed by polygon id.
+		LocalVector<gd::NavigationPoly> navigation_polys;
+		/// Heap of polygons to travel next.
+		gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> traversable_polys;
+		/// Search state of every map cluster, indexed by cluster id.
+		LocalVector<gd::NavigationCluster> navigation_clusters;
+		/// Heap of clusters to travel next.
+		gd::Heap<gd::NavigationCluster *, gd::NavClusterTravelCostGreaterThan, gd::NavClusterHeapIndexer> traversable_clusters;
+		/// Id of the running query, slots stamped with another id count as not visited.
+		uint32_t query_id = 0;
+	};
+
 	NavMap();
 	~NavMap();
 
@@ -159,9 +214,27 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_path_cache_size(uint32_t p_path_cache_size);
+	uint32_t get_path_cache_size() const {
+		return path_cache_size.get();
+	}
+	/// Drops all cached routes, for changes to the costs or layers of regions and links which don't update the map.
+	void clear_path_cache();
+
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
+	void set_hierarchical_cluster_size(uint32_t p_cluster_size);
+	uint32_t get_hierarchical_cluster_size() const {
+		return hierarchical_cluster_size;
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
-	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
+	/// When `r_query_slots` is `nullptr` the query takes its working memory from a pool owned by the map.
+	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, PathQuerySlots *r_query_slots = nullptr) const;
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
@@ -212,8 +285,41 @@ public:
 	int get_pm_edge_merge_count() const { return pm_edge_merge_count; }
 	int get_pm_edge_connection_count() const { return pm_edge_connection_count; }
 	int get_pm_edge_free_count() const { return pm_edge_free_count; }
+	int get_pm_cluster_count() const { return pm_cluster_count; }
+	int get_pm_path_cache_hit_count() const { return pm_path_cache_hit_count; }
+	int get_pm_path_cache_miss_count() const { return pm_path_cache_miss_count; }
 
 private:
+	/// Path query slots not in use by any query, reused so queries don't allocate or clear per-polygon state.
+	mutable Mutex path_query_slots_mutex;
+	mutable LocalVector<PathQuerySlots *> free_path_query_slots;
+
+	/// Routes found by recent path queries, as the polygons they cross from the end to the begin polygon.
+	/// A hit skips the A* search, the path is still post-processed for the exact query positions.
+	SafeNumeric<uint32_t> path_cache_size;
+	mutable Mutex path_cache_mutex;
+	mutable LRUCache<gd::PathCacheKey, Vector<gd::PathCacheStep>, gd::PathCacheKey> path_cache;
+	mutable SafeNumeric<uint32_t> path_cache_hit_count;
+	mutable SafeNumeric<uint32_t> path_cache_miss_count;
+
+	PathQuerySlots *_acquire_path_query_slots() const;
+	void _release_path_query_slots(PathQuerySlots *p_query_slots) const;
+	static void _begin_path_query(PathQuerySlots &r_query_slots);
+	Vector<Vector3> _get_path(PathQuerySlots &r_query_slots, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
+	const gd::Polygon *_get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, Vector3 &r_closest_point) const;
+	bool _find_cluster_corridor(PathQuerySlots &r_query_slots, uint32_t p_begin_cluster_id, uint32_t p_end_cluster_id, uint32_t p_navigation_layers) const;
+	void _build_clusters(uint32_t p_link_polygon_count);
+
+	void _detach_region_polygons(const NavRegion *p_region, const LocalVector<const NavRegion *> &p_detached_regions, LocalVector<gd::Edge::Connection> &r_new_free_edges);
+	void _attach_region_polygons(NavRegion *p_region, LocalVector<gd::Edge::Connection> &r_new_free_edges);
+	void _remove_free_edge(const gd::Edge::Connection &p_edge);
+	void _connect_free_edges(const LocalVector<gd::Edge::Connection> &p_new_free_edges);
+	void _connect_edge_by_proximity(const gd::Edge::Connection &p_free_edge, const gd::Edge::Connection &p_other_edge);
+	void _update_region_connections();
+	void _update_polygons();
+	void _remove_link_connections();
+	uint32_t _update_links();
+
 	void compute_single_step(uint32_t index, NavAgent **agent);
 
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh.h"
+
+#include "core/templates/sort_array.h"
+
+struct NavPolygonBVHCenterComparator {
+	const Vector3 *centers = nullptr;
+	Vector3::Axis axis = Vector3::AXIS_X;
+
+	_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+		return centers[p_a][axis] < centers[p_b][axis];
+	}
+};
+
+uint32_t NavPolygonBVH::_build_node(const LocalVector<AABB> &p_aabbs, const LocalVector<Vector3> &p_centers, uint32_t p_from, uint32_t p_to, uint32_t p_depth) {
+	const uint32_t node_index = nodes.size();
+	nodes.push_back(Node());
+
+	AABB node_aabb = p_aabbs[items[p_from]];
+	AABB center_bounds(p_centers[items[p_from]], Vector3());
+	for (uint32_t i = p_from + 1; i < p_to; i++) {
+		node_aabb.merge_with(p_aabbs[items[i]]);
+		center_bounds.expand_to(p_centers[items[i]]);
+	}
+	nodes[node_index].aabb = node_aabb;
+
+	// Polygons sharing the same center can not be split any further.
+	if (p_to - p_from <= MAX_ITEMS_PER_LEAF || p_depth + 2 >= MAX_DEPTH || center_bounds.size == Vector3()) {
+		nodes[node_index].index = p_from;
+		nodes[node_index].count = p_to - p_from;
+		return node_index;
+	}
+
+	// Median split along the longest axis of the polygon centers keeps the tree balanced.
+	SortArray<uint32_t, NavPolygonBVHCenterComparator> sorter;
+	sorter.compare.centers = p_centers.ptr();
+	sorter.compare.axis = center_bounds.size.max_axis_index();
+	const uint32_t middle = p_from + (p_to - p_from) / 2;
+	sorter.nth_element(p_from, p_to, middle, items.ptr());
+
+	_build_node(p_aabbs, p_centers, p_from, middle, p_depth + 1);
+	const uint32_t second_child = _build_node(p_aabbs, p_centers, middle, p_to, p_depth + 1);
+	nodes[node_index].index = second_child;
+	return node_index;
+}
+
+void NavPolygonBVH::build(const LocalVector<gd::Polygon *> &p_polygons) {
+	clear();
+
+	LocalVector<AABB> aabbs;
+	LocalVector<Vector3> centers;
+	aabbs.resize(p_polygons.size());
+	centers.resize(p_polygons.size());
+	items.reserve(p_polygons.size());
+
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const gd::Polygon &polygon = *p_polygons[i];
+		// Invalid polygons are never hit by queries, so they are left out of the tree.
+		if (polygon.points.size() < 3) {
+			continue;
+		}
+
+		AABB aabb(polygon.points[0].pos, Vector3());
+		for (uint32_t j = 1; j < polygon.points.size(); j++) {
+			aabb.expand_to(polygon.points[j].pos);
+		}
+		aabbs[i] = aabb;
+		centers[i] = aabb.get_center();
+		items.push_back(i);
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	nodes.reserve(items.size() / MAX_ITEMS_PER_LEAF * 2 + 1);
+	_build_node(aabbs, centers, 0, items.size(), 0);
+}
+
+void NavPolygonBVH::clear() {
+	nodes.clear();
+	items.clear();
+}
@@ -0,0 +1,145 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+#include "core/templates/local_vector.h"
+
+/// Static bounding volume hierarchy over the polygons of a navigation map.
+/// It is rebuilt when the map polygons change and only read afterwards, so
+/// concurrent queries are safe as long as the map is read-locked.
+class NavPolygonBVH {
+	static constexpr uint32_t MAX_ITEMS_PER_LEAF = 4;
+	static constexpr uint32_t MAX_DEPTH = 64;
+
+	struct Node {
+		AABB aabb;
+		/// First item for leaves, index of the second child for branches (the first child directly follows its parent).
+		uint32_t index = 0;
+		/// Number of items for leaves, zero for branches.
+		uint32_t count = 0;
+	};
+
+	LocalVector<Node> nodes;
+	/// Indices of the polygons, ordered so that each leaf references a contiguous range.
+	LocalVector<uint32_t> items;
+
+	uint32_t _build_node(const LocalVector<AABB> &p_aabbs, const LocalVector<Vector3> &p_centers, uint32_t p_from, uint32_t p_to, uint32_t p_depth);
+
+	_FORCE_INLINE_ static real_t _get_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+		return p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size).distance_squared_to(p_point);
+	}
+
+public:
+	void build(const LocalVector<gd::Polygon *> &p_polygons);
+	void clear();
+	bool is_empty() const { return nodes.is_empty(); }
+
+	/// Calls `r_result(polygon_index)` for every polygon whose bounds intersect `p_aabb`.
+	template <typename QueryResult>
+	void aabb_query(const AABB &p_aabb, QueryResult &r_result) const;
+
+	/// Visits polygons from nearest to farthest bounds and skips any subtree whose bounds are farther than
+	/// the current best. `r_result(polygon_index, r_closest_distance_squared)` is expected to lower the
+	/// best distance when it finds a closer point.
+	template <typename QueryResult>
+	void closest_query(const Vector3 &p_point, QueryResult &r_result) const;
+};
+
+template <typename QueryResult>
+void NavPolygonBVH::aabb_query(const AABB &p_aabb, QueryResult &r_result) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	uint32_t stack[MAX_DEPTH];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const uint32_t node_index = stack[--stack_size];
+		const Node &node = nodes[node_index];
+		if (!node.aabb.intersects_inclusive(p_aabb)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.index; i < node.index + node.count; i++) {
+				r_result(items[i]);
+			}
+		} else {
+			stack[stack_size++] = node.index;
+			stack[stack_size++] = node_index + 1;
+		}
+	}
+}
+
+template <typename QueryResult>
+void NavPolygonBVH::closest_query(const Vector3 &p_point, QueryResult &r_result) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	real_t closest_distance_squared = FLT_MAX;
+
+	uint32_t stack[MAX_DEPTH];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const uint32_t node_index = stack[--stack_size];
+		const Node &node = nodes[node_index];
+		if (_get_distance_squared(node.aabb, p_point) > closest_distance_squared) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.index; i < node.index + node.count; i++) {
+				r_result(items[i], closest_distance_squared);
+			}
+			continue;
+		}
+
+		// Push the farthest child first so the nearest one is visited first and tightens the bound early.
+		uint32_t near_child = node_index + 1;
+		uint32_t far_child = node.index;
+		if (_get_distance_squared(nodes[far_child].aabb, p_point) < _get_distance_squared(nodes[near_child].aabb, p_point)) {
+			SWAP(near_child, far_child);
+		}
+		stack[stack_size++] = far_child;
+		stack[stack_size++] = near_child;
+	}
+}
+
+#endif // NAV_POLYGON_BVH_H
@@ -98,6 +98,12 @@ struct Edge {
 };
 
 struct Polygon {
+	/// Id of the polygon in the map.
+	uint32_t id = UINT32_MAX;
+
+	/// Id of the cluster grouping this polygon, only set when hierarchical pathfinding is used.
+	uint32_t cluster_id = UINT32_MAX;
+
 	/// Navigation region or link that contains this polygon.
 	const NavBase *owner = nullptr;
 
@@ -111,9 +117,11 @@ struct Polygon {
 };
 
 struct NavigationPoly {
-	uint32_t self_id = 0;
 	/// This poly.
-	const Polygon *poly;
+	const Polygon *poly = nullptr;
+
+	/// Id of the path query that last reached this poly, older ids mean the poly is not visited yet.
+	uint32_t query_id = 0;
 
 	/// Those 4 variables are used to travel the path backwards.
 	int back_navigation_poly_id = -1;
@@ -123,20 +131,29 @@ struct NavigationPoly {
 
 	/// The entry position of this poly.
 	Vector3 entry;
-	/// The distance to the destination.
+	/// The distance traveled until now (g cost).
 	real_t traveled_distance = 0.0;
+	/// The distance to the destination (h cost).
+	real_t distance_to_destination = 0.0;
 
-	NavigationPoly() { poly = nullptr; }
+	/// The index of this poly in the heap of traversable polygons, `UINT32_MAX` when it is not in the heap.
+	uint32_t traversable_poly_index = UINT32_MAX;
 
-	NavigationPoly(const Polygon *p_poly) :
-			poly(p_poly) {}
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+};
 
-	bool operator==(const NavigationPoly &other) const {
-		return poly == other.poly;
+struct NavPolyTravelCostGreaterThan {
+	// Returns `true` if the travel cost of `a` is higher than that of `b`.
+	bool operator()(const NavigationPoly *p_poly_a, const NavigationPoly *p_poly_b) const {
+		return p_poly_a->total_travel_cost() > p_poly_b->total_travel_cost();
 	}
+};
 
-	bool operator!=(const NavigationPoly &other) const {
-		return !operator==(other);
+struct NavPolyHeapIndexer {
+	void operator()(NavigationPoly *p_poly, uint32_t p_heap_index) const {
+		p_poly->traversable_poly_index = p_heap_index;
 	}
 };
 
@@ -146,6 +163,210 @@ struct ClosestPointQueryResult {
 	RID owner;
 };
 
+/// Identifies the route between two polygons of a map iteration, as searched with some navigation layers.
+struct PathCacheKey {
+	uint32_t begin_polygon_id = UINT32_MAX;
+	uint32_t end_polygon_id = UINT32_MAX;
+	uint32_t navigation_layers = 0;
+	uint32_t iteration_id = 0;
+
+	static uint32_t hash(const PathCacheKey &p_val) {
+		uint32_t h = hash_murmur3_one_32(p_val.begin_polygon_id);
+		h = hash_murmur3_one_32(p_val.end_polygon_id, h);
+		h = hash_murmur3_one_32(p_val.navigation_layers, h);
+		h = hash_murmur3_one_32(p_val.iteration_id, h);
+		return hash_fmix32(h);
+	}
+
+	bool operator==(const PathCacheKey &p_key) const {
+		return begin_polygon_id == p_key.begin_polygon_id && end_polygon_id == p_key.end_polygon_id && navigation_layers == p_key.navigation_layers && iteration_id == p_key.iteration_id;
+	}
+};
+
+/// One polygon of a cached route, with the edge it was entered from.
+struct PathCacheStep {
+	uint32_t polygon_id = UINT32_MAX;
+	int back_navigation_edge = -1;
+	Vector3 back_navigation_edge_pathway_start;
+	Vector3 back_navigation_edge_pathway_end;
+};
+
+struct ClusterPortal {
+	/// Cluster this portal leads to.
+	uint32_t cluster_id = UINT32_MAX;
+
+	/// Distance from the center of the source cluster to the portal.
+	real_t distance_from = 0.0;
+
+	/// Distance from the portal to the center of the target cluster.
+	real_t distance_to = 0.0;
+};
+
+/// A group of connected polygons of the same owner, used to plan long paths before refining them on polygons.
+struct Cluster {
+	/// Navigation region or link that contains the polygons of this cluster.
+	const NavBase *owner = nullptr;
+
+	/// Average of the polygon centers.
+	Vector3 center;
+
+	/// Connections to the neighbor clusters, at most one per neighbor.
+	LocalVector<ClusterPortal> portals;
+};
+
+struct NavigationCluster {
+	/// Id of the path query that last reached this cluster, older ids mean the cluster is not visited yet.
+	uint32_t query_id = 0;
+
+	/// Id of the path query whose cluster corridor contains this cluster.
+	uint32_t corridor_query_id = 0;
+
+	uint32_t cluster_id = UINT32_MAX;
+	int back_cluster_id = -1;
+
+	real_t traveled_distance = 0.0;
+	real_t distance_to_destination = 0.0;
+
+	/// The index of this cluster in the heap of traversable clusters, `UINT32_MAX` when it is not in the heap.
+	uint32_t traversable_cluster_index = UINT32_MAX;
+
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+};
+
+struct NavClusterTravelCostGreaterThan {
+	bool operator()(const NavigationCluster *p_cluster_a, const NavigationCluster *p_cluster_b) const {
+		return p_cluster_a->total_travel_cost() > p_cluster_b->total_travel_cost();
+	}
+};
+
+struct NavClusterHeapIndexer {
+	void operator()(NavigationCluster *p_cluster, uint32_t p_heap_index) const {
+		p_cluster->traversable_cluster_index = p_heap_index;
+	}
+};
+
+template <typename T>
+struct NoopIndexer {
+	void operator()(const T &p_value, uint32_t p_index) {}
+};
+
+/**
+ * A max-heap that notifies the indexer of every element position change, so elements can later
+ * be re-prioritized in place with `shift()`.
+ */
+template <typename T, typename LessThan = Comparator<T>, typename Indexer = NoopIndexer<T>>
+class Heap {
+	LocalVector<T> _buffer;
+
+	LessThan _less_than;
+	Indexer _indexer;
+
+public:
+	void reserve(uint32_t p_size) {
+		_buffer.reserve(p_size);
+	}
+
+	uint32_t size() const {
+		return _buffer.size();
+	}
+
+	bool is_empty() const {
+		return _buffer.is_empty();
+	}
+
+	void push(const T &p_element) {
+		_buffer.push_back(p_element);
+		_indexer(p_element, _buffer.size() - 1);
+		_shift_up(_buffer.size() - 1);
+	}
+
+	T pop() {
+		ERR_FAIL_COND_V_MSG(_buffer.is_empty(), T(), "Can't pop an empty heap.");
+		T value = _buffer[0];
+		_indexer(value, UINT32_MAX);
+		if (_buffer.size() > 1) {
+			_buffer[0] = _buffer[_buffer.size() - 1];
+			_indexer(_buffer[0], 0);
+			_buffer.resize(_buffer.size() - 1);
+			_shift_down(0);
+		} else {
+			_buffer.resize(0);
+		}
+		return value;
+	}
+
+	/**
+	 * Update the position of the element in the heap if necessary.
+	 * Only an increased priority is supported (e.g. a lower travel cost with `NavPolyTravelCostGreaterThan`).
+	 */
+	void shift(uint32_t p_index) {
+		ERR_FAIL_UNSIGNED_INDEX_MSG(p_index, _buffer.size(), "Heap element index is out of range.");
+		_shift_up(p_index);
+	}
+
+	void clear() {
+		for (const T &element : _buffer) {
+			_indexer(element, UINT32_MAX);
+		}
+		_buffer.clear();
+	}
+
+	Heap() {}
+
+	Heap(const LessThan &p_less_than) :
+			_less_than(p_less_than) {}
+
+	Heap(const Indexer &p_indexer) :
+			_indexer(p_indexer) {}
+
+	Heap(const LessThan &p_less_than, const Indexer &p_indexer) :
+			_less_than(p_less_than), _indexer(p_indexer) {}
+
+private:
+	void _shift_down(uint32_t p_index) {
+		while (true) {
+			uint32_t left = 2 * p_index + 1;
+			uint32_t right = 2 * p_index + 2;
+
+			if (left >= _buffer.size()) {
+				return;
+			}
+
+			uint32_t max_index = left;
+			if (right < _buffer.size() && _less_than(_buffer[left], _buffer[right])) {
+				max_index = right;
+			}
+
+			if (_less_than(_buffer[p_index], _buffer[max_index])) {
+				_swap(max_index, p_index);
+				p_index = max_index;
+			} else {
+				return;
+			}
+		}
+	}
+
+	void _shift_up(uint32_t p_index) {
+		while (p_index > 0) {
+			uint32_t parent = (p_index - 1) / 2;
+			if (_less_than(_buffer[parent], _buffer[p_index])) {
+				_swap(parent, p_index);
+				p_index = parent;
+			} else {
+				return;
+			}
+		}
+	}
+
+	void _swap(uint32_t p_index_a, uint32_t p_index_b) {
+		SWAP(_buffer[p_index_a], _buffer[p_index_b]);
+		_indexer(_buffer[p_index_a], p_index_a);
+		_indexer(_buffer[p_index_b], p_index_b);
+	}
+};
+
 } // namespace gd
 
 #endif // NAV_UTILS_H
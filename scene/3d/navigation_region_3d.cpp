@@ -256,6 +256,22 @@ void NavigationRegion3D::bake_navigation_mesh(bool p_on_thread) {
 	}
 }
 
+void NavigationRegion3D::bake_navigation_mesh_tiles(const AABB &p_aabb, bool p_on_thread) {
+	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "The SceneTree can only be parsed on the main thread. Call this function from the main thread or use call_deferred().");
+	ERR_FAIL_COND_MSG(!navigation_mesh.is_valid(), "Baking the navigation mesh requires a valid `NavigationMesh` resource.");
+
+	Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
+	source_geometry_data.instantiate();
+
+	NavigationServer3D::get_singleton()->parse_source_geometry_data(navigation_mesh, source_geometry_data, this);
+
+	if (p_on_thread) {
+		NavigationServer3D::get_singleton()->bake_tiles_from_source_geometry_data_async(navigation_mesh, source_geometry_data, p_aabb, callable_mp(this, &NavigationRegion3D::_bake_finished).bind(navigation_mesh));
+	} else {
+		NavigationServer3D::get_singleton()->bake_tiles_from_source_geometry_data(navigation_mesh, source_geometry_data, p_aabb, callable_mp(this, &NavigationRegion3D::_bake_finished).bind(navigation_mesh));
+	}
+}
+
 void NavigationRegion3D::_bake_finished(Ref<NavigationMesh> p_navigation_mesh) {
 	if (!Thread::is_main_thread()) {
 		callable_mp(this, &NavigationRegion3D::_bake_finished).call_deferred(p_navigation_mesh);
@@ -312,6 +328,7 @@ void NavigationRegion3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_travel_cost"), &NavigationRegion3D::get_travel_cost);
 
 	ClassDB::bind_method(D_METHOD("bake_navigation_mesh", "on_thread"), &NavigationRegion3D::bake_navigation_mesh, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("bake_navigation_mesh_tiles", "aabb", "on_thread"), &NavigationRegion3D::bake_navigation_mesh_tiles, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("is_baking"), &NavigationRegion3D::is_baking);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "navigation_mesh", PROPERTY_HINT_RESOURCE_TYPE, "NavigationMesh"), "set_navigation_mesh", "get_navigation_mesh");
@@ -100,6 +100,7 @@ public:
 	/// Bakes the navigation mesh; once done, automatically
 	/// sets the new navigation mesh and emits a signal
 	void bake_navigation_mesh(bool p_on_thread);
+	void bake_navigation_mesh_tiles(const AABB &p_aabb, bool p_on_thread);
 	void _bake_finished(Ref<NavigationMesh> p_navigation_mesh);
 	bool is_baking() const;
 
@@ -384,16 +384,64 @@ void Area3D::set_monitoring(bool p_enable) {
 
 	monitoring = p_enable;
 
-	if (monitoring) {
-		PhysicsServer3D::get_singleton()->area_set_monitor_callback(get_rid(), callable_mp(this, &Area3D::_body_inout));
-		PhysicsServer3D::get_singleton()->area_set_area_monitor_callback(get_rid(), callable_mp(this, &Area3D::_area_inout));
-	} else {
+	_update_monitor_callbacks();
+
+	if (!monitoring) {
+		_clear_monitoring();
+	}
+}
+
+void Area3D::_update_monitor_callbacks() {
+	if (!monitoring) {
 		PhysicsServer3D::get_singleton()->area_set_monitor_callback(get_rid(), Callable());
 		PhysicsServer3D::get_singleton()->area_set_area_monitor_callback(get_rid(), Callable());
-		_clear_monitoring();
+	} else if (batch_overlap_events) {
+		PhysicsServer3D::get_singleton()->area_set_monitor_callback(get_rid(), callable_mp(this, &Area3D::_body_batch_inout));
+		PhysicsServer3D::get_singleton()->area_set_area_monitor_callback(get_rid(), callable_mp(this, &Area3D::_area_batch_inout));
+	} else {
+		PhysicsServer3D::get_singleton()->area_set_monitor_callback(get_rid(), callable_mp(this, &Area3D::_body_inout));
+		PhysicsServer3D::get_singleton()->area_set_area_monitor_callback(get_rid(), callable_mp(this, &Area3D::_area_inout));
 	}
 }
 
+void Area3D::_body_batch_inout(const PackedInt32Array &p_statuses, const Array &p_bodies, const PackedInt64Array &p_instances, const PackedInt32Array &p_body_shapes, const PackedInt32Array &p_area_shapes) {
+	lock_callback();
+	locked = true;
+	emit_signal(SNAME("body_shape_events_batched"), p_statuses, p_bodies, p_instances, p_body_shapes, p_area_shapes);
+	locked = false;
+	unlock_callback();
+}
+
+void Area3D::_area_batch_inout(const PackedInt32Array &p_statuses, const Array &p_areas, const PackedInt64Array &p_instances, const PackedInt32Array &p_area_shapes, const PackedInt32Array &p_self_shapes) {
+	lock_callback();
+	locked = true;
+	emit_signal(SNAME("area_shape_events_batched"), p_statuses, p_areas, p_instances, p_area_shapes, p_self_shapes);
+	locked = false;
+	unlock_callback();
+}
+
+void Area3D::set_batch_overlap_events(bool p_enable) {
+	ERR_FAIL_COND_MSG(locked, "Function blocked during in/out signal. Use set_deferred(\"batch_overlap_events\", true/false).");
+
+	if (p_enable == batch_overlap_events) {
+		return;
+	}
+
+	batch_overlap_events = p_enable;
+
+	// Overlaps are no longer tracked per body when batching, and the physics server reports all current overlaps as new
+	// once the callbacks change, so start over from an empty state either way.
+	_clear_monitoring();
+
+	PhysicsServer3D::get_singleton()->area_set_monitor_batching(get_rid(), batch_overlap_events);
+
+	_update_monitor_callbacks();
+}
+
+bool Area3D::is_batching_overlap_events() const {
+	return batch_overlap_events;
+}
+
 void Area3D::_area_enter_tree(ObjectID p_id) {
 	Object *obj = ObjectDB::get_instance(p_id);
 	Node *node = Object::cast_to<Node>(obj);
@@ -512,6 +560,7 @@ bool Area3D::is_monitoring() const {
 TypedArray<Node3D> Area3D::get_overlapping_bodies() const {
 	TypedArray<Node3D> ret;
 	ERR_FAIL_COND_V_MSG(!monitoring, ret, "Can't find overlapping bodies when monitoring is off.");
+	ERR_FAIL_COND_V_MSG(batch_overlap_events, ret, "Can't find overlapping bodies when overlap events are batched.");
 	ret.resize(body_map.size());
 	int idx = 0;
 	for (const KeyValue<ObjectID, BodyState> &E : body_map) {
@@ -528,6 +577,7 @@ TypedArray<Node3D> Area3D::get_overlapping_bodies() const {
 
 bool Area3D::has_overlapping_bodies() const {
 	ERR_FAIL_COND_V_MSG(!monitoring, false, "Can't find overlapping bodies when monitoring is off.");
+	ERR_FAIL_COND_V_MSG(batch_overlap_events, false, "Can't find overlapping bodies when overlap events are batched.");
 	return !body_map.is_empty();
 }
 
@@ -550,6 +600,7 @@ bool Area3D::is_monitorable() const {
 TypedArray<Area3D> Area3D::get_overlapping_areas() const {
 	TypedArray<Area3D> ret;
 	ERR_FAIL_COND_V_MSG(!monitoring, ret, "Can't find overlapping areas when monitoring is off.");
+	ERR_FAIL_COND_V_MSG(batch_overlap_events, ret, "Can't find overlapping areas when overlap events are batched.");
 	ret.resize(area_map.size());
 	int idx = 0;
 	for (const KeyValue<ObjectID, AreaState> &E : area_map) {
@@ -565,6 +616,7 @@ TypedArray<Area3D> Area3D::get_overlapping_areas() const {
 
 bool Area3D::has_overlapping_areas() const {
 	ERR_FAIL_COND_V_MSG(!monitoring, false, "Can't find overlapping areas when monitoring is off.");
+	ERR_FAIL_COND_V_MSG(batch_overlap_events, false, "Can't find overlapping areas when overlap events are batched.");
 	return !area_map.is_empty();
 }
 
@@ -730,6 +782,9 @@ void Area3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_monitoring", "enable"), &Area3D::set_monitoring);
 	ClassDB::bind_method(D_METHOD("is_monitoring"), &Area3D::is_monitoring);
 
+	ClassDB::bind_method(D_METHOD("set_batch_overlap_events", "enable"), &Area3D::set_batch_overlap_events);
+	ClassDB::bind_method(D_METHOD("is_batching_overlap_events"), &Area3D::is_batching_overlap_events);
+
 	ClassDB::bind_method(D_METHOD("get_overlapping_bodies"), &Area3D::get_overlapping_bodies);
 	ClassDB::bind_method(D_METHOD("get_overlapping_areas"), &Area3D::get_overlapping_areas);
 
@@ -767,8 +822,12 @@ void Area3D::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("area_entered", PropertyInfo(Variant::OBJECT, "area", PROPERTY_HINT_RESOURCE_TYPE, "Area3D")));
 	ADD_SIGNAL(MethodInfo("area_exited", PropertyInfo(Variant::OBJECT, "area", PROPERTY_HINT_RESOURCE_TYPE, "Area3D")));
 
+	ADD_SIGNAL(MethodInfo("body_shape_events_batched", PropertyInfo(Variant::PACKED_INT32_ARRAY, "statuses"), PropertyInfo(Variant::ARRAY, "body_rids", PROPERTY_HINT_ARRAY_TYPE, "RID"), PropertyInfo(Variant::PACKED_INT64_ARRAY, "body_instance_ids"), PropertyInfo(Variant::PACKED_INT32_ARRAY, "body_shape_indices"), PropertyInfo(Variant::PACKED_INT32_ARRAY, "local_shape_indices")));
+	ADD_SIGNAL(MethodInfo("area_shape_events_batched", PropertyInfo(Variant::PACKED_INT32_ARRAY, "statuses"), PropertyInfo(Variant::ARRAY, "area_rids", PROPERTY_HINT_ARRAY_TYPE, "RID"), PropertyInfo(Variant::PACKED_INT64_ARRAY, "area_instance_ids"), PropertyInfo(Variant::PACKED_INT32_ARRAY, "area_shape_indices"), PropertyInfo(Variant::PACKED_INT32_ARRAY, "local_shape_indices")));
+
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitoring"), "set_monitoring", "is_monitoring");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitorable"), "set_monitorable", "is_monitorable");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "batch_overlap_events"), "set_batch_overlap_events", "is_batching_overlap_events");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "priority", PROPERTY_HINT_RANGE, "0,100000,1,or_greater,or_less"), "set_priority", "get_priority");
 
 	ADD_GROUP("Gravity", "gravity_");
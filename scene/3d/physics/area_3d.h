@@ -66,9 +66,13 @@ private:
 
 	bool monitoring = false;
 	bool monitorable = false;
+	bool batch_overlap_events = false;
 	bool locked = false;
 
+	void _update_monitor_callbacks();
+
 	void _body_inout(int p_status, const RID &p_body, ObjectID p_instance, int p_body_shape, int p_area_shape);
+	void _body_batch_inout(const PackedInt32Array &p_statuses, const Array &p_bodies, const PackedInt64Array &p_instances, const PackedInt32Array &p_body_shapes, const PackedInt32Array &p_area_shapes);
 
 	void _body_enter_tree(ObjectID p_id);
 	void _body_exit_tree(ObjectID p_id);
@@ -101,6 +105,7 @@ private:
 	HashMap<ObjectID, BodyState> body_map;
 
 	void _area_inout(int p_status, const RID &p_area, ObjectID p_instance, int p_area_shape, int p_self_shape);
+	void _area_batch_inout(const PackedInt32Array &p_statuses, const Array &p_areas, const PackedInt64Array &p_instances, const PackedInt32Array &p_area_shapes, const PackedInt32Array &p_self_shapes);
 
 	void _area_enter_tree(ObjectID p_id);
 	void _area_exit_tree(ObjectID p_id);
@@ -199,6 +204,9 @@ public:
 	void set_monitorable(bool p_enable);
 	bool is_monitorable() const;
 
+	void set_batch_overlap_events(bool p_enable);
+	bool is_batching_overlap_events() const;
+
 	TypedArray<Node3D> get_overlapping_bodies() const;
 	TypedArray<Area3D> get_overlapping_areas() const; //function for script
 
@@ -104,7 +104,9 @@ bool CharacterBody3D::move_and_slide() {
 	}
 
 	if (motion_mode == MOTION_MODE_GROUNDED) {
-		_move_and_slide_grounded(delta, was_on_floor);
+		if (!native_controller || !_move_and_slide_native(delta, was_on_floor)) {
+			_move_and_slide_grounded(delta, was_on_floor);
+		}
 	} else {
 		_move_and_slide_floating(delta);
 	}
@@ -387,6 +389,130 @@ void CharacterBody3D::_move_and_slide_grounded(double p_delta, bool p_was_on_flo
 	}
 }
 
+bool CharacterBody3D::_move_and_slide_native(double p_delta, bool p_was_on_floor) {
+	bool vel_dir_facing_up = velocity.dot(up_direction) > 0;
+
+	// Standing on a floor with only gravity applied, let the server see the body as resting.
+	bool stop_on_slope = p_was_on_floor && floor_stop_on_slope && (velocity.normalized() + up_direction).length() < 0.01;
+
+	PhysicsServer3D::CharacterMotionParameters parameters;
+	parameters.from = get_global_transform();
+	parameters.velocity = stop_on_slope ? Vector3() : velocity;
+	parameters.delta = p_delta;
+	parameters.margin = margin;
+	parameters.up_direction = up_direction;
+	parameters.floor_max_angle = floor_max_angle + FLOOR_ANGLE_THRESHOLD;
+	parameters.max_slides = max_slides;
+	if (p_was_on_floor && !vel_dir_facing_up) {
+		parameters.floor_snap_length = floor_snap_length;
+	}
+
+	PhysicsServer3D::CharacterMotionResult result;
+	if (!PhysicsServer3D::get_singleton()->body_move_character(get_rid(), parameters, &result)) {
+		return false;
+	}
+
+	platform_rid = RID();
+	platform_object_id = ObjectID();
+	platform_velocity = Vector3();
+	platform_angular_velocity = Vector3();
+	platform_ceiling_velocity = Vector3();
+	floor_normal = Vector3();
+	wall_normal = Vector3();
+	ceiling_normal = Vector3();
+
+	Transform3D gt = get_global_transform();
+	gt.origin = result.transform.origin;
+	set_global_transform(gt);
+
+	last_motion = result.travel;
+
+	if (result.collision_count > 0) {
+		PhysicsServer3D::MotionResult motion_result;
+		motion_result.travel = result.travel;
+		motion_result.collision_depth = result.collisions[0].depth;
+		motion_result.collision_safe_fraction = 1.0;
+		motion_result.collision_unsafe_fraction = 1.0;
+		motion_result.collision_count = result.collision_count;
+		for (int i = 0; i < result.collision_count; i++) {
+			motion_result.collisions[i] = result.collisions[i];
+		}
+		motion_results.push_back(motion_result);
+
+		CollisionState result_state;
+		_set_collision_direction(motion_result, result_state);
+
+		// The controller only slides the motion, the velocity is changed here the same way _move_and_slide_grounded() does.
+		Vector3 velocity_slide_up = velocity.slide(up_direction);
+
+		// If we hit a ceiling platform, we set the vertical velocity to at least the platform one.
+		bool apply_ceiling_velocity = false;
+		if (collision_state.ceiling && platform_ceiling_velocity != Vector3() && platform_ceiling_velocity.dot(up_direction) < 0) {
+			// If ceiling sliding is on, only apply when the ceiling is flat or when the motion is upward.
+			if (!slide_on_ceiling || velocity.dot(up_direction) < 0 || (ceiling_normal + up_direction).length() < 0.01) {
+				apply_ceiling_velocity = true;
+				Vector3 ceiling_vertical_velocity = up_direction * up_direction.dot(platform_ceiling_velocity);
+				Vector3 motion_vertical_velocity = up_direction * up_direction.dot(velocity);
+				if (motion_vertical_velocity.dot(up_direction) > 0 || ceiling_vertical_velocity.length_squared() > motion_vertical_velocity.length_squared()) {
+					velocity = ceiling_vertical_velocity + velocity.slide(up_direction);
+				}
+			}
+		}
+
+		bool apply_default_sliding = true;
+
+		if (result_state.wall && velocity_slide_up.dot(wall_normal) <= 0) {
+			Vector3 horizontal_normal = wall_normal.slide(up_direction).normalized();
+
+			// Avoid to move forward on a wall if floor_block_on_wall is true.
+			if (floor_block_on_wall) {
+				real_t motion_angle = Math::abs(Math::acos(-horizontal_normal.dot(velocity_slide_up.normalized())));
+				if (motion_angle < Math_tau_over_4) {
+					apply_default_sliding = false;
+
+					// Scales the horizontal velocity according to the wall slope.
+					if (vel_dir_facing_up) {
+						Vector3 slide_velocity = velocity.slide(wall_normal);
+						velocity = up_direction * up_direction.dot(velocity) + slide_velocity.slide(up_direction);
+					} else {
+						velocity = velocity.slide(horizontal_normal);
+					}
+				}
+			}
+
+			// Stop horizontal motion when under wall slide threshold.
+			if (p_was_on_floor && wall_min_slide_angle > 0.0) {
+				real_t motion_angle = Math::abs(Math::acos(-horizontal_normal.dot(velocity_slide_up.normalized())));
+				if (motion_angle < wall_min_slide_angle) {
+					velocity = up_direction * velocity.dot(up_direction);
+					apply_default_sliding = false;
+				}
+			}
+		}
+
+		if (apply_default_sliding && result_state.ceiling && !apply_ceiling_velocity) {
+			if (slide_on_ceiling) {
+				// Apply slide only in the direction of the input motion, otherwise just stop to avoid jittering when moving against a wall.
+				if (vel_dir_facing_up) {
+					velocity = velocity.slide(ceiling_normal);
+				} else {
+					// Avoid acceleration in slope when falling.
+					velocity = up_direction * up_direction.dot(velocity);
+				}
+			} else if (vel_dir_facing_up) {
+				velocity = velocity.slide(up_direction);
+			}
+		}
+	}
+
+	// Reset the gravity accumulation when touching the ground.
+	if (collision_state.floor && !vel_dir_facing_up) {
+		velocity = velocity.slide(up_direction);
+	}
+
+	return true;
+}
+
 void CharacterBody3D::_move_and_slide_floating(double p_delta) {
 	Vector3 motion = velocity * p_delta;
 
@@ -791,6 +917,14 @@ void CharacterBody3D::set_max_slides(int p_max_slides) {
 	max_slides = p_max_slides;
 }
 
+bool CharacterBody3D::is_native_controller_enabled() const {
+	return native_controller;
+}
+
+void CharacterBody3D::set_native_controller_enabled(bool p_enabled) {
+	native_controller = p_enabled;
+}
+
 real_t CharacterBody3D::get_floor_max_angle() const {
 	return floor_max_angle;
 }
@@ -864,6 +998,8 @@ void CharacterBody3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_max_slides"), &CharacterBody3D::get_max_slides);
 	ClassDB::bind_method(D_METHOD("set_max_slides", "max_slides"), &CharacterBody3D::set_max_slides);
+	ClassDB::bind_method(D_METHOD("set_native_controller_enabled", "enabled"), &CharacterBody3D::set_native_controller_enabled);
+	ClassDB::bind_method(D_METHOD("is_native_controller_enabled"), &CharacterBody3D::is_native_controller_enabled);
 	ClassDB::bind_method(D_METHOD("get_floor_max_angle"), &CharacterBody3D::get_floor_max_angle);
 	ClassDB::bind_method(D_METHOD("set_floor_max_angle", "radians"), &CharacterBody3D::set_floor_max_angle);
 	ClassDB::bind_method(D_METHOD("get_floor_snap_length"), &CharacterBody3D::get_floor_snap_length);
@@ -901,6 +1037,7 @@ void CharacterBody3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::VECTOR3, "velocity", PROPERTY_HINT_NONE, "suffix:m/s", PROPERTY_USAGE_NO_EDITOR), "set_velocity", "get_velocity");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_slides", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR), "set_max_slides", "get_max_slides");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "wall_min_slide_angle", PROPERTY_HINT_RANGE, "0,180,0.1,radians_as_degrees", PROPERTY_USAGE_DEFAULT), "set_wall_min_slide_angle", "get_wall_min_slide_angle");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "native_controller"), "set_native_controller_enabled", "is_native_controller_enabled");
 
 	ADD_GROUP("Floor", "floor_");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "floor_stop_on_slope"), "set_floor_stop_on_slope_enabled", "is_floor_stop_on_slope_enabled");
@@ -927,7 +1064,7 @@ void CharacterBody3D::_bind_methods() {
 
 void CharacterBody3D::_validate_property(PropertyInfo &p_property) const {
 	if (motion_mode == MOTION_MODE_FLOATING) {
-		if (p_property.name.begins_with("floor_") || p_property.name == "up_direction" || p_property.name == "slide_on_ceiling") {
+		if (p_property.name.begins_with("floor_") || p_property.name == "up_direction" || p_property.name == "slide_on_ceiling" || p_property.name == "native_controller") {
 			p_property.usage = PROPERTY_USAGE_NO_EDITOR;
 		}
 	}
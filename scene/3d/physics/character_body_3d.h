@@ -91,6 +91,9 @@ public:
 	int get_max_slides() const;
 	void set_max_slides(int p_max_slides);
 
+	bool is_native_controller_enabled() const;
+	void set_native_controller_enabled(bool p_enabled);
+
 	real_t get_floor_max_angle() const;
 	void set_floor_max_angle(real_t p_radians);
 
@@ -141,6 +144,7 @@ private:
 	bool floor_stop_on_slope = true;
 	bool floor_block_on_wall = true;
 	bool slide_on_ceiling = true;
+	bool native_controller = false;
 	int max_slides = 6;
 	int platform_layer = 0;
 	RID platform_rid;
@@ -167,6 +171,7 @@ private:
 
 	void _move_and_slide_floating(double p_delta);
 	void _move_and_slide_grounded(double p_delta, bool p_was_on_floor);
+	bool _move_and_slide_native(double p_delta, bool p_was_on_floor);
 
 	Ref<KinematicCollision3D> _get_slide_collision(int p_bounce);
 	Ref<KinematicCollision3D> _get_last_slide_collision();
@@ -4561,6 +4561,9 @@ void Viewport::_bind_methods() {
 	BIND_ENUM_CONSTANT(RENDER_INFO_OBJECTS_IN_FRAME);
 	BIND_ENUM_CONSTANT(RENDER_INFO_PRIMITIVES_IN_FRAME);
 	BIND_ENUM_CONSTANT(RENDER_INFO_DRAW_CALLS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_INFO_CULL_TESTED_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_INFO_CULL_CACHED_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_INFO_SHADOW_LIGHTS_SKIPPED_IN_FRAME);
 	BIND_ENUM_CONSTANT(RENDER_INFO_MAX);
 
 	BIND_ENUM_CONSTANT(RENDER_INFO_TYPE_VISIBLE);
@@ -128,6 +128,9 @@ public:
 		RENDER_INFO_OBJECTS_IN_FRAME,
 		RENDER_INFO_PRIMITIVES_IN_FRAME,
 		RENDER_INFO_DRAW_CALLS_IN_FRAME,
+		RENDER_INFO_CULL_TESTED_IN_FRAME,
+		RENDER_INFO_CULL_CACHED_IN_FRAME,
+		RENDER_INFO_SHADOW_LIGHTS_SKIPPED_IN_FRAME,
 		RENDER_INFO_MAX
 	};
 
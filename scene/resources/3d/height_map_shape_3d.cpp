@@ -286,6 +286,47 @@ void HeightMapShape3D::update_map_data_from_image(const Ref<Image> &p_image, rea
 	emit_changed();
 }
 
+void HeightMapShape3D::update_map_data_region(const Rect2i &p_region, const Vector<real_t> &p_data) {
+	ERR_FAIL_COND_MSG(p_region.size.x <= 0 || p_region.size.y <= 0, "Heightmap update region must not be empty.");
+	ERR_FAIL_COND_MSG(!Rect2i(0, 0, map_width, map_depth).encloses(p_region), "Heightmap update region must lie within the heightmap.");
+	ERR_FAIL_COND_MSG(p_data.size() != p_region.size.x * p_region.size.y, "Heightmap update data size must be equal to the region's width multiplied by its depth.");
+
+	real_t *w = map_data.ptrw();
+	const real_t *r = p_data.ptr();
+
+	// Only scan the entire map again if one of the current extremes got overwritten.
+	bool recalculate_bounds = false;
+
+	for (int z = 0; z < p_region.size.y; z++) {
+		for (int x = 0; x < p_region.size.x; x++) {
+			const int index = (p_region.position.y + z) * map_width + (p_region.position.x + x);
+			const real_t old_val = w[index];
+			const real_t val = r[z * p_region.size.x + x];
+
+			if (old_val == min_height || old_val == max_height) {
+				recalculate_bounds = true;
+			}
+
+			w[index] = val;
+			min_height = MIN(min_height, val);
+			max_height = MAX(max_height, val);
+		}
+	}
+
+	if (recalculate_bounds) {
+		min_height = w[0];
+		max_height = w[0];
+
+		for (int i = 1; i < map_data.size(); i++) {
+			min_height = MIN(min_height, w[i]);
+			max_height = MAX(max_height, w[i]);
+		}
+	}
+
+	PhysicsServer3D::get_singleton()->heightmap_shape_update_region(get_shape(), p_region, p_data);
+	Shape3D::_update_shape();
+}
+
 void HeightMapShape3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_map_width", "width"), &HeightMapShape3D::set_map_width);
 	ClassDB::bind_method(D_METHOD("get_map_width"), &HeightMapShape3D::get_map_width);
@@ -297,6 +338,7 @@ void HeightMapShape3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_max_height"), &HeightMapShape3D::get_max_height);
 
 	ClassDB::bind_method(D_METHOD("update_map_data_from_image", "image", "height_min", "height_max"), &HeightMapShape3D::update_map_data_from_image);
+	ClassDB::bind_method(D_METHOD("update_map_data_region", "region", "data"), &HeightMapShape3D::update_map_data_region);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "map_width", PROPERTY_HINT_RANGE, "0.001,100,0.001,or_greater"), "set_map_width", "get_map_width");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "map_depth", PROPERTY_HINT_RANGE, "0.001,100,0.001,or_greater"), "set_map_depth", "get_map_depth");
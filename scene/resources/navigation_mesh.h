@@ -77,6 +77,7 @@ protected:
 	float cell_size = 0.25f; // Must match ProjectSettings default 3D cell_size and NavigationServer NavMap cell_size.
 	float cell_height = 0.25f; // Must match ProjectSettings default 3D cell_height and NavigationServer NavMap cell_height.
 	float border_size = 0.0f;
+	int tile_size = 0;
 	float agent_height = 1.5f;
 	float agent_radius = 0.5f;
 	float agent_max_climb = 0.25f;
@@ -131,6 +132,9 @@ public:
 	void set_border_size(float p_value);
 	float get_border_size() const;
 
+	void set_tile_size(int p_value);
+	int get_tile_size() const;
+
 	void set_agent_height(float p_value);
 	float get_agent_height() const;
 
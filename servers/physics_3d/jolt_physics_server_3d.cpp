@@ -36,6 +36,7 @@
 #include "joints/jolt_joint_3d.h"
 #include "joints/jolt_pin_joint_3d.h"
 #include "joints/jolt_slider_joint_3d.h"
+#include "jolt_project_settings.h"
 #include "objects/jolt_area_3d.h"
 #include "objects/jolt_body_3d.h"
 #include "objects/jolt_soft_body_3d.h"
@@ -52,6 +53,7 @@
 #include "spaces/jolt_job_system.h"
 #include "spaces/jolt_physics_direct_space_state_3d.h"
 #include "spaces/jolt_space_3d.h"
+#include "spaces/jolt_step_profiler.h"
 
 JoltPhysicsServer3D::JoltPhysicsServer3D(bool p_on_separate_thread) :
 		on_separate_thread(p_on_separate_thread) {
@@ -136,6 +138,20 @@ void JoltPhysicsServer3D::shape_set_data(RID p_shape, const Variant &p_data) {
 	ERR_FAIL_NULL(shape);
 
 	shape->set_data(p_data);
+
+	_track_building_shape(shape);
+}
+
+void JoltPhysicsServer3D::heightmap_shape_update_region(RID p_shape, const Rect2i &p_region, const Vector<real_t> &p_heights) {
+	JoltShape3D *shape = shape_owner.get_or_null(p_shape);
+	ERR_FAIL_NULL(shape);
+	ERR_FAIL_COND(shape->get_type() != SHAPE_HEIGHTMAP);
+
+	JoltHeightMapShape3D *heightmap_shape = static_cast<JoltHeightMapShape3D *>(shape);
+
+	if (heightmap_shape->update_region(p_region, p_heights)) {
+		pending_heightmap_shapes.insert(heightmap_shape);
+	}
 }
 
 Variant JoltPhysicsServer3D::shape_get_data(RID p_shape) const {
@@ -164,6 +180,8 @@ void JoltPhysicsServer3D::shape_set_margin(RID p_shape, real_t p_margin) {
 	ERR_FAIL_NULL(shape);
 
 	shape->set_margin((float)p_margin);
+
+	_track_building_shape(shape);
 }
 
 real_t JoltPhysicsServer3D::shape_get_margin(RID p_shape) const {
@@ -198,6 +216,8 @@ void JoltPhysicsServer3D::space_set_active(RID p_space, bool p_active) {
 	JoltSpace3D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL(space);
 
+	finish_pipelined_step();
+
 	if (p_active) {
 		space->set_active(true);
 		active_spaces.insert(space);
@@ -267,6 +287,27 @@ int JoltPhysicsServer3D::space_get_contact_count(RID p_space) const {
 #endif
 }
 
+PackedByteArray JoltPhysicsServer3D::space_save_state(RID p_space, const PackedByteArray &p_previous_state) const {
+	JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+
+	return space->save_state(p_previous_state);
+}
+
+double JoltPhysicsServer3D::space_get_step_time(RID p_space) const {
+	const JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0.0);
+
+	return USEC_TO_SEC(space->get_step_time());
+}
+
+bool JoltPhysicsServer3D::space_restore_state(RID p_space, const PackedByteArray &p_state, const PackedByteArray &p_previous_state) {
+	JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+
+	return space->restore_state(p_state, p_previous_state);
+}
+
 RID JoltPhysicsServer3D::area_create() {
 	JoltArea3D *area = memnew(JoltArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -492,6 +533,13 @@ void JoltPhysicsServer3D::area_set_area_monitor_callback(RID p_area, const Calla
 	area->set_area_monitor_callback(p_callback);
 }
 
+void JoltPhysicsServer3D::area_set_monitor_batching(RID p_area, bool p_enable) {
+	JoltArea3D *area = area_owner.get_or_null(p_area);
+	ERR_FAIL_NULL(area);
+
+	area->set_monitor_batching(p_enable);
+}
+
 void JoltPhysicsServer3D::area_set_ray_pickable(RID p_area, bool p_enable) {
 	JoltArea3D *area = area_owner.get_or_null(p_area);
 	ERR_FAIL_NULL(area);
@@ -500,12 +548,75 @@ void JoltPhysicsServer3D::area_set_ray_pickable(RID p_area, bool p_enable) {
 }
 
 RID JoltPhysicsServer3D::body_create() {
-	JoltBody3D *body = memnew(JoltBody3D);
+	JoltBody3D *body = nullptr;
+
+	{
+		MutexLock lock(body_pool_mutex);
+
+		if (!body_pool.is_empty()) {
+			body = body_pool[body_pool.size() - 1];
+			body_pool.remove_at(body_pool.size() - 1);
+		}
+	}
+
+	if (body != nullptr) {
+		body = memnew_placement(body, JoltBody3D);
+	} else {
+		body = memnew(JoltBody3D);
+	}
+
 	RID rid = body_owner.make_rid(body);
 	body->set_rid(rid);
 	return rid;
 }
 
+Vector<RID> JoltPhysicsServer3D::body_create_batch(RID p_space, BodyMode p_mode, RID p_shape, const Vector<Transform3D> &p_transforms, uint32_t p_collision_layer, uint32_t p_collision_mask) {
+	JoltSpace3D *space = nullptr;
+
+	if (p_space.is_valid()) {
+		space = space_owner.get_or_null(p_space);
+		ERR_FAIL_NULL_V(space, Vector<RID>());
+	}
+
+	JoltShape3D *shape = nullptr;
+
+	if (p_shape.is_valid()) {
+		shape = shape_owner.get_or_null(p_shape);
+		ERR_FAIL_NULL_V(shape, Vector<RID>());
+	}
+
+	Vector<RID> rids;
+	rids.resize(p_transforms.size());
+
+	if (space != nullptr) {
+		space->begin_body_batch();
+	}
+
+	for (int i = 0; i < p_transforms.size(); ++i) {
+		const RID rid = body_create();
+		JoltBody3D *body = body_owner.get_or_null(rid);
+
+		body->set_mode(p_mode);
+
+		if (shape != nullptr) {
+			body->add_shape(shape, Transform3D(), false);
+		}
+
+		body->set_collision_layer(p_collision_layer);
+		body->set_collision_mask(p_collision_mask);
+		body->set_transform(p_transforms[i]);
+		body->set_space(space);
+
+		rids.write[i] = rid;
+	}
+
+	if (space != nullptr) {
+		space->end_body_batch();
+	}
+
+	return rids;
+}
+
 void JoltPhysicsServer3D::body_set_space(RID p_body, RID p_space) {
 	JoltBody3D *body = body_owner.get_or_null(p_body);
 	ERR_FAIL_NULL(body);
@@ -937,6 +1048,23 @@ bool JoltPhysicsServer3D::body_test_motion(RID p_body, const MotionParameters &p
 	return space->get_direct_state()->body_test_motion(*body, p_parameters, r_result);
 }
 
+bool JoltPhysicsServer3D::body_move_character(RID p_body, const CharacterMotionParameters &p_parameters, CharacterMotionResult *r_result) {
+	JoltBody3D *body = body_owner.get_or_null(p_body);
+	ERR_FAIL_NULL_V(body, false);
+
+	JoltSpace3D *space = body->get_space();
+	ERR_FAIL_NULL_V(space, false);
+
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "body_move_character (maybe from move_and_slide?) must not be called while the physics space is being stepped.");
+
+	// Other threads block on any pipelined step when accessing the body, but only the main thread may optimize the space.
+	if (Thread::is_main_thread()) {
+		space->try_optimize();
+	}
+
+	return body->move_character(p_parameters, r_result);
+}
+
 PhysicsDirectBodyState3D *JoltPhysicsServer3D::body_get_direct_state(RID p_body) {
 	ERR_FAIL_COND_V_MSG((on_separate_thread && !doing_sync), nullptr, "Body state is inaccessible right now, wait for iteration or physics process notification.");
 
@@ -1565,6 +1693,14 @@ void JoltPhysicsServer3D::init() {
 }
 
 void JoltPhysicsServer3D::finish() {
+	finish_pipelined_step();
+
+	for (JoltBody3D *body : body_pool) {
+		Memory::free_static(body, false); // Already destroyed when pooled.
+	}
+
+	body_pool.clear();
+
 	if (job_system != nullptr) {
 		delete job_system;
 		job_system = nullptr;
@@ -1576,16 +1712,144 @@ void JoltPhysicsServer3D::step(real_t p_step) {
 		return;
 	}
 
+	finish_pipelined_step();
+
+	for (JoltHeightMapShape3D *heightmap_shape : pending_heightmap_shapes) {
+		heightmap_shape->flush_tile_updates();
+	}
+
+	pending_heightmap_shapes.clear();
+
+	_finish_building_shapes();
+
 	for (JoltSpace3D *active_space : active_spaces) {
-		job_system->pre_step();
+		if (active_space->is_step_pipelined()) {
+			pipelined_spaces.push_back(active_space);
+		} else {
+			stepping_spaces.push_back(active_space);
+		}
+	}
+
+	// Spaces that aren't pipelined are stepped first, since all spaces share the same job system.
+	for (JoltSpace3D *space : stepping_spaces) {
+		space->begin_step((float)p_step);
+	}
+
+	_update_spaces(stepping_spaces);
+
+	for (JoltSpace3D *space : stepping_spaces) {
+		space->end_step();
+	}
+
+	stepping_spaces.clear();
+
+	if (pipelined_spaces.is_empty()) {
+		return;
+	}
+
+	// Mark the update as running before any space reports it as pending, so other threads never miss it.
+	{
+		MutexLock lock(pipelined_mutex);
+		pipelined_update_running = true;
+	}
 
-		active_space->step((float)p_step);
+	pipelined_thread_id.set(Thread::get_caller_id());
 
-		job_system->post_step();
+	for (JoltSpace3D *space : pipelined_spaces) {
+		space->begin_step((float)p_step);
 	}
+
+	pipelined_task_id = WorkerThreadPool::get_singleton()->add_native_task(&_pipelined_step_task, this, true, SNAME("JoltPhysicsStep"));
+}
+
+void JoltPhysicsServer3D::_pipelined_step_task(void *p_userdata) {
+	JoltPhysicsServer3D *server = static_cast<JoltPhysicsServer3D *>(p_userdata);
+
+	server->_update_spaces(server->pipelined_spaces);
+
+	MutexLock lock(server->pipelined_mutex);
+	server->pipelined_update_running = false;
+	server->pipelined_condition.notify_all();
+}
+
+void JoltPhysicsServer3D::_update_space_task(void *p_userdata, uint32_t p_index) {
+	const LocalVector<JoltSpace3D *> &spaces = *static_cast<const LocalVector<JoltSpace3D *> *>(p_userdata);
+
+	spaces[p_index]->update();
+}
+
+void JoltPhysicsServer3D::_update_spaces(const LocalVector<JoltSpace3D *> &p_spaces) {
+	if (p_spaces.is_empty()) {
+		return;
+	}
+
+	job_system->pre_step();
+
+	const int parallel_count = MIN(MIN(JoltProjectSettings::get_max_parallel_spaces(), JoltJobSystem::MAX_PARALLEL_STEPS), (int)p_spaces.size());
+
+	if (parallel_count > 1) {
+		// Only the updates themselves run in parallel, since they don't touch anything outside of their own space. They
+		// also share the job system, so the combined work is still spread across the same worker threads.
+		WorkerThreadPool *thread_pool = WorkerThreadPool::get_singleton();
+		const WorkerThreadPool::GroupID group_id = thread_pool->add_native_group_task(&_update_space_task, (void *)&p_spaces, (int)p_spaces.size(), parallel_count, true, SNAME("JoltPhysicsSpaces"));
+		thread_pool->wait_for_group_task_completion(group_id);
+	} else {
+		for (JoltSpace3D *space : p_spaces) {
+			space->update();
+		}
+	}
+
+	job_system->post_step();
+}
+
+void JoltPhysicsServer3D::_track_building_shape(JoltShape3D *p_shape) {
+	if (p_shape->is_building() && !building_shapes.has(p_shape)) {
+		building_shapes.push_back(p_shape);
+	}
+}
+
+void JoltPhysicsServer3D::_finish_building_shapes() {
+	for (uint32_t i = 0; i < building_shapes.size();) {
+		if (building_shapes[i]->finish_building()) {
+			building_shapes.remove_at_unordered(i);
+		} else {
+			++i;
+		}
+	}
+}
+
+void JoltPhysicsServer3D::finish_pipelined_step() {
+	// Only the thread that started the step may complete it, since that writes to the spaces. Any other thread still
+	// has to wait for the update itself, so that it doesn't access bodies while the physics system is using them.
+	if (pipelined_thread_id.get() != Thread::get_caller_id()) {
+		MutexLock lock(pipelined_mutex);
+
+		while (pipelined_update_running) {
+			pipelined_condition.wait(lock);
+		}
+
+		return;
+	}
+
+	if (pipelined_task_id == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(pipelined_task_id);
+
+	pipelined_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	pipelined_thread_id.set(Thread::UNASSIGNED_ID);
+
+	for (JoltSpace3D *space : pipelined_spaces) {
+		space->end_step();
+	}
+
+	pipelined_spaces.clear();
 }
 
 void JoltPhysicsServer3D::sync() {
+	finish_pipelined_step();
+
 	doing_sync = true;
 }
 
@@ -1600,12 +1864,18 @@ void JoltPhysicsServer3D::flush_queries() {
 
 	flushing_queries = true;
 
+	const uint64_t queries_start = JoltStepProfiler::get_ticks();
+
 	for (JoltSpace3D *space : active_spaces) {
 		space->call_queries();
 	}
 
+	JoltStepProfiler::add_time_since(JoltStepProfiler::STAGE_CALL_QUERIES, queries_start);
+
 	flushing_queries = false;
 
+	JoltStepProfiler::flush();
+
 #ifdef DEBUG_ENABLED
 	job_system->flush_timings();
 #endif
@@ -1616,7 +1886,29 @@ bool JoltPhysicsServer3D::is_flushing_queries() const {
 }
 
 int JoltPhysicsServer3D::get_process_info(ProcessInfo p_process_info) {
-	return 0;
+	switch (p_process_info) {
+		case INFO_BROADPHASE_TIME: {
+			return (int)JoltStepProfiler::get_last_time(JoltStepProfiler::STAGE_BROADPHASE);
+		}
+		case INFO_NARROWPHASE_TIME: {
+			return (int)JoltStepProfiler::get_last_time(JoltStepProfiler::STAGE_NARROWPHASE);
+		}
+		case INFO_SOLVER_TIME: {
+			return (int)JoltStepProfiler::get_last_time(JoltStepProfiler::STAGE_SOLVER);
+		}
+		case INFO_CONTACT_CALLBACKS_TIME: {
+			return (int)JoltStepProfiler::get_last_time(JoltStepProfiler::STAGE_CONTACT_CALLBACKS);
+		}
+		case INFO_AREA_OVERLAPS_TIME: {
+			return (int)JoltStepProfiler::get_last_time(JoltStepProfiler::STAGE_AREA_OVERLAPS);
+		}
+		case INFO_CALL_QUERIES_TIME: {
+			return (int)JoltStepProfiler::get_last_time(JoltStepProfiler::STAGE_CALL_QUERIES);
+		}
+		default: {
+			return 0;
+		}
+	}
 }
 
 void JoltPhysicsServer3D::free_space(JoltSpace3D *p_space) {
@@ -1641,7 +1933,19 @@ void JoltPhysicsServer3D::free_body(JoltBody3D *p_body) {
 
 	p_body->set_space(nullptr);
 	body_owner.free(p_body->get_rid());
-	memdelete(p_body);
+
+	p_body->~JoltBody3D();
+
+	{
+		MutexLock lock(body_pool_mutex);
+
+		if ((int)body_pool.size() < JoltProjectSettings::get_body_pool_size()) {
+			body_pool.push_back(p_body);
+			return;
+		}
+	}
+
+	Memory::free_static(p_body, false);
 }
 
 void JoltPhysicsServer3D::free_soft_body(JoltSoftBody3D *p_body) {
@@ -1655,6 +1959,13 @@ void JoltPhysicsServer3D::free_soft_body(JoltSoftBody3D *p_body) {
 void JoltPhysicsServer3D::free_shape(JoltShape3D *p_shape) {
 	ERR_FAIL_NULL(p_shape);
 
+	if (p_shape->get_type() == SHAPE_HEIGHTMAP) {
+		pending_heightmap_shapes.erase(static_cast<JoltHeightMapShape3D *>(p_shape));
+	}
+
+	p_shape->wait_for_build();
+	building_shapes.erase(p_shape);
+
 	p_shape->remove_self();
 	shape_owner.free(p_shape->get_rid());
 	memdelete(p_shape);
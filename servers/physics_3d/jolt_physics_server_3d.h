@@ -31,11 +31,18 @@
 #ifndef JOLT_PHYSICS_SERVER_3D_H
 #define JOLT_PHYSICS_SERVER_3D_H
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
 #include "servers/physics_server_3d.h"
 
 class JoltArea3D;
 class JoltBody3D;
+class JoltHeightMapShape3D;
 class JoltJobSystem;
 class JoltJoint3D;
 class JoltShape3D;
@@ -55,14 +62,35 @@ class JoltPhysicsServer3D final : public PhysicsServer3D {
 	mutable RID_PtrOwner<JoltJoint3D> joint_owner;
 
 	HashSet<JoltSpace3D *> active_spaces;
+	HashSet<JoltHeightMapShape3D *> pending_heightmap_shapes;
+	LocalVector<JoltShape3D *> building_shapes;
+	// Bodies are created on the calling thread but freed on the server thread when running on a separate thread.
+	LocalVector<JoltBody3D *> body_pool;
+	BinaryMutex body_pool_mutex;
 
 	JoltJobSystem *job_system = nullptr;
 
+	LocalVector<JoltSpace3D *> stepping_spaces;
+	LocalVector<JoltSpace3D *> pipelined_spaces;
+	WorkerThreadPool::TaskID pipelined_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	SafeNumeric<Thread::ID> pipelined_thread_id;
+	BinaryMutex pipelined_mutex;
+	ConditionVariable pipelined_condition;
+	bool pipelined_update_running = false;
+
 	bool on_separate_thread = false;
 	bool active = true;
 	bool flushing_queries = false;
 	bool doing_sync = false;
 
+	static void _pipelined_step_task(void *p_userdata);
+	static void _update_space_task(void *p_userdata, uint32_t p_index);
+
+	void _update_spaces(const LocalVector<JoltSpace3D *> &p_spaces);
+
+	void _track_building_shape(JoltShape3D *p_shape);
+	void _finish_building_shapes();
+
 public:
 	enum HingeJointParamJolt {
 		HINGE_JOINT_LIMIT_SPRING_FREQUENCY = 100,
@@ -140,6 +168,8 @@ public:
 	virtual void shape_set_data(RID p_shape, const Variant &p_data) override;
 	virtual Variant shape_get_data(RID p_shape) const override;
 
+	virtual void heightmap_shape_update_region(RID p_shape, const Rect2i &p_region, const Vector<real_t> &p_heights) override;
+
 	virtual void shape_set_custom_solver_bias(RID p_shape, real_t p_bias) override;
 
 	virtual void shape_set_margin(RID p_shape, real_t p_margin) override;
@@ -163,6 +193,11 @@ public:
 	virtual PackedVector3Array space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual PackedByteArray space_save_state(RID p_space, const PackedByteArray &p_previous_state = PackedByteArray()) const override;
+	virtual bool space_restore_state(RID p_space, const PackedByteArray &p_state, const PackedByteArray &p_previous_state = PackedByteArray()) override;
+
+	virtual double space_get_step_time(RID p_space) const override;
+
 	virtual RID area_create() override;
 
 	virtual void area_set_space(RID p_area, RID p_space) override;
@@ -204,8 +239,10 @@ public:
 
 	virtual void area_set_monitor_callback(RID p_area, const Callable &p_callback) override;
 	virtual void area_set_area_monitor_callback(RID p_area, const Callable &p_callback) override;
+	virtual void area_set_monitor_batching(RID p_area, bool p_enable) override;
 
 	virtual RID body_create() override;
+	virtual Vector<RID> body_create_batch(RID p_space, BodyMode p_mode, RID p_shape, const Vector<Transform3D> &p_transforms, uint32_t p_collision_layer, uint32_t p_collision_mask) override;
 
 	virtual void body_set_space(RID p_body, RID p_space) override;
 	virtual RID body_get_space(RID p_body) const override;
@@ -296,6 +333,7 @@ public:
 	virtual void body_set_ray_pickable(RID p_body, bool p_enable) override;
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result) override;
+	virtual bool body_move_character(RID p_body, const CharacterMotionParameters &p_parameters, CharacterMotionResult *r_result) override;
 
 	virtual PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override;
 
@@ -423,6 +461,8 @@ public:
 
 	bool is_active() const { return active; }
 
+	void finish_pipelined_step();
+
 	void free_space(JoltSpace3D *p_space);
 	void free_area(JoltArea3D *p_area);
 	void free_body(JoltBody3D *p_body);
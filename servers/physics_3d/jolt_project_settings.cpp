@@ -39,6 +39,11 @@ enum JoltJointWorldNode : int {
 	JOLT_JOINT_WORLD_NODE_B,
 };
 
+enum JoltJobSystemMode : int {
+	JOLT_JOB_SYSTEM_WORKER_THREAD_POOL,
+	JOLT_JOB_SYSTEM_DEDICATED_THREADS,
+};
+
 } // namespace
 
 void JoltProjectSettings::register_settings() {
@@ -70,9 +75,17 @@ void JoltProjectSettings::register_settings() {
 
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/jolt_physics_3d/collisions/collision_margin_fraction", PROPERTY_HINT_RANGE, U"0,1,0.00001"), 0.08f);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/jolt_physics_3d/collisions/active_edge_threshold", PROPERTY_HINT_RANGE, U"0,90,0.01,radians_as_degrees"), Math::deg_to_rad(50.0f));
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/collisions/heightmap_tile_size", PROPERTY_HINT_RANGE, U"0,1024,1,or_greater"), 0);
+	GLOBAL_DEF(PropertyInfo(Variant::BOOL, "physics/jolt_physics_3d/collisions/shape_cache"), false);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "physics/jolt_physics_3d/collisions/shape_cache_path", PROPERTY_HINT_GLOBAL_DIR), "");
 
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/joints/world_node", PROPERTY_HINT_ENUM, U"Node A,Node B"), JOLT_JOINT_WORLD_NODE_A);
 
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/threading/job_system", PROPERTY_HINT_ENUM, U"Worker Thread Pool,Dedicated Threads"), JOLT_JOB_SYSTEM_WORKER_THREAD_POOL);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::BOOL, "physics/jolt_physics_3d/threading/pipelined_step"), false);
+	GLOBAL_DEF(PropertyInfo(Variant::BOOL, "physics/jolt_physics_3d/threading/background_shape_building"), false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/threading/max_parallel_spaces", PROPERTY_HINT_RANGE, U"1,8,1"), 4);
+
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/limits/temporary_memory_buffer_size", PROPERTY_HINT_RANGE, U"1,32,or_greater,suffix:MiB"), 32);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "physics/jolt_physics_3d/limits/world_boundary_shape_size", PROPERTY_HINT_RANGE, U"2,2000,0.1,or_greater,suffix:m"), 2000.0f);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/jolt_physics_3d/limits/max_linear_velocity", PROPERTY_HINT_RANGE, U"0,500,0.01,or_greater,suffix:m/s"), 500.0f);
@@ -80,6 +93,7 @@ void JoltProjectSettings::register_settings() {
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/limits/max_bodies", PROPERTY_HINT_RANGE, U"1,10240,or_greater"), 10240);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/limits/max_body_pairs", PROPERTY_HINT_RANGE, U"8,65536,or_greater"), 65536);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/limits/max_contact_constraints", PROPERTY_HINT_RANGE, U"8,20480,or_greater"), 20480);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/limits/body_pool_size", PROPERTY_HINT_RANGE, U"0,1024,or_greater"), 1024);
 }
 
 int JoltProjectSettings::get_simulation_velocity_steps() {
@@ -190,10 +204,41 @@ float JoltProjectSettings::get_active_edge_threshold() {
 	return value;
 }
 
+int JoltProjectSettings::get_heightmap_tile_size() {
+	// Smaller tiles would hold fewer than two blocks of the height field, which Jolt can't build.
+	static const int value = GLOBAL_GET("physics/jolt_physics_3d/collisions/heightmap_tile_size");
+	return value > 0 ? MAX(value, 4) : 0;
+}
+
+bool JoltProjectSettings::use_shape_cache() {
+	return GLOBAL_GET("physics/jolt_physics_3d/collisions/shape_cache");
+}
+
+String JoltProjectSettings::get_shape_cache_path() {
+	return GLOBAL_GET("physics/jolt_physics_3d/collisions/shape_cache_path");
+}
+
 bool JoltProjectSettings::use_joint_world_node_a() {
 	return (int)GLOBAL_GET("physics/jolt_physics_3d/joints/world_node") == JOLT_JOINT_WORLD_NODE_A;
 }
 
+bool JoltProjectSettings::use_dedicated_job_threads() {
+	return (int)GLOBAL_GET("physics/jolt_physics_3d/threading/job_system") == JOLT_JOB_SYSTEM_DEDICATED_THREADS;
+}
+
+bool JoltProjectSettings::use_pipelined_step() {
+	return GLOBAL_GET("physics/jolt_physics_3d/threading/pipelined_step");
+}
+
+bool JoltProjectSettings::build_shapes_in_background() {
+	return GLOBAL_GET("physics/jolt_physics_3d/threading/background_shape_building");
+}
+
+int JoltProjectSettings::get_max_parallel_spaces() {
+	static const int value = MAX(1, (int)GLOBAL_GET("physics/jolt_physics_3d/threading/max_parallel_spaces"));
+	return value;
+}
+
 int JoltProjectSettings::get_temp_memory_mib() {
 	return GLOBAL_GET("physics/jolt_physics_3d/limits/temporary_memory_buffer_size");
 }
@@ -225,3 +270,8 @@ int JoltProjectSettings::get_max_pairs() {
 int JoltProjectSettings::get_max_contact_constraints() {
 	return GLOBAL_GET("physics/jolt_physics_3d/limits/max_contact_constraints");
 }
+
+int JoltProjectSettings::get_body_pool_size() {
+	static const int value = MAX((int)GLOBAL_GET("physics/jolt_physics_3d/limits/body_pool_size"), 0);
+	return value;
+}
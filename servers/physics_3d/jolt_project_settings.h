@@ -31,6 +31,8 @@
 #ifndef JOLT_PROJECT_SETTINGS_H
 #define JOLT_PROJECT_SETTINGS_H
 
+#include "core/string/ustring.h"
+
 #include <stdint.h>
 
 class JoltProjectSettings {
@@ -65,9 +67,17 @@ public:
 
 	static float get_collision_margin_fraction();
 	static float get_active_edge_threshold();
+	static int get_heightmap_tile_size();
+	static bool use_shape_cache();
+	static String get_shape_cache_path();
 
 	static bool use_joint_world_node_a();
 
+	static bool use_dedicated_job_threads();
+	static bool use_pipelined_step();
+	static bool build_shapes_in_background();
+	static int get_max_parallel_spaces();
+
 	static int get_temp_memory_mib();
 	static int64_t get_temp_memory_b();
 	static float get_world_boundary_shape_size();
@@ -76,6 +86,7 @@ public:
 	static int get_max_bodies();
 	static int get_max_pairs();
 	static int get_max_contact_constraints();
+	static int get_body_pool_size();
 };
 
 #endif // JOLT_PROJECT_SETTINGS_H
@@ -0,0 +1,75 @@
+/**************************************************************************/
+/*  jolt_state_recorder.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JOLT_STATE_RECORDER_H
+#define JOLT_STATE_RECORDER_H
+
+#include "core/templates/local_vector.h"
+
+#include "Jolt/Jolt.h"
+
+#include "Jolt/Physics/StateRecorder.h"
+
+class JoltStateRecorder final : public JPH::StateRecorder {
+	LocalVector<uint8_t> buffer;
+	uint32_t read_position = 0;
+	bool failed = false;
+
+public:
+	virtual void WriteBytes(const void *p_data, size_t p_bytes) override {
+		const uint32_t offset = buffer.size();
+		buffer.resize(offset + (uint32_t)p_bytes);
+		memcpy(buffer.ptr() + offset, p_data, p_bytes);
+	}
+
+	virtual void ReadBytes(void *p_data, size_t p_bytes) override {
+		if (unlikely(failed || read_position + p_bytes > buffer.size())) {
+			memset(p_data, 0, p_bytes);
+			failed = true;
+			return;
+		}
+
+		memcpy(p_data, buffer.ptr() + read_position, p_bytes);
+		read_position += (uint32_t)p_bytes;
+	}
+
+	virtual bool IsEOF() const override {
+		return read_position >= buffer.size();
+	}
+
+	virtual bool IsFailed() const override {
+		return failed;
+	}
+
+	LocalVector<uint8_t> &get_buffer() { return buffer; }
+	const LocalVector<uint8_t> &get_buffer() const { return buffer; }
+};
+
+#endif // JOLT_STATE_RECORDER_H
@@ -31,8 +31,6 @@
 #ifndef JOLT_STREAM_WRAPPERS_H
 #define JOLT_STREAM_WRAPPERS_H
 
-#ifdef DEBUG_ENABLED
-
 #include "core/io/file_access.h"
 
 #include "Jolt/Jolt.h"
@@ -76,6 +74,4 @@ public:
 	}
 };
 
-#endif
-
 #endif // JOLT_STREAM_WRAPPERS_H
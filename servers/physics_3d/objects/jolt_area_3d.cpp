@@ -120,10 +120,14 @@ bool JoltArea3D::_remove_shape_pair(Overlap &p_overlap, const JPH::SubShapeID &p
 }
 
 void JoltArea3D::_flush_events(OverlapsById &p_objects, const Callable &p_callback) {
+	if (monitor_batching && p_callback.is_valid()) {
+		_report_events_batched(p_callback, p_objects);
+	}
+
 	for (OverlapsById::Iterator E = p_objects.begin(); E;) {
 		Overlap &overlap = E->value;
 
-		if (p_callback.is_valid()) {
+		if (!monitor_batching && p_callback.is_valid()) {
 			for (ShapeIndexPair &shape_indices : overlap.pending_removed) {
 				_report_event(p_callback, PhysicsServer3D::AREA_BODY_REMOVED, overlap.rid, overlap.instance_id, shape_indices.other, shape_indices.self);
 			}
@@ -166,6 +170,74 @@ void JoltArea3D::_report_event(const Callable &p_callback, PhysicsServer3D::Area
 	}
 }
 
+void JoltArea3D::_report_events_batched(const Callable &p_callback, const OverlapsById &p_objects) const {
+	ERR_FAIL_COND(!p_callback.is_valid());
+
+	int event_count = 0;
+
+	for (const KeyValue<JPH::BodyID, Overlap> &E : p_objects) {
+		event_count += (int)E.value.pending_removed.size() + (int)E.value.pending_added.size();
+	}
+
+	if (event_count == 0) {
+		return;
+	}
+
+	PackedInt32Array statuses;
+	Array other_rids;
+	PackedInt64Array other_instance_ids;
+	PackedInt32Array other_shape_indices;
+	PackedInt32Array self_shape_indices;
+
+	statuses.resize(event_count);
+	other_rids.resize(event_count);
+	other_instance_ids.resize(event_count);
+	other_shape_indices.resize(event_count);
+	self_shape_indices.resize(event_count);
+
+	int32_t *statuses_ptr = statuses.ptrw();
+	int64_t *other_instance_ids_ptr = other_instance_ids.ptrw();
+	int32_t *other_shape_indices_ptr = other_shape_indices.ptrw();
+	int32_t *self_shape_indices_ptr = self_shape_indices.ptrw();
+
+	int event_index = 0;
+
+	const auto add_events = [&](const Overlap &p_overlap, const LocalVector<ShapeIndexPair> &p_shape_pairs, PhysicsServer3D::AreaBodyStatus p_status) {
+		for (const ShapeIndexPair &shape_indices : p_shape_pairs) {
+			statuses_ptr[event_index] = p_status;
+			other_rids[event_index] = p_overlap.rid;
+			other_instance_ids_ptr[event_index] = (int64_t)p_overlap.instance_id;
+			other_shape_indices_ptr[event_index] = shape_indices.other;
+			self_shape_indices_ptr[event_index] = shape_indices.self;
+			event_index++;
+		}
+	};
+
+	// Removals are reported before additions, same as when reporting the events one by one.
+	for (const KeyValue<JPH::BodyID, Overlap> &E : p_objects) {
+		add_events(E.value, E.value.pending_removed, PhysicsServer3D::AREA_BODY_REMOVED);
+	}
+
+	for (const KeyValue<JPH::BodyID, Overlap> &E : p_objects) {
+		add_events(E.value, E.value.pending_added, PhysicsServer3D::AREA_BODY_ADDED);
+	}
+
+	const Variant arg1 = statuses;
+	const Variant arg2 = other_rids;
+	const Variant arg3 = other_instance_ids;
+	const Variant arg4 = other_shape_indices;
+	const Variant arg5 = self_shape_indices;
+	const Variant *args[5] = { &arg1, &arg2, &arg3, &arg4, &arg5 };
+
+	Callable::CallError ce;
+	Variant ret;
+	p_callback.callp(args, 5, ret, ce);
+
+	if (unlikely(ce.error != Callable::CallError::CALL_OK)) {
+		ERR_PRINT_ONCE(vformat("Failed to call batched area monitor callback for '%s'. It returned the following error: '%s'.", to_string(), Variant::get_callable_error_text(p_callback, args, 5, ce)));
+	}
+}
+
 void JoltArea3D::_notify_body_entered(const JPH::BodyID &p_body_id) {
 	const JoltReadableBody3D jolt_body = space->read_body(p_body_id);
 
@@ -108,6 +108,7 @@ private:
 	OverrideMode angular_damp_mode = PhysicsServer3D::AREA_SPACE_OVERRIDE_DISABLED;
 
 	bool monitorable = false;
+	bool monitor_batching = false;
 	bool point_gravity = false;
 
 	virtual JPH::BroadPhaseLayer _get_broad_phase_layer() const override;
@@ -123,6 +124,7 @@ private:
 	void _flush_events(OverlapsById &p_objects, const Callable &p_callback);
 
 	void _report_event(const Callable &p_callback, PhysicsServer3D::AreaBodyStatus p_status, const RID &p_other_rid, ObjectID p_other_instance_id, int p_other_shape_index, int p_self_shape_index) const;
+	void _report_events_batched(const Callable &p_callback, const OverlapsById &p_objects) const;
 
 	void _notify_body_entered(const JPH::BodyID &p_body_id);
 	void _notify_body_exited(const JPH::BodyID &p_body_id);
@@ -160,6 +162,9 @@ public:
 	bool has_area_monitor_callback() const { return area_monitor_callback.is_valid(); }
 	void set_area_monitor_callback(const Callable &p_callback);
 
+	bool is_monitor_batching() const { return monitor_batching; }
+	void set_monitor_batching(bool p_enabled) { monitor_batching = p_enabled; }
+
 	bool is_monitorable() const { return monitorable; }
 	void set_monitorable(bool p_monitorable);
 
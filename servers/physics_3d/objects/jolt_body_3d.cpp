@@ -37,6 +37,7 @@
 #include "../spaces/jolt_broad_phase_layer.h"
 #include "../spaces/jolt_space_3d.h"
 #include "jolt_area_3d.h"
+#include "jolt_character_3d.h"
 #include "jolt_group_filter.h"
 #include "jolt_physics_direct_body_state_3d.h"
 #include "jolt_soft_body_3d.h"
@@ -434,6 +435,13 @@ void JoltBody3D::_destroy_joint_constraints() {
 	}
 }
 
+void JoltBody3D::_destroy_character() {
+	if (character != nullptr) {
+		memdelete(character);
+		character = nullptr;
+	}
+}
+
 void JoltBody3D::_exit_all_areas() {
 	for (JoltArea3D *area : areas) {
 		area->body_exited(jolt_id, false);
@@ -477,6 +485,7 @@ void JoltBody3D::_space_changing() {
 	sleep_initially = is_sleeping();
 
 	_destroy_joint_constraints();
+	_destroy_character();
 	_exit_all_areas();
 }
 
@@ -531,6 +540,8 @@ JoltBody3D::~JoltBody3D() {
 		memdelete(direct_state);
 		direct_state = nullptr;
 	}
+
+	_destroy_character();
 }
 
 void JoltBody3D::set_transform(Transform3D p_transform) {
@@ -1223,6 +1234,15 @@ void JoltBody3D::call_queries(JPH::Body &p_jolt_body) {
 }
 
 void JoltBody3D::pre_step(float p_step, JPH::Body &p_jolt_body) {
+	if (space->is_step_pipelined()) {
+		committed_state.transform = Transform3D(to_godot(p_jolt_body.GetRotation()), to_godot(p_jolt_body.GetPosition())).scaled_local(scale);
+		committed_state.center_of_mass = to_godot(p_jolt_body.GetCenterOfMassPosition() - p_jolt_body.GetPosition());
+		committed_state.linear_velocity = to_godot(p_jolt_body.GetLinearVelocity());
+		committed_state.angular_velocity = to_godot(p_jolt_body.GetAngularVelocity());
+		committed_state.contact_count = contact_count;
+		committed_state.sleeping = !p_jolt_body.IsActive();
+	}
+
 	JoltObject3D::pre_step(p_step, p_jolt_body);
 
 	switch (mode) {
@@ -1241,6 +1261,14 @@ void JoltBody3D::pre_step(float p_step, JPH::Body &p_jolt_body) {
 	contact_count = 0;
 }
 
+const JoltBody3D::CommittedState *JoltBody3D::get_committed_state() const {
+	if (space == nullptr || !space->is_update_pending()) {
+		return nullptr;
+	}
+
+	return &committed_state;
+}
+
 JoltPhysicsDirectBodyState3D *JoltBody3D::get_direct_state() {
 	if (direct_state == nullptr) {
 		direct_state = memnew(JoltPhysicsDirectBodyState3D(this));
@@ -1249,6 +1277,16 @@ JoltPhysicsDirectBodyState3D *JoltBody3D::get_direct_state() {
 	return direct_state;
 }
 
+bool JoltBody3D::move_character(const PhysicsServer3D::CharacterMotionParameters &p_parameters, PhysicsServer3D::CharacterMotionResult *r_result) {
+	ERR_FAIL_COND_V_MSG(!is_kinematic(), false, vformat("Failed to move character '%s'. Only kinematic bodies can be moved as characters.", to_string()));
+
+	if (character == nullptr) {
+		character = memnew(JoltCharacter3D(*this));
+	}
+
+	return character->move(p_parameters, r_result);
+}
+
 void JoltBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 	if (p_mode == mode) {
 		return;
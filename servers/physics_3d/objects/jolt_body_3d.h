@@ -35,6 +35,7 @@
 #include "jolt_shaped_object_3d.h"
 
 class JoltArea3D;
+class JoltCharacter3D;
 class JoltJoint3D;
 class JoltSoftBody3D;
 
@@ -56,6 +57,16 @@ public:
 		int collider_shape_index = 0;
 	};
 
+	// State as of the last completed step, read by the direct body state while a pipelined step is running.
+	struct CommittedState {
+		Transform3D transform;
+		Vector3 center_of_mass;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		int contact_count = 0;
+		bool sleeping = false;
+	};
+
 private:
 	LocalVector<RID> exceptions;
 	LocalVector<Contact> contacts;
@@ -79,6 +90,10 @@ private:
 
 	JoltPhysicsDirectBodyState3D *direct_state = nullptr;
 
+	JoltCharacter3D *character = nullptr;
+
+	CommittedState committed_state;
+
 	PhysicsServer3D::BodyMode mode = PhysicsServer3D::BODY_MODE_RIGID;
 
 	DampMode linear_damp_mode = PhysicsServer3D::BODY_DAMP_MODE_COMBINE;
@@ -130,6 +145,7 @@ private:
 	void _update_possible_kinematic_contacts();
 
 	void _destroy_joint_constraints();
+	void _destroy_character();
 
 	void _exit_all_areas();
 
@@ -195,6 +211,8 @@ public:
 	int get_max_contacts_reported() const { return contacts.size(); }
 	void set_max_contacts_reported(int p_count);
 
+	const CommittedState *get_committed_state() const;
+
 	int get_contact_count() const { return contact_count; }
 	const Contact &get_contact(int p_index) { return contacts[p_index]; }
 	virtual bool reports_contacts() const override { return !contacts.is_empty(); }
@@ -240,10 +258,14 @@ public:
 
 	void call_queries(JPH::Body &p_jolt_body);
 
+	void request_state_sync() { sync_state = true; }
+
 	virtual void pre_step(float p_step, JPH::Body &p_jolt_body) override;
 
 	JoltPhysicsDirectBodyState3D *get_direct_state();
 
+	bool move_character(const PhysicsServer3D::CharacterMotionParameters &p_parameters, PhysicsServer3D::CharacterMotionResult *r_result);
+
 	PhysicsServer3D::BodyMode get_mode() const { return mode; }
 
 	void set_mode(PhysicsServer3D::BodyMode p_mode);
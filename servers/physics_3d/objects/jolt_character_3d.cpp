@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  jolt_character_3d.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "jolt_character_3d.h"
+
+#include "../misc/jolt_type_conversions.h"
+#include "../shapes/jolt_shape_3d.h"
+#include "../spaces/jolt_motion_filter_3d.h"
+#include "../spaces/jolt_space_3d.h"
+#include "jolt_body_3d.h"
+
+#include "Jolt/Core/TempAllocator.h"
+
+namespace {
+
+// Godot's character controllers don't push rigid bodies, so we keep the character from waking or applying impulses to them.
+class JoltCharacterContactListener final : public JPH::CharacterContactListener {
+public:
+	virtual void OnContactAdded(const JPH::CharacterVirtual *p_character, const JPH::BodyID &p_body_id, const JPH::SubShapeID &p_sub_shape_id, JPH::RVec3Arg p_contact_position, JPH::Vec3Arg p_contact_normal, JPH::CharacterContactSettings &p_settings) override {
+		p_settings.mCanReceiveImpulses = false;
+	}
+};
+
+JoltCharacterContactListener contact_listener;
+
+constexpr JPH::uint TEMP_ALLOCATOR_SIZE = 256 * 1024;
+
+} // namespace
+
+void JoltCharacter3D::_update_character(const PhysicsServer3D::CharacterMotionParameters &p_parameters) {
+	const JPH::Shape *jolt_shape = body.get_jolt_shape();
+	const float new_padding = MAX((float)p_parameters.margin, 0.0001f);
+	const int new_max_slides = MAX(p_parameters.max_slides, 1);
+
+	// The padding and iteration count can only be set on creation, so any change means starting over.
+	if (jolt_character == nullptr || jolt_character->GetShape() != jolt_shape || padding != new_padding || max_slides != new_max_slides) {
+		padding = new_padding;
+		max_slides = new_max_slides;
+
+		JPH::CharacterVirtualSettings settings;
+		settings.mShape = jolt_shape;
+		settings.mUp = to_jolt(p_parameters.up_direction);
+		settings.mMaxSlopeAngle = (float)p_parameters.floor_max_angle;
+		settings.mMass = 0.0f;
+		settings.mMaxStrength = 0.0f;
+		settings.mCharacterPadding = padding;
+		settings.mMaxCollisionIterations = (JPH::uint)max_slides;
+
+		jolt_character = new JPH::CharacterVirtual(&settings, JPH::RVec3::sZero(), JPH::Quat::sIdentity(), &body.get_space()->get_physics_system());
+		jolt_character->SetListener(&contact_listener);
+	}
+
+	jolt_character->SetUp(to_jolt(p_parameters.up_direction));
+	jolt_character->SetMaxSlopeAngle((float)p_parameters.floor_max_angle);
+}
+
+bool JoltCharacter3D::_is_resting(const Transform3D &p_transform, const Vector3 &p_velocity) const {
+	// A character standing still on a floor that has fallen asleep would end up exactly where it is, so we skip the update
+	// for it, the same way Jolt skips the islands of sleeping bodies.
+	if (!p_velocity.is_zero_approx() || !jolt_character->IsSupported()) {
+		return false;
+	}
+
+	if (!to_godot(jolt_character->GetPosition()).is_equal_approx(p_transform.origin) || !jolt_character->GetRotation().IsClose(to_jolt(p_transform.basis))) {
+		return false;
+	}
+
+	const JoltSpace3D &space = *body.get_space();
+
+	for (const JPH::CharacterVirtual::Contact &contact : jolt_character->GetActiveContacts()) {
+		if (contact.mMotionTypeB == JPH::EMotionType::Static) {
+			continue;
+		}
+
+		const JoltReadableBody3D jolt_body = space.read_body(contact.mBodyB);
+		if (jolt_body.is_invalid() || jolt_body->IsActive()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void JoltCharacter3D::_fill_result(const Transform3D &p_from, float p_margin, PhysicsServer3D::CharacterMotionResult &r_result) const {
+	r_result.transform = Transform3D(to_godot(jolt_character->GetRotation()), to_godot(jolt_character->GetPosition()));
+	r_result.travel = r_result.transform.origin - p_from.origin;
+	r_result.velocity = to_godot(jolt_character->GetLinearVelocity());
+	r_result.collision_count = 0;
+
+	const JoltSpace3D &space = *body.get_space();
+
+	// Predictive contacts are reported by Jolt as well, so we only keep the ones that the character is touching.
+	const float max_distance = padding + p_margin;
+
+	for (const JPH::CharacterVirtual::Contact &contact : jolt_character->GetActiveContacts()) {
+		if (contact.mIsSensorB || contact.mBodyB.IsInvalid() || (!contact.mHadCollision && contact.mDistance > max_distance)) {
+			continue;
+		}
+
+		const JoltReadableBody3D collider_jolt_body = space.read_body(contact.mBodyB);
+		const JoltShapedObject3D *collider = collider_jolt_body.as_shaped();
+		if (collider == nullptr) {
+			continue;
+		}
+
+		PhysicsServer3D::MotionCollision &collision = r_result.collisions[r_result.collision_count++];
+
+		collision.position = to_godot(contact.mPosition);
+		collision.normal = to_godot(contact.mContactNormal);
+		collision.collider_velocity = to_godot(contact.mLinearVelocity);
+		collision.collider_angular_velocity = collider->get_angular_velocity();
+		collision.depth = MAX(p_margin - contact.mDistance, 0.0f);
+		collision.local_shape = 0;
+		collision.collider_id = collider->get_instance_id();
+		collision.collider = collider->get_rid();
+		collision.collider_shape = MAX(collider->find_shape_index(contact.mSubShapeIDB), 0);
+
+		if (r_result.collision_count == PhysicsServer3D::CharacterMotionResult::MAX_COLLISIONS) {
+			break;
+		}
+	}
+}
+
+JoltCharacter3D::JoltCharacter3D(JoltBody3D &p_body) :
+		body(p_body) {
+}
+
+bool JoltCharacter3D::move(const PhysicsServer3D::CharacterMotionParameters &p_parameters, PhysicsServer3D::CharacterMotionResult *r_result) {
+	ERR_FAIL_NULL_V(body.get_jolt_shape(), false);
+
+	Transform3D transform = p_parameters.from;
+	JOLT_ENSURE_SCALE_NOT_ZERO(transform, vformat("body_move_character (maybe from move_and_slide?) was passed an invalid transform along with body '%s'.", body.to_string()));
+	transform.basis.orthonormalize();
+
+	_update_character(p_parameters);
+
+	// This is also what gets reported back when the update is skipped, so it has to be set either way.
+	jolt_character->SetLinearVelocity(to_jolt(p_parameters.velocity));
+
+	if (!_is_resting(transform, p_parameters.velocity)) {
+		const JPH::Quat rotation = to_jolt(transform.basis);
+		const JPH::Vec3 up = to_jolt(p_parameters.up_direction);
+
+		// Jolt lifts the shape by the padding, which we undo here so that the body ends up where Godot would place it.
+		jolt_character->SetShapeOffset(rotation.Conjugated() * (-padding * up));
+		jolt_character->SetPosition(to_jolt_r(transform.origin));
+		jolt_character->SetRotation(rotation);
+
+		JPH::CharacterVirtual::ExtendedUpdateSettings update_settings;
+		update_settings.mStickToFloorStepDown = -up * (float)p_parameters.floor_snap_length;
+		update_settings.mWalkStairsStepUp = JPH::Vec3::sZero();
+
+		const JoltMotionFilter3D motion_filter(body, p_parameters.exclude_bodies, p_parameters.exclude_objects);
+
+		thread_local JPH::TempAllocatorImplWithMallocFallback temp_allocator(TEMP_ALLOCATOR_SIZE);
+
+		jolt_character->ExtendedUpdate((float)p_parameters.delta, JPH::Vec3::sZero(), update_settings, motion_filter, motion_filter, motion_filter, motion_filter, temp_allocator);
+	}
+
+	if (r_result != nullptr) {
+		_fill_result(transform, (float)p_parameters.margin, *r_result);
+	}
+
+	return true;
+}
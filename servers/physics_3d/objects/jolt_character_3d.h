@@ -0,0 +1,63 @@
+/**************************************************************************/
+/*  jolt_character_3d.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JOLT_CHARACTER_3D_H
+#define JOLT_CHARACTER_3D_H
+
+#include "servers/physics_server_3d.h"
+
+#include "Jolt/Jolt.h"
+
+#include "Jolt/Physics/Character/CharacterVirtual.h"
+
+class JoltBody3D;
+
+// Moves a kinematic body with Jolt's `CharacterVirtual`, which resolves all slides of a motion in a single update.
+// The character is never added to the simulation, so it only reads from the physics system and can be moved from
+// any thread while the space is not being stepped.
+class JoltCharacter3D {
+	JoltBody3D &body;
+
+	JPH::Ref<JPH::CharacterVirtual> jolt_character;
+
+	float padding = 0.0f;
+	int max_slides = 0;
+
+	void _update_character(const PhysicsServer3D::CharacterMotionParameters &p_parameters);
+	bool _is_resting(const Transform3D &p_transform, const Vector3 &p_velocity) const;
+	void _fill_result(const Transform3D &p_from, float p_margin, PhysicsServer3D::CharacterMotionResult &r_result) const;
+
+public:
+	explicit JoltCharacter3D(JoltBody3D &p_body);
+
+	bool move(const PhysicsServer3D::CharacterMotionParameters &p_parameters, PhysicsServer3D::CharacterMotionResult *r_result);
+};
+
+#endif // JOLT_CHARACTER_3D_H
@@ -95,6 +95,12 @@ void JoltObject3D::set_space(JoltSpace3D *p_space) {
 
 	if (space != nullptr) {
 		_add_to_space();
+
+		if (space->is_batching_bodies()) {
+			// The body is not in the broad phase yet, so we hold off on anything that might wake it up.
+			space->defer_batched_add(this);
+			return;
+		}
 	}
 
 	_space_changed();
@@ -126,6 +126,7 @@ public:
 
 	JoltSpace3D *get_space() const { return space; }
 	void set_space(JoltSpace3D *p_space);
+	void finish_batched_add() { _space_changed(); }
 	bool in_space() const { return space != nullptr && !jolt_id.IsInvalid(); }
 
 	uint32_t get_collision_layer() const { return collision_layer; }
@@ -51,6 +51,10 @@ real_t JoltPhysicsDirectBodyState3D::get_total_linear_damp() const {
 }
 
 Vector3 JoltPhysicsDirectBodyState3D::get_center_of_mass() const {
+	if (const JoltBody3D::CommittedState *committed_state = body->get_committed_state()) {
+		return committed_state->center_of_mass;
+	}
+
 	return body->get_center_of_mass_relative();
 }
 
@@ -75,6 +79,10 @@ Basis JoltPhysicsDirectBodyState3D::get_inverse_inertia_tensor() const {
 }
 
 Vector3 JoltPhysicsDirectBodyState3D::get_linear_velocity() const {
+	if (const JoltBody3D::CommittedState *committed_state = body->get_committed_state()) {
+		return committed_state->linear_velocity;
+	}
+
 	return body->get_linear_velocity();
 }
 
@@ -83,6 +91,10 @@ void JoltPhysicsDirectBodyState3D::set_linear_velocity(const Vector3 &p_velocity
 }
 
 Vector3 JoltPhysicsDirectBodyState3D::get_angular_velocity() const {
+	if (const JoltBody3D::CommittedState *committed_state = body->get_committed_state()) {
+		return committed_state->angular_velocity;
+	}
+
 	return body->get_angular_velocity();
 }
 
@@ -95,10 +107,20 @@ void JoltPhysicsDirectBodyState3D::set_transform(const Transform3D &p_transform)
 }
 
 Transform3D JoltPhysicsDirectBodyState3D::get_transform() const {
+	if (const JoltBody3D::CommittedState *committed_state = body->get_committed_state()) {
+		return committed_state->transform;
+	}
+
 	return body->get_transform_scaled();
 }
 
 Vector3 JoltPhysicsDirectBodyState3D::get_velocity_at_local_position(const Vector3 &p_local_position) const {
+	if (const JoltBody3D::CommittedState *committed_state = body->get_committed_state()) {
+		const Vector3 total_linear_velocity = committed_state->linear_velocity + body->get_linear_surface_velocity();
+		const Vector3 total_angular_velocity = committed_state->angular_velocity + body->get_angular_surface_velocity();
+		return total_linear_velocity + total_angular_velocity.cross(p_local_position - committed_state->center_of_mass);
+	}
+
 	return body->get_velocity_at_position(body->get_position() + p_local_position);
 }
 
@@ -155,6 +177,10 @@ void JoltPhysicsDirectBodyState3D::set_constant_torque(const Vector3 &p_torque)
 }
 
 bool JoltPhysicsDirectBodyState3D::is_sleeping() const {
+	if (const JoltBody3D::CommittedState *committed_state = body->get_committed_state()) {
+		return committed_state->sleeping;
+	}
+
 	return body->is_sleeping();
 }
 
@@ -163,61 +189,65 @@ void JoltPhysicsDirectBodyState3D::set_sleep_state(bool p_enabled) {
 }
 
 int JoltPhysicsDirectBodyState3D::get_contact_count() const {
+	if (const JoltBody3D::CommittedState *committed_state = body->get_committed_state()) {
+		return committed_state->contact_count;
+	}
+
 	return body->get_contact_count();
 }
 
 Vector3 JoltPhysicsDirectBodyState3D::get_contact_local_position(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), Vector3());
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), Vector3());
 	return body->get_contact(p_contact_idx).position;
 }
 
 Vector3 JoltPhysicsDirectBodyState3D::get_contact_local_normal(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), Vector3());
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), Vector3());
 	return body->get_contact(p_contact_idx).normal;
 }
 
 Vector3 JoltPhysicsDirectBodyState3D::get_contact_impulse(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), Vector3());
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), Vector3());
 	return body->get_contact(p_contact_idx).impulse;
 }
 
 int JoltPhysicsDirectBodyState3D::get_contact_local_shape(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), 0);
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), 0);
 	return body->get_contact(p_contact_idx).shape_index;
 }
 
 Vector3 JoltPhysicsDirectBodyState3D::get_contact_local_velocity_at_position(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), Vector3());
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), Vector3());
 	return body->get_contact(p_contact_idx).velocity;
 }
 
 RID JoltPhysicsDirectBodyState3D::get_contact_collider(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), RID());
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), RID());
 	return body->get_contact(p_contact_idx).collider_rid;
 }
 
 Vector3 JoltPhysicsDirectBodyState3D::get_contact_collider_position(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), Vector3());
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), Vector3());
 	return body->get_contact(p_contact_idx).collider_position;
 }
 
 ObjectID JoltPhysicsDirectBodyState3D::get_contact_collider_id(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), ObjectID());
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), ObjectID());
 	return body->get_contact(p_contact_idx).collider_id;
 }
 
 Object *JoltPhysicsDirectBodyState3D::get_contact_collider_object(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), nullptr);
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), nullptr);
 	return ObjectDB::get_instance(body->get_contact(p_contact_idx).collider_id);
 }
 
 int JoltPhysicsDirectBodyState3D::get_contact_collider_shape(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), 0);
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), 0);
 	return body->get_contact(p_contact_idx).collider_shape_index;
 }
 
 Vector3 JoltPhysicsDirectBodyState3D::get_contact_collider_velocity_at_position(int p_contact_idx) const {
-	ERR_FAIL_INDEX_V(p_contact_idx, (int)body->get_contact_count(), Vector3());
+	ERR_FAIL_INDEX_V(p_contact_idx, get_contact_count(), Vector3());
 	return body->get_contact(p_contact_idx).collider_velocity;
 }
 
@@ -32,6 +32,7 @@
 
 #include "../jolt_project_settings.h"
 #include "../misc/jolt_type_conversions.h"
+#include "jolt_shape_cache.h"
 
 #include "Jolt/Physics/Collision/Shape/MeshShape.h"
 
@@ -47,6 +48,25 @@ JPH::ShapeRefC JoltConcavePolygonShape3D::_build() const {
 	ERR_FAIL_COND_V_MSG(vertex_count < 3, nullptr, vformat("Failed to build Jolt Physics concave polygon shape with %s. It must have a vertex count of at least 3. This shape belongs to %s.", to_string(), _owners_to_string()));
 	ERR_FAIL_COND_V_MSG(excess_vertex_count != 0, nullptr, vformat("Failed to build Jolt Physics concave polygon shape with %s. It must have a vertex count that is divisible by 3. This shape belongs to %s.", to_string(), _owners_to_string()));
 
+	const float active_edge_threshold = JoltProjectSettings::get_active_edge_threshold();
+	const bool per_triangle_user_data = JoltProjectSettings::enable_ray_cast_face_index();
+
+	String cache_key;
+
+	if (JoltProjectSettings::use_shape_cache()) {
+		JoltShapeCache::KeyBuilder key_builder(get_type());
+		key_builder.add(active_edge_threshold);
+		key_builder.add(per_triangle_user_data);
+		key_builder.add_buffer(faces.ptr(), sizeof(Vector3) * (size_t)vertex_count);
+		cache_key = key_builder.finish();
+
+		const JPH::ShapeRefC cached_shape = JoltShapeCache::load(cache_key);
+
+		if (cached_shape != nullptr) {
+			return JoltShape3D::with_double_sided(cached_shape, back_face_collision);
+		}
+	}
+
 	JPH::TriangleList jolt_faces;
 	jolt_faces.reserve((size_t)face_count);
 
@@ -69,12 +89,16 @@ JPH::ShapeRefC JoltConcavePolygonShape3D::_build() const {
 	}
 
 	JPH::MeshShapeSettings shape_settings(jolt_faces);
-	shape_settings.mActiveEdgeCosThresholdAngle = JoltProjectSettings::get_active_edge_threshold();
-	shape_settings.mPerTriangleUserData = JoltProjectSettings::enable_ray_cast_face_index();
+	shape_settings.mActiveEdgeCosThresholdAngle = active_edge_threshold;
+	shape_settings.mPerTriangleUserData = per_triangle_user_data;
 
 	const JPH::ShapeSettings::ShapeResult shape_result = shape_settings.Create();
 	ERR_FAIL_COND_V_MSG(shape_result.HasError(), nullptr, vformat("Failed to build Jolt Physics concave polygon shape with %s. It returned the following error: '%s'. This shape belongs to %s.", to_string(), to_godot(shape_result.GetError()), _owners_to_string()));
 
+	if (!cache_key.is_empty()) {
+		JoltShapeCache::save(cache_key, shape_result.Get());
+	}
+
 	return JoltShape3D::with_double_sided(shape_result.Get(), back_face_collision);
 }
 
@@ -112,11 +136,14 @@ void JoltConcavePolygonShape3D::set_data(const Variant &p_data) {
 	const Variant maybe_back_face_collision = data.get("backface_collision", Variant());
 	ERR_FAIL_COND(maybe_back_face_collision.get_type() != Variant::BOOL);
 
+	wait_for_build();
+
 	faces = maybe_faces;
 	back_face_collision = maybe_back_face_collision;
 
 	aabb = _calculate_aabb();
 
+	_build_in_background();
 	destroy();
 }
 
@@ -32,6 +32,7 @@
 
 #include "../jolt_project_settings.h"
 #include "../misc/jolt_type_conversions.h"
+#include "jolt_shape_cache.h"
 
 #include "Jolt/Physics/Collision/Shape/ConvexHullShape.h"
 
@@ -44,6 +45,24 @@ JPH::ShapeRefC JoltConvexPolygonShape3D::_build() const {
 
 	ERR_FAIL_COND_V_MSG(vertex_count < 3, nullptr, vformat("Failed to build Jolt Physics convex polygon shape with %s. It must have a vertex count of at least 3. This shape belongs to %s.", to_string(), _owners_to_string()));
 
+	const float min_half_extent = _calculate_aabb().get_shortest_axis_size() * 0.5f;
+	const float actual_margin = MIN(margin, min_half_extent * JoltProjectSettings::get_collision_margin_fraction());
+
+	String cache_key;
+
+	if (JoltProjectSettings::use_shape_cache()) {
+		JoltShapeCache::KeyBuilder key_builder(get_type());
+		key_builder.add(actual_margin);
+		key_builder.add_buffer(vertices.ptr(), sizeof(Vector3) * (size_t)vertex_count);
+		cache_key = key_builder.finish();
+
+		const JPH::ShapeRefC cached_shape = JoltShapeCache::load(cache_key);
+
+		if (cached_shape != nullptr) {
+			return cached_shape;
+		}
+	}
+
 	JPH::Array<JPH::Vec3> jolt_vertices;
 	jolt_vertices.reserve((size_t)vertex_count);
 
@@ -54,13 +73,14 @@ JPH::ShapeRefC JoltConvexPolygonShape3D::_build() const {
 		jolt_vertices.emplace_back((float)vertex->x, (float)vertex->y, (float)vertex->z);
 	}
 
-	const float min_half_extent = _calculate_aabb().get_shortest_axis_size() * 0.5f;
-	const float actual_margin = MIN(margin, min_half_extent * JoltProjectSettings::get_collision_margin_fraction());
-
 	const JPH::ConvexHullShapeSettings shape_settings(jolt_vertices, actual_margin);
 	const JPH::ShapeSettings::ShapeResult shape_result = shape_settings.Create();
 	ERR_FAIL_COND_V_MSG(shape_result.HasError(), nullptr, vformat("Failed to build Jolt Physics convex polygon shape with %s. It returned the following error: '%s'. This shape belongs to %s.", to_string(), to_godot(shape_result.GetError()), _owners_to_string()));
 
+	if (!cache_key.is_empty()) {
+		JoltShapeCache::save(cache_key, shape_result.Get());
+	}
+
 	return shape_result.Get();
 }
 
@@ -85,10 +105,13 @@ Variant JoltConvexPolygonShape3D::get_data() const {
 void JoltConvexPolygonShape3D::set_data(const Variant &p_data) {
 	ERR_FAIL_COND(p_data.get_type() != Variant::PACKED_VECTOR3_ARRAY);
 
+	wait_for_build();
+
 	vertices = p_data;
 
 	aabb = _calculate_aabb();
 
+	_build_in_background();
 	destroy();
 }
 
@@ -97,8 +120,11 @@ void JoltConvexPolygonShape3D::set_margin(float p_margin) {
 		return;
 	}
 
+	wait_for_build();
+
 	margin = p_margin;
 
+	_build_in_background();
 	destroy();
 }
 
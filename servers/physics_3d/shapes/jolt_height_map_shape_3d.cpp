@@ -35,6 +35,7 @@
 
 #include "Jolt/Physics/Collision/Shape/HeightFieldShape.h"
 #include "Jolt/Physics/Collision/Shape/MeshShape.h"
+#include "Jolt/Physics/Collision/Shape/StaticCompoundShape.h"
 
 namespace {
 
@@ -49,6 +50,13 @@ bool _is_triangle_hole(const JPH::VertexList &p_vertices, int p_index0, int p_in
 
 } // namespace
 
+void JoltHeightMapShape3D::_build_tile_task(void *p_userdata, uint32_t p_index) {
+	JoltHeightMapShape3D *shape = static_cast<JoltHeightMapShape3D *>(p_userdata);
+
+	const int tile_index = (int)shape->building_tiles[p_index];
+	shape->built_tiles[p_index] = shape->_build_tile(tile_index % shape->tile_count_x, tile_index / shape->tile_count_x);
+}
+
 JPH::ShapeRefC JoltHeightMapShape3D::_build() const {
 	const int height_count = (int)heights.size();
 	if (unlikely(height_count == 0)) {
@@ -58,6 +66,10 @@ JPH::ShapeRefC JoltHeightMapShape3D::_build() const {
 	ERR_FAIL_COND_V_MSG(height_count != width * depth, nullptr, vformat("Failed to build Jolt Physics height map shape with %s. Height count must be the product of width and depth. This shape belongs to %s.", to_string(), _owners_to_string()));
 	ERR_FAIL_COND_V_MSG(width < 2 || depth < 2, nullptr, vformat("Failed to build Jolt Physics height map shape with %s. The height map must be at least 2x2. This shape belongs to %s.", to_string(), _owners_to_string()));
 
+	if (is_tiled()) {
+		return JoltShape3D::with_double_sided(_build_tiled(), true);
+	}
+
 	if (width != depth) {
 		return JoltShape3D::with_double_sided(_build_mesh(), true);
 	}
@@ -168,6 +180,107 @@ JPH::ShapeRefC JoltHeightMapShape3D::_build_mesh() const {
 	return shape_result.Get();
 }
 
+JPH::ShapeRefC JoltHeightMapShape3D::_build_tiled() const {
+	const float offset_x = (float)-(width - 1) / 2.0f;
+	const float offset_z = (float)-(depth - 1) / 2.0f;
+
+	JPH::StaticCompoundShapeSettings shape_settings;
+
+	for (int tile_z = 0; tile_z < tile_count_z; ++tile_z) {
+		for (int tile_x = 0; tile_x < tile_count_x; ++tile_x) {
+			const JPH::ShapeRefC &tile = tiles[(uint32_t)(tile_z * tile_count_x + tile_x)];
+
+			if (tile == nullptr) {
+				continue;
+			}
+
+			// The tiles are mirrored along the Z-axis (see `_build_tile`), so they're placed at their far edge.
+			const JPH::Vec3 tile_position(offset_x + (float)(tile_x * tile_size), 0.0f, offset_z + (float)((tile_z + 1) * tile_size));
+
+			shape_settings.AddShape(tile_position, JPH::Quat::sIdentity(), tile);
+		}
+	}
+
+	if (unlikely(shape_settings.mSubShapes.empty())) {
+		return nullptr;
+	}
+
+	const JPH::ShapeSettings::ShapeResult shape_result = shape_settings.Create();
+	ERR_FAIL_COND_V_MSG(shape_result.HasError(), nullptr, vformat("Failed to build Jolt Physics height map shape (as tiles) with %s. It returned the following error: '%s'. This shape belongs to %s.", to_string(), to_godot(shape_result.GetError()), _owners_to_string()));
+
+	return shape_result.Get();
+}
+
+JPH::ShapeRefC JoltHeightMapShape3D::_build_tile(int p_tile_x, int p_tile_z) const {
+	// Every tile covers the same number of quads, and thus shares its edge samples with its neighbors. Any samples that
+	// fall outside of the height map are turned into holes.
+
+	const int sample_count = tile_size + 1;
+
+	const int origin_x = p_tile_x * tile_size;
+	const int origin_z = p_tile_z * tile_size;
+
+	LocalVector<float> samples;
+	samples.resize((uint32_t)(sample_count * sample_count));
+
+	const real_t *heights_ptr = heights.ptr();
+	float *samples_ptr = samples.ptr();
+
+	// Same as in `_build_height_field`, the rows are reversed and the resulting shape mirrored along the Z-axis.
+
+	for (int row = 0; row < sample_count; ++row) {
+		const int z = origin_z + tile_size - row;
+
+		for (int column = 0; column < sample_count; ++column) {
+			const int x = origin_x + column;
+
+			float sample = FLT_MAX;
+
+			if (x < width && z < depth) {
+				const real_t height = heights_ptr[z * width + x];
+				sample = Math::is_nan(height) ? FLT_MAX : (float)height;
+			}
+
+			samples_ptr[row * sample_count + column] = sample;
+		}
+	}
+
+	JPH::HeightFieldShapeSettings shape_settings(samples.ptr(), JPH::Vec3::sZero(), JPH::Vec3::sReplicate(1.0f), (JPH::uint32)sample_count);
+
+	shape_settings.mBitsPerSample = shape_settings.CalculateBitsPerSampleForError(0.0f);
+	shape_settings.mActiveEdgeCosThresholdAngle = JoltProjectSettings::get_active_edge_threshold();
+
+	const JPH::ShapeSettings::ShapeResult shape_result = shape_settings.Create();
+	ERR_FAIL_COND_V_MSG(shape_result.HasError(), nullptr, vformat("Failed to build tile (%d, %d) of Jolt Physics height map shape with %s. It returned the following error: '%s'. This shape belongs to %s.", p_tile_x, p_tile_z, to_string(), to_godot(shape_result.GetError()), _owners_to_string()));
+
+	return with_scale(shape_result.Get(), Vector3(1, 1, -1));
+}
+
+void JoltHeightMapShape3D::_start_tile_builds() {
+	built_tiles.clear();
+	built_tiles.resize(building_tiles.size());
+
+	tile_group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&_build_tile_task, this, (int)building_tiles.size(), -1, false, SNAME("JoltHeightMapShape3D"));
+}
+
+void JoltHeightMapShape3D::_finish_tile_builds() {
+	if (tile_group_id == -1) {
+		return;
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(tile_group_id);
+	tile_group_id = -1;
+
+	for (uint32_t i = 0; i < building_tiles.size(); ++i) {
+		tiles[building_tiles[i]] = built_tiles[i];
+	}
+
+	building_tiles.clear();
+	built_tiles.clear();
+
+	tiles_changed = true;
+}
+
 AABB JoltHeightMapShape3D::_calculate_aabb() const {
 	AABB result;
 
@@ -192,6 +305,12 @@ AABB JoltHeightMapShape3D::_calculate_aabb() const {
 	return result;
 }
 
+JoltHeightMapShape3D::~JoltHeightMapShape3D() {
+	if (tile_group_id != -1) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(tile_group_id);
+	}
+}
+
 Variant JoltHeightMapShape3D::get_data() const {
 	Dictionary data;
 	data["width"] = width;
@@ -219,12 +338,105 @@ void JoltHeightMapShape3D::set_data(const Variant &p_data) {
 	const Variant maybe_depth = data.get("depth", Variant());
 	ERR_FAIL_COND(maybe_depth.get_type() != Variant::INT);
 
+	_finish_tile_builds();
+
 	heights = maybe_heights;
 	width = maybe_width;
 	depth = maybe_depth;
 
 	aabb = _calculate_aabb();
 
+	tiles.clear();
+	tiles_changed = false;
+
+	const int max_tile_size = JoltProjectSettings::get_heightmap_tile_size();
+
+	if (max_tile_size > 0 && width >= 2 && depth >= 2 && heights.size() == width * depth && (width - 1 > max_tile_size || depth - 1 > max_tile_size)) {
+		tile_size = max_tile_size;
+		tile_count_x = (width - 1 + tile_size - 1) / tile_size;
+		tile_count_z = (depth - 1 + tile_size - 1) / tile_size;
+
+		const uint32_t tile_count = (uint32_t)(tile_count_x * tile_count_z);
+
+		tiles.resize(tile_count);
+		building_tiles.resize(tile_count);
+
+		for (uint32_t i = 0; i < tile_count; ++i) {
+			building_tiles[i] = i;
+		}
+
+		_start_tile_builds();
+		_finish_tile_builds();
+
+		tiles_changed = false;
+	} else {
+		tile_size = 0;
+		tile_count_x = 0;
+		tile_count_z = 0;
+	}
+
+	destroy();
+}
+
+bool JoltHeightMapShape3D::update_region(const Rect2i &p_region, const Vector<real_t> &p_heights) {
+	ERR_FAIL_COND_V(p_region.size.x <= 0 || p_region.size.y <= 0, false);
+	ERR_FAIL_COND_V_MSG(!Rect2i(0, 0, width, depth).encloses(p_region), false, vformat("Failed to update region %s of Jolt Physics height map shape with %s. The region must lie within the height map.", p_region, to_string()));
+	ERR_FAIL_COND_V_MSG(p_heights.size() != p_region.size.x * p_region.size.y, false, vformat("Failed to update region %s of Jolt Physics height map shape with %s. Height count must be the product of the region's width and depth.", p_region, to_string()));
+
+	// Any tiles still being built are reading from the heights, so we need to wait for them before writing to it.
+	_finish_tile_builds();
+
+	const int region_x = p_region.position.x;
+	const int region_z = p_region.position.y;
+
+	const float offset_x = (float)-(width - 1) / 2.0f;
+	const float offset_z = (float)-(depth - 1) / 2.0f;
+
+	real_t *heights_ptr = heights.ptrw();
+	const real_t *region_ptr = p_heights.ptr();
+
+	for (int z = 0; z < p_region.size.y; ++z) {
+		for (int x = 0; x < p_region.size.x; ++x) {
+			const real_t height = region_ptr[z * p_region.size.x + x];
+			heights_ptr[(region_z + z) * width + (region_x + x)] = height;
+
+			// The bounds are only ever grown here, which might leave them larger than needed, but avoids having to
+			// iterate over the entire height map again.
+			aabb.expand_to(Vector3(offset_x + (float)(region_x + x), (float)height, offset_z + (float)(region_z + z)));
+		}
+	}
+
+	if (!is_tiled()) {
+		destroy();
+		return false;
+	}
+
+	// Samples on the edge of a tile are shared with its neighbors, so we include those neighbors as well.
+	const int first_tile_x = MAX(region_x - 1, 0) / tile_size;
+	const int first_tile_z = MAX(region_z - 1, 0) / tile_size;
+	const int last_tile_x = MIN((region_x + p_region.size.x - 1) / tile_size, tile_count_x - 1);
+	const int last_tile_z = MIN((region_z + p_region.size.y - 1) / tile_size, tile_count_z - 1);
+
+	for (int tile_z = first_tile_z; tile_z <= last_tile_z; ++tile_z) {
+		for (int tile_x = first_tile_x; tile_x <= last_tile_x; ++tile_x) {
+			building_tiles.push_back((uint32_t)(tile_z * tile_count_x + tile_x));
+		}
+	}
+
+	_start_tile_builds();
+
+	return true;
+}
+
+void JoltHeightMapShape3D::flush_tile_updates() {
+	_finish_tile_builds();
+
+	if (!tiles_changed) {
+		return;
+	}
+
+	tiles_changed = false;
+
 	destroy();
 }
 
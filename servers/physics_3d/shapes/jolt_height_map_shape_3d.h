@@ -33,6 +33,9 @@
 
 #include "jolt_shape_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+
 class JoltHeightMapShape3D final : public JoltShape3D {
 	AABB aabb;
 
@@ -45,13 +48,34 @@ class JoltHeightMapShape3D final : public JoltShape3D {
 	int width = 0;
 	int depth = 0;
 
+	LocalVector<JPH::ShapeRefC> tiles;
+	LocalVector<uint32_t> building_tiles;
+	LocalVector<JPH::ShapeRefC> built_tiles;
+
+	WorkerThreadPool::GroupID tile_group_id = -1;
+
+	int tile_size = 0;
+	int tile_count_x = 0;
+	int tile_count_z = 0;
+
+	bool tiles_changed = false;
+
+	static void _build_tile_task(void *p_userdata, uint32_t p_index);
+
 	virtual JPH::ShapeRefC _build() const override;
 	JPH::ShapeRefC _build_height_field() const;
 	JPH::ShapeRefC _build_mesh() const;
+	JPH::ShapeRefC _build_tiled() const;
+	JPH::ShapeRefC _build_tile(int p_tile_x, int p_tile_z) const;
+
+	void _start_tile_builds();
+	void _finish_tile_builds();
 
 	AABB _calculate_aabb() const;
 
 public:
+	virtual ~JoltHeightMapShape3D() override;
+
 	virtual ShapeType get_type() const override { return ShapeType::SHAPE_HEIGHTMAP; }
 	virtual bool is_convex() const override { return false; }
 
@@ -63,6 +87,11 @@ public:
 
 	virtual AABB get_aabb() const override { return aabb; }
 
+	bool is_tiled() const { return tile_size > 0; }
+
+	bool update_region(const Rect2i &p_region, const Vector<real_t> &p_heights);
+	void flush_tile_updates();
+
 	String to_string() const;
 };
 
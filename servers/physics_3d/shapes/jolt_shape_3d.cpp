@@ -30,11 +30,13 @@
 
 #include "jolt_shape_3d.h"
 
+#include "../jolt_project_settings.h"
 #include "../misc/jolt_type_conversions.h"
 #include "../objects/jolt_shaped_object_3d.h"
 #include "jolt_custom_double_sided_shape.h"
 #include "jolt_custom_user_data_shape.h"
 
+
 #include "Jolt/Physics/Collision/Shape/MutableCompoundShape.h"
 #include "Jolt/Physics/Collision/Shape/OffsetCenterOfMassShape.h"
 #include "Jolt/Physics/Collision/Shape/RotatedTranslatedShape.h"
@@ -46,9 +48,36 @@ namespace {
 
 constexpr float DEFAULT_SOLVER_BIAS = 0.0;
 
+// The owners of a shape can change while it's being built in the background, so we can't safely list them from there.
+thread_local bool building_in_background = false;
+
 } // namespace
 
+void JoltShape3D::_build_task(void *p_userdata) {
+	JoltShape3D *shape = static_cast<JoltShape3D *>(p_userdata);
+
+	// A pool thread that couldn't wait for this task may have built the shape already.
+	if (shape->build_claims.increment() != 1) {
+		return;
+	}
+
+	building_in_background = true;
+	shape->built_ref = shape->_build();
+	building_in_background = false;
+
+	{
+		MutexLock lock(shape->build_finished_mutex);
+		shape->build_finished = true;
+	}
+
+	shape->build_finished_condition.notify_all();
+}
+
 String JoltShape3D::_owners_to_string() const {
+	if (building_in_background) {
+		return "'<unknown>' (built in the background)";
+	}
+
 	const int owner_count = ref_counts_by_owner.size();
 
 	if (owner_count == 0) {
@@ -92,9 +121,29 @@ void JoltShape3D::set_solver_bias(float p_bias) {
 	}
 }
 
+void JoltShape3D::_build_in_background() {
+	if (!JoltProjectSettings::build_shapes_in_background()) {
+		return;
+	}
+
+	wait_for_build();
+
+	if (build_task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		// The previous task can't be released from this thread yet, so the shape is built on demand instead.
+		return;
+	}
+
+	build_claims.set(0);
+	build_finished = false;
+
+	build_task_id = WorkerThreadPool::get_singleton()->add_native_task(&_build_task, this, false, SNAME("JoltShape3D"));
+}
+
 JPH::ShapeRefC JoltShape3D::try_build() {
 	jolt_ref_mutex.lock();
 
+	wait_for_build();
+
 	if (jolt_ref == nullptr) {
 		jolt_ref = _build();
 	}
@@ -114,6 +163,59 @@ void JoltShape3D::destroy() {
 	}
 }
 
+void JoltShape3D::wait_for_build() {
+	MutexLock lock(jolt_ref_mutex);
+
+	if (build_task_id == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+
+	if (WorkerThreadPool::get_singleton()->wait_for_task_completion(build_task_id) == ERR_BUSY) {
+		// Pool threads can't wait for older tasks. If the task hasn't started yet, build the shape here instead,
+		// otherwise it's running on another thread and only has to finish. The task itself is released later, once
+		// it can be waited for, which also keeps the shape alive for as long as the task might access it.
+		if (!build_taken) {
+			if (build_claims.increment() == 1) {
+				built_ref = _build();
+			} else {
+				MutexLock build_finished_lock(build_finished_mutex);
+				while (!build_finished) {
+					build_finished_condition.wait(build_finished_lock);
+				}
+			}
+
+			jolt_ref = built_ref;
+			built_ref = nullptr;
+			build_taken = true;
+		}
+
+		return;
+	}
+
+	build_task_id = WorkerThreadPool::INVALID_TASK_ID;
+
+	if (!build_taken) {
+		jolt_ref = built_ref;
+	}
+
+	built_ref = nullptr;
+	build_taken = false;
+}
+
+bool JoltShape3D::finish_building() {
+	if (is_building() && !WorkerThreadPool::get_singleton()->is_task_completed(build_task_id)) {
+		return false;
+	}
+
+	wait_for_build();
+
+	for (const KeyValue<JoltShapedObject3D *, int> &E : ref_counts_by_owner) {
+		E.key->_shapes_changed();
+	}
+
+	return true;
+}
+
 JPH::ShapeRefC JoltShape3D::with_scale(const JPH::Shape *p_shape, const Vector3 &p_scale) {
 	ERR_FAIL_NULL_V(p_shape, nullptr);
 
@@ -31,6 +31,10 @@
 #ifndef JOLT_SHAPE_3D_H
 #define JOLT_SHAPE_3D_H
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/physics_server_3d.h"
 
 #include "Jolt/Jolt.h"
@@ -45,9 +49,20 @@ protected:
 	Mutex jolt_ref_mutex;
 	RID rid;
 	JPH::ShapeRefC jolt_ref;
+	JPH::ShapeRefC built_ref;
+	WorkerThreadPool::TaskID build_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	SafeNumeric<uint32_t> build_claims;
+	BinaryMutex build_finished_mutex;
+	ConditionVariable build_finished_condition;
+	bool build_finished = false;
+	bool build_taken = false;
+
+	static void _build_task(void *p_userdata);
 
 	virtual JPH::ShapeRefC _build() const = 0;
 
+	void _build_in_background();
+
 	String _owners_to_string() const;
 
 public:
@@ -80,6 +95,10 @@ public:
 
 	void destroy();
 
+	bool is_building() const { return build_task_id != WorkerThreadPool::INVALID_TASK_ID; }
+	void wait_for_build();
+	bool finish_building();
+
 	const JPH::Shape *get_jolt_ref() const { return jolt_ref; }
 
 	static JPH::ShapeRefC with_scale(const JPH::Shape *p_shape, const Vector3 &p_scale);
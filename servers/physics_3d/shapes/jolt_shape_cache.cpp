@@ -0,0 +1,159 @@
+/**************************************************************************/
+/*  jolt_shape_cache.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "jolt_shape_cache.h"
+
+#include "../jolt_project_settings.h"
+#include "../misc/jolt_stream_wrappers.h"
+#include "../misc/jolt_type_conversions.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+
+#include "Jolt/Physics/Collision/PhysicsMaterial.h"
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x4853434a; // "JCSH"
+constexpr uint32_t CACHE_VERSION = (JPH_VERSION_MAJOR << 16) | (JPH_VERSION_MINOR << 8) | JPH_VERSION_PATCH;
+
+} // namespace
+
+String JoltShapeCache::_get_path(const String &p_key) {
+	String cache_dir = JoltProjectSettings::get_shape_cache_path();
+	if (cache_dir.is_empty()) {
+		cache_dir = ProjectSettings::get_singleton()->get_imported_files_path().path_join("jolt_shapes");
+	}
+
+	return cache_dir.path_join(p_key + ".jshape");
+}
+
+JoltShapeCache::KeyBuilder::KeyBuilder(uint32_t p_shape_type) {
+	context.start();
+
+	add(CACHE_VERSION);
+	add(p_shape_type);
+}
+
+void JoltShapeCache::KeyBuilder::add_buffer(const void *p_data, size_t p_size) {
+	context.update(static_cast<const uint8_t *>(p_data), p_size);
+}
+
+String JoltShapeCache::KeyBuilder::finish() {
+	uint8_t hash[16];
+	context.finish(hash);
+
+	return String::hex_encode_buffer(hash, 16);
+}
+
+JPH::ShapeRefC JoltShapeCache::load(const String &p_key) {
+	const String path = _get_path(p_key);
+
+	if (!FileAccess::exists(path)) {
+		return nullptr;
+	}
+
+	Ref<FileAccess> file_access = FileAccess::open(path, FileAccess::READ);
+	if (file_access.is_null()) {
+		return nullptr;
+	}
+
+	if (file_access->get_32() != CACHE_MAGIC || file_access->get_32() != CACHE_VERSION) {
+		return nullptr;
+	}
+
+	JoltStreamInputWrapper input_stream(file_access);
+
+	JPH::Shape::IDToShapeMap shape_map;
+	JPH::Shape::IDToMaterialMap material_map;
+
+	const JPH::Shape::ShapeResult shape_result = JPH::Shape::sRestoreWithChildren(input_stream, shape_map, material_map);
+
+	if (shape_result.HasError()) {
+		WARN_PRINT(vformat("Failed to load cached Jolt Physics shape from '%s'. It returned the following error: '%s'. The shape will be built and cached again.", path, to_godot(shape_result.GetError())));
+
+		// Files only appear complete through the rename in `save`, so this one is broken for good.
+		MutexLock lock(save_mutex);
+		DirAccess::remove_absolute(path);
+
+		return nullptr;
+	}
+
+	return shape_result.Get();
+}
+
+void JoltShapeCache::save(const String &p_key, const JPH::Shape *p_shape) {
+	ERR_FAIL_NULL(p_shape);
+
+	const String path = _get_path(p_key);
+
+	// Shapes with identical geometry may finish building at the same time on different threads.
+	MutexLock lock(save_mutex);
+
+	if (FileAccess::exists(path)) {
+		return;
+	}
+
+	const Error dir_error = DirAccess::make_dir_recursive_absolute(path.get_base_dir());
+	if (dir_error != OK) {
+		return;
+	}
+
+	// Loading doesn't take the lock, so the file is written under a temporary name and renamed once complete.
+	// That way it never exists in a partially written state.
+	const String temp_path = path + ".tmp";
+
+	{
+		Ref<FileAccess> file_access = FileAccess::open(temp_path, FileAccess::WRITE);
+		if (file_access.is_null()) {
+			return;
+		}
+
+		file_access->store_32(CACHE_MAGIC);
+		file_access->store_32(CACHE_VERSION);
+
+		JoltStreamOutputWrapper output_stream(file_access);
+
+		JPH::Shape::ShapeToIDMap shape_map;
+		JPH::Shape::MaterialToIDMap material_map;
+
+		p_shape->SaveWithChildren(output_stream, shape_map, material_map);
+
+		if (file_access->get_error() != OK) {
+			file_access.unref();
+			DirAccess::remove_absolute(temp_path);
+			return;
+		}
+	}
+
+	if (DirAccess::rename_absolute(temp_path, path) != OK) {
+		DirAccess::remove_absolute(temp_path);
+	}
+}
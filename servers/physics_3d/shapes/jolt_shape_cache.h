@@ -0,0 +1,66 @@
+/**************************************************************************/
+/*  jolt_shape_cache.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JOLT_SHAPE_CACHE_H
+#define JOLT_SHAPE_CACHE_H
+
+#include "core/crypto/crypto_core.h"
+#include "core/os/mutex.h"
+#include "core/string/ustring.h"
+
+#include "Jolt/Jolt.h"
+
+#include "Jolt/Physics/Collision/Shape/Shape.h"
+
+class JoltShapeCache {
+	inline static Mutex save_mutex;
+
+	static String _get_path(const String &p_key);
+
+public:
+	class KeyBuilder {
+		CryptoCore::MD5Context context;
+
+	public:
+		explicit KeyBuilder(uint32_t p_shape_type);
+
+		template <typename TValue>
+		void add(const TValue &p_value) { add_buffer(&p_value, sizeof(TValue)); }
+
+		void add_buffer(const void *p_data, size_t p_size);
+
+		String finish();
+	};
+
+	static JPH::ShapeRefC load(const String &p_key);
+	static void save(const String &p_key, const JPH::Shape *p_shape);
+};
+
+#endif // JOLT_SHAPE_CACHE_H
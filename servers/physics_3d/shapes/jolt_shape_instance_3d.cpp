@@ -85,6 +85,12 @@ AABB JoltShapeInstance3D::get_aabb() const {
 bool JoltShapeInstance3D::try_build() {
 	ERR_FAIL_COND_V(is_disabled(), false);
 
+	if (shape->is_building()) {
+		// The owner will be notified once the shape has finished building, so we'll treat it as empty until then.
+		jolt_ref = nullptr;
+		return false;
+	}
+
 	const JPH::ShapeRefC maybe_new_shape = shape->try_build();
 
 	if (maybe_new_shape == nullptr) {
@@ -36,10 +36,14 @@
 #include "../objects/jolt_body_3d.h"
 #include "../objects/jolt_soft_body_3d.h"
 #include "jolt_space_3d.h"
+#include "jolt_step_profiler.h"
 
 #include "Jolt/Physics/Collision/EstimateCollisionResponse.h"
 #include "Jolt/Physics/SoftBody/SoftBodyManifold.h"
 
+thread_local JoltContactListener3D::ThreadContactBuffer JoltContactListener3D::thread_contact_buffer;
+SafeNumeric<uint64_t> JoltContactListener3D::last_step_id;
+
 void JoltContactListener3D::OnContactAdded(const JPH::Body &p_body1, const JPH::Body &p_body2, const JPH::ContactManifold &p_manifold, JPH::ContactSettings &p_settings) {
 	_try_override_collision_response(p_body1, p_body2, p_settings);
 	_try_apply_surface_velocities(p_body1, p_body2, p_settings);
@@ -63,13 +67,7 @@ void JoltContactListener3D::OnContactPersisted(const JPH::Body &p_body1, const J
 }
 
 void JoltContactListener3D::OnContactRemoved(const JPH::SubShapeIDPair &p_shape_pair) {
-	if (_try_remove_contacts(p_shape_pair)) {
-		return;
-	}
-
-	if (_try_remove_area_overlap(p_shape_pair)) {
-		return;
-	}
+	_try_remove_area_overlap(p_shape_pair);
 }
 
 JPH::SoftBodyValidateResult JoltContactListener3D::OnSoftBodyContactValidate(const JPH::Body &p_soft_body, const JPH::Body &p_other_body, JPH::SoftBodyContactSettings &p_settings) {
@@ -90,6 +88,24 @@ bool JoltContactListener3D::_is_listening_for(const JPH::Body &p_body) const {
 	return listening_for.has(p_body.GetID());
 }
 
+JoltContactListener3D::ContactBuffer &JoltContactListener3D::_get_contact_buffer() {
+	ThreadContactBuffer &thread_buffer = thread_contact_buffer;
+
+	// Each thread claims a buffer the first time it reports contacts during a step, which is the only time we lock.
+	if (unlikely(thread_buffer.step_id != step_id)) {
+		const MutexLock write_lock(write_mutex);
+
+		if (contact_buffers_used == contact_buffers.size()) {
+			contact_buffers.push_back(memnew(ContactBuffer));
+		}
+
+		thread_buffer.buffer = contact_buffers[contact_buffers_used++];
+		thread_buffer.step_id = step_id;
+	}
+
+	return *thread_buffer.buffer;
+}
+
 bool JoltContactListener3D::_try_override_collision_response(const JPH::Body &p_jolt_body1, const JPH::Body &p_jolt_body2, JPH::ContactSettings &p_settings) {
 	if (p_jolt_body1.IsSensor() || p_jolt_body2.IsSensor()) {
 		return false;
@@ -189,10 +205,17 @@ bool JoltContactListener3D::_try_add_contacts(const JPH::Body &p_body1, const JP
 
 	const JPH::SubShapeIDPair shape_pair(p_body1.GetID(), p_manifold.mSubShapeID1, p_body2.GetID(), p_manifold.mSubShapeID2);
 
-	Manifold &manifold = [&]() -> Manifold & {
-		const MutexLock write_lock(write_mutex);
-		return manifolds_by_shape_pair[shape_pair];
-	}();
+	ContactBuffer &buffer = _get_contact_buffer();
+
+	if (buffer.count == buffer.manifolds.size()) {
+		buffer.shape_pairs.resize(buffer.count + 1);
+		buffer.manifolds.resize(buffer.count + 1);
+	}
+
+	buffer.shape_pairs[buffer.count] = shape_pair;
+	Manifold &manifold = buffer.manifolds[buffer.count++];
+	manifold.contacts1.clear();
+	manifold.contacts2.clear();
 
 	const JPH::uint contact_count = p_manifold.mRelativeContactPointsOn1.size();
 
@@ -288,12 +311,6 @@ bool JoltContactListener3D::_try_evaluate_area_overlap(const JPH::Body &p_body1,
 	return true;
 }
 
-bool JoltContactListener3D::_try_remove_contacts(const JPH::SubShapeIDPair &p_shape_pair) {
-	const MutexLock write_lock(write_mutex);
-
-	return manifolds_by_shape_pair.erase(p_shape_pair);
-}
-
 bool JoltContactListener3D::_try_remove_area_overlap(const JPH::SubShapeIDPair &p_shape_pair) {
 	const JPH::SubShapeIDPair swapped_shape_pair(p_shape_pair.GetBody2ID(), p_shape_pair.GetSubShapeID2(), p_shape_pair.GetBody1ID(), p_shape_pair.GetSubShapeID1());
 
@@ -403,33 +420,38 @@ bool JoltContactListener3D::_try_add_debug_contacts(const JPH::Body &p_soft_body
 #endif
 
 void JoltContactListener3D::_flush_contacts() {
-	for (KeyValue<JPH::SubShapeIDPair, Manifold> &E : manifolds_by_shape_pair) {
-		const JPH::SubShapeIDPair &shape_pair = E.key;
-		Manifold &manifold = E.value;
+	for (uint32_t i = 0; i < contact_buffers_used; ++i) {
+		ContactBuffer &buffer = *contact_buffers[i];
 
-		const JPH::BodyID body_ids[2] = { shape_pair.GetBody1ID(), shape_pair.GetBody2ID() };
-		const JoltReadableBodies3D jolt_bodies = space->read_bodies(body_ids, 2);
+		for (uint32_t j = 0; j < buffer.count; ++j) {
+			const JPH::SubShapeIDPair &shape_pair = buffer.shape_pairs[j];
+			const Manifold &manifold = buffer.manifolds[j];
 
-		JoltBody3D *body1 = jolt_bodies[0].as_body();
-		ERR_FAIL_NULL(body1);
+			const JPH::BodyID body_ids[2] = { shape_pair.GetBody1ID(), shape_pair.GetBody2ID() };
+			const JoltReadableBodies3D jolt_bodies = space->read_bodies(body_ids, 2);
 
-		JoltBody3D *body2 = jolt_bodies[1].as_body();
-		ERR_FAIL_NULL(body2);
+			JoltBody3D *body1 = jolt_bodies[0].as_body();
+			ERR_CONTINUE(body1 == nullptr);
 
-		const int shape_index1 = body1->find_shape_index(shape_pair.GetSubShapeID1());
-		const int shape_index2 = body2->find_shape_index(shape_pair.GetSubShapeID2());
+			JoltBody3D *body2 = jolt_bodies[1].as_body();
+			ERR_CONTINUE(body2 == nullptr);
 
-		for (const Contact &contact : manifold.contacts1) {
-			body1->add_contact(body2, manifold.depth, shape_index1, shape_index2, contact.normal, contact.point_self, contact.point_other, contact.velocity_self, contact.velocity_other, contact.impulse);
-		}
+			const int shape_index1 = body1->find_shape_index(shape_pair.GetSubShapeID1());
+			const int shape_index2 = body2->find_shape_index(shape_pair.GetSubShapeID2());
 
-		for (const Contact &contact : manifold.contacts2) {
-			body2->add_contact(body1, manifold.depth, shape_index2, shape_index1, contact.normal, contact.point_self, contact.point_other, contact.velocity_self, contact.velocity_other, contact.impulse);
+			for (const Contact &contact : manifold.contacts1) {
+				body1->add_contact(body2, manifold.depth, shape_index1, shape_index2, contact.normal, contact.point_self, contact.point_other, contact.velocity_self, contact.velocity_other, contact.impulse);
+			}
+
+			for (const Contact &contact : manifold.contacts2) {
+				body2->add_contact(body1, manifold.depth, shape_index2, shape_index1, contact.normal, contact.point_self, contact.point_other, contact.velocity_self, contact.velocity_other, contact.impulse);
+			}
 		}
 
-		manifold.contacts1.clear();
-		manifold.contacts2.clear();
+		buffer.count = 0;
 	}
+
+	contact_buffers_used = 0;
 }
 
 void JoltContactListener3D::_flush_area_enters() {
@@ -528,6 +550,17 @@ void JoltContactListener3D::_flush_area_exits() {
 	area_exits.clear();
 }
 
+JoltContactListener3D::JoltContactListener3D(JoltSpace3D *p_space) :
+		space(p_space) {
+	step_id = last_step_id.increment();
+}
+
+JoltContactListener3D::~JoltContactListener3D() {
+	for (ContactBuffer *buffer : contact_buffers) {
+		memdelete(buffer);
+	}
+}
+
 void JoltContactListener3D::listen_for(JoltShapedObject3D *p_object) {
 	listening_for.insert(p_object->get_jolt_id());
 }
@@ -535,14 +568,25 @@ void JoltContactListener3D::listen_for(JoltShapedObject3D *p_object) {
 void JoltContactListener3D::pre_step() {
 	listening_for.clear();
 
+	// Invalidate the buffers claimed by threads during the previous step. The identifier is unique across spaces.
+	step_id = last_step_id.increment();
+
 #ifdef DEBUG_ENABLED
 	debug_contact_count = 0;
 #endif
 }
 
 void JoltContactListener3D::post_step() {
+	const uint64_t contacts_start = JoltStepProfiler::get_ticks();
+
 	_flush_contacts();
+
+	const uint64_t areas_start = JoltStepProfiler::get_ticks();
+
 	_flush_area_shifts();
 	_flush_area_exits();
 	_flush_area_enters();
+
+	JoltStepProfiler::add_time(JoltStepProfiler::STAGE_CONTACT_CALLBACKS, areas_start - contacts_start);
+	JoltStepProfiler::add_time_since(JoltStepProfiler::STAGE_AREA_OVERLAPS, areas_start);
 }
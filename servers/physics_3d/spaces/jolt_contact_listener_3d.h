@@ -31,7 +31,6 @@
 #ifndef JOLT_CONTACT_LISTENER_3D_H
 #define JOLT_CONTACT_LISTENER_3D_H
 
-#include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/local_vector.h"
@@ -84,7 +83,25 @@ class JoltContactListener3D final
 		float depth = 0.0f;
 	};
 
-	HashMap<JPH::SubShapeIDPair, Manifold, ShapePairHasher> manifolds_by_shape_pair;
+	// Manifolds reported by a single thread during a step. Storage is kept around between steps to avoid reallocating.
+	struct ContactBuffer {
+		LocalVector<JPH::SubShapeIDPair> shape_pairs;
+		LocalVector<Manifold> manifolds;
+		uint32_t count = 0;
+	};
+
+	struct ThreadContactBuffer {
+		uint64_t step_id = 0;
+		ContactBuffer *buffer = nullptr;
+	};
+
+	static thread_local ThreadContactBuffer thread_contact_buffer;
+	static SafeNumeric<uint64_t> last_step_id;
+
+	LocalVector<ContactBuffer *> contact_buffers;
+	uint32_t contact_buffers_used = 0;
+	uint64_t step_id = 0;
+
 	HashSet<JPH::BodyID, BodyIDHasher> listening_for;
 	HashSet<JPH::SubShapeIDPair, ShapePairHasher> area_overlaps;
 	HashSet<JPH::SubShapeIDPair, ShapePairHasher> area_enters;
@@ -109,12 +126,13 @@ class JoltContactListener3D final
 
 	bool _is_listening_for(const JPH::Body &p_body) const;
 
+	ContactBuffer &_get_contact_buffer();
+
 	bool _try_override_collision_response(const JPH::Body &p_jolt_body1, const JPH::Body &p_jolt_body2, JPH::ContactSettings &p_settings);
 	bool _try_override_collision_response(const JPH::Body &p_jolt_soft_body, const JPH::Body &p_jolt_other_body, JPH::SoftBodyContactSettings &p_settings);
 	bool _try_apply_surface_velocities(const JPH::Body &p_jolt_body1, const JPH::Body &p_jolt_body2, JPH::ContactSettings &p_settings);
 	bool _try_add_contacts(const JPH::Body &p_body1, const JPH::Body &p_body2, const JPH::ContactManifold &p_manifold, JPH::ContactSettings &p_settings);
 	bool _try_evaluate_area_overlap(const JPH::Body &p_body1, const JPH::Body &p_body2, const JPH::ContactManifold &p_manifold);
-	bool _try_remove_contacts(const JPH::SubShapeIDPair &p_shape_pair);
 	bool _try_remove_area_overlap(const JPH::SubShapeIDPair &p_shape_pair);
 
 #ifdef DEBUG_ENABLED
@@ -128,8 +146,8 @@ class JoltContactListener3D final
 	void _flush_area_exits();
 
 public:
-	explicit JoltContactListener3D(JoltSpace3D *p_space) :
-			space(p_space) {}
+	explicit JoltContactListener3D(JoltSpace3D *p_space);
+	~JoltContactListener3D();
 
 	void listen_for(JoltShapedObject3D *p_object);
 
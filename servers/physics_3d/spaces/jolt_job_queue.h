@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  jolt_job_queue.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JOLT_JOB_QUEUE_H
+#define JOLT_JOB_QUEUE_H
+
+#include "core/typedefs.h"
+
+#include <stdint.h>
+#include <atomic>
+
+// Bounded lock-free multi-producer multi-consumer queue, based on the design by Dmitry Vyukov.
+// Every cell carries a sequence number that tells producers and consumers whose turn it is, so
+// pushing and popping only contend on a single atomic each.
+
+template <typename T, uint32_t CAPACITY>
+class JoltJobQueue {
+	static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two.");
+
+	static constexpr uint32_t MASK = CAPACITY - 1;
+
+	struct Cell {
+		std::atomic<uint32_t> sequence = 0;
+		T value = T();
+	};
+
+	Cell cells[CAPACITY];
+
+	alignas(64) std::atomic<uint32_t> push_position = 0;
+	alignas(64) std::atomic<uint32_t> pop_position = 0;
+
+public:
+	bool push(const T &p_value) {
+		uint32_t position = push_position.load(std::memory_order_relaxed);
+
+		while (true) {
+			Cell &cell = cells[position & MASK];
+			const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+			const int32_t difference = (int32_t)(sequence - position);
+
+			if (difference == 0) {
+				if (push_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					cell.value = p_value;
+					cell.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			} else if (difference < 0) {
+				return false; // Full.
+			} else {
+				position = push_position.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool pop(T &r_value) {
+		uint32_t position = pop_position.load(std::memory_order_relaxed);
+
+		while (true) {
+			Cell &cell = cells[position & MASK];
+			const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+			const int32_t difference = (int32_t)(sequence - (position + 1));
+
+			if (difference == 0) {
+				if (pop_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					r_value = cell.value;
+					cell.sequence.store(position + CAPACITY, std::memory_order_release);
+					return true;
+				}
+			} else if (difference < 0) {
+				return false; // Empty.
+			} else {
+				position = pop_position.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	JoltJobQueue() {
+		for (uint32_t i = 0; i < CAPACITY; ++i) {
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+};
+
+#endif // JOLT_JOB_QUEUE_H
@@ -35,38 +35,38 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
-#include "core/os/time.h"
 
-#include "Jolt/Physics/PhysicsSettings.h"
+void JoltJobSystem::Job::_run() {
+	const uint64_t time_start = JoltStepProfiler::get_ticks();
 
-void JoltJobSystem::Job::_execute(void *p_user_data) {
-	Job *job = static_cast<Job *>(p_user_data);
+	job_function();
 
-#ifdef DEBUG_ENABLED
-	const uint64_t time_start = Time::get_singleton()->get_ticks_usec();
-#endif
+	const uint64_t time_end = JoltStepProfiler::get_ticks();
+	const uint64_t time_elapsed = time_end - time_start;
 
-	job->Execute();
+	JoltStepProfiler::add_time(stage, time_elapsed);
 
 #ifdef DEBUG_ENABLED
-	const uint64_t time_end = Time::get_singleton()->get_ticks_usec();
-	const uint64_t time_elapsed = time_end - time_start;
-
 	timings_lock.lock();
-	timings_by_job[job->name] += time_elapsed;
+	timings_by_job[name] += time_elapsed;
 	timings_lock.unlock();
 #endif
+}
 
+void JoltJobSystem::Job::_execute(void *p_user_data) {
+	Job *job = static_cast<Job *>(p_user_data);
+
+	job->Execute();
 	job->Release();
 }
 
 JoltJobSystem::Job::Job(const char *p_name, JPH::ColorArg p_color, JPH::JobSystem *p_job_system, const JPH::JobSystem::JobFunction &p_job_function, JPH::uint32 p_dependency_count) :
-		JPH::JobSystem::Job(p_name, p_color, p_job_system, p_job_function, p_dependency_count)
+		JPH::JobSystem::Job(p_name, p_color, p_job_system, [this]() { _run(); }, p_dependency_count),
 #ifdef DEBUG_ENABLED
-		,
-		name(p_name)
+		name(p_name),
 #endif
-{
+		stage(JoltStepProfiler::get_job_stage(p_name)),
+		job_function(p_job_function) {
 }
 
 JoltJobSystem::Job::~Job() {
@@ -84,17 +84,10 @@ void JoltJobSystem::Job::push_completed(Job *p_job) {
 	} while (!completed_head.compare_exchange_weak(prev_head, p_job, std::memory_order_release, std::memory_order_relaxed));
 }
 
-JoltJobSystem::Job *JoltJobSystem::Job::pop_completed() {
-	Job *prev_head = nullptr;
-
-	do {
-		prev_head = completed_head.load(std::memory_order_relaxed);
-		if (prev_head == nullptr) {
-			return nullptr;
-		}
-	} while (!completed_head.compare_exchange_weak(prev_head, prev_head->completed_next, std::memory_order_acquire, std::memory_order_relaxed));
-
-	return prev_head;
+JoltJobSystem::Job *JoltJobSystem::Job::take_completed() {
+	// Taking the whole list at once, rather than popping one job at a time, keeps this safe when several spaces
+	// reclaim jobs at the same time.
+	return completed_head.exchange(nullptr, std::memory_order_acquire);
 }
 
 void JoltJobSystem::Job::queue() {
@@ -140,7 +133,17 @@ JPH::JobHandle JoltJobSystem::CreateJob(const char *p_name, JPH::ColorArg p_colo
 }
 
 void JoltJobSystem::QueueJob(JPH::JobSystem::Job *p_job) {
-	static_cast<Job *>(p_job)->queue();
+	if (!use_dedicated_threads) {
+		static_cast<Job *>(p_job)->queue();
+		return;
+	}
+
+	p_job->AddRef();
+
+	if (unlikely(!job_queue.push(static_cast<Job *>(p_job)))) {
+		// Should never happen, but running the job right away beats losing it.
+		Job::_execute(p_job);
+	}
 }
 
 void JoltJobSystem::QueueJobs(JPH::JobSystem::Job **p_jobs, JPH::uint p_job_count) {
@@ -154,22 +157,122 @@ void JoltJobSystem::FreeJob(JPH::JobSystem::Job *p_job) {
 }
 
 void JoltJobSystem::_reclaim_jobs() {
-	while (Job *job = Job::pop_completed()) {
+	Job *job = Job::take_completed();
+
+	while (job != nullptr) {
+		Job *next_job = job->get_completed_next();
 		jobs.DestructObject(job);
+		job = next_job;
+	}
+}
+
+void JoltJobSystem::_worker_thread(void *p_user_data) {
+	JoltJobSystem *job_system = static_cast<JoltJobSystem *>(p_user_data);
+
+	Thread::set_name("Jolt Physics Worker");
+
+	while (true) {
+		job_system->step_semaphore.wait();
+
+		if (job_system->exiting.load(std::memory_order_acquire)) {
+			break;
+		}
+
+		job_system->_run_queued_jobs();
+	}
+}
+
+void JoltJobSystem::_run_queued_jobs() {
+	static constexpr int SPIN_COUNT = 1000;
+
+	int idle_count = 0;
+
+	while (true) {
+		// Read the flag before looking at the queue, so that a job queued right before the step ended is still released.
+		const bool keep_spinning = stepping.load(std::memory_order_acquire);
+
+		Job *job = nullptr;
+		if (job_queue.pop(job)) {
+			Job::_execute(job);
+			idle_count = 0;
+			continue;
+		}
+
+		if (!keep_spinning) {
+			break;
+		}
+
+		// The thread waiting on the step barrier executes jobs as well, so there is no need to block here.
+		if (++idle_count > SPIN_COUNT) {
+			OS::get_singleton()->yield();
+			idle_count = 0;
+		}
 	}
 }
 
 JoltJobSystem::JoltJobSystem() :
-		JPH::JobSystemWithBarrier(JPH::cMaxPhysicsBarriers),
+		JPH::JobSystemWithBarrier(MAX_PARALLEL_STEPS),
 		thread_count(MAX(1, WorkerThreadPool::get_singleton()->get_thread_count())) {
-	jobs.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsJobs);
+	jobs.Init(MAX_JOBS, JPH::cMaxPhysicsJobs);
+
+#ifdef THREADS_ENABLED
+	use_dedicated_threads = JoltProjectSettings::use_dedicated_job_threads();
+#endif
+
+	if (use_dedicated_threads) {
+		// The thread stepping the space helps out while waiting on the barriers, so leave room for it.
+		const int worker_count = MAX(1, thread_count - 1);
+		thread_count = worker_count + 1;
+
+		for (int i = 0; i < worker_count; ++i) {
+			Thread *worker_thread = memnew(Thread);
+			worker_thread->start(&JoltJobSystem::_worker_thread, this);
+			worker_threads.push_back(worker_thread);
+		}
+	}
+}
+
+JoltJobSystem::~JoltJobSystem() {
+	if (!use_dedicated_threads) {
+		return;
+	}
+
+	exiting.store(true, std::memory_order_release);
+
+	for (uint32_t i = 0; i < worker_threads.size(); ++i) {
+		step_semaphore.post();
+	}
+
+	for (Thread *worker_thread : worker_threads) {
+		worker_thread->wait_to_finish();
+		memdelete(worker_thread);
+	}
+
+	worker_threads.clear();
+
+	// Release anything that was queued after the last step.
+	_run_queued_jobs();
+	_reclaim_jobs();
 }
 
 void JoltJobSystem::pre_step() {
-	// Nothing to do.
+	if (!use_dedicated_threads) {
+		return;
+	}
+
+	stepping.store(true, std::memory_order_release);
+
+	for (uint32_t i = 0; i < worker_threads.size(); ++i) {
+		step_semaphore.post();
+	}
 }
 
 void JoltJobSystem::post_step() {
+	if (use_dedicated_threads) {
+		// All jobs of the step are done once the step returns, so the workers only release what's left in the queue and go back to sleep.
+		stepping.store(false, std::memory_order_release);
+	}
+
 	_reclaim_jobs();
 }
 
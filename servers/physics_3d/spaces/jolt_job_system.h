@@ -31,18 +31,31 @@
 #ifndef JOLT_JOB_SYSTEM_H
 #define JOLT_JOB_SYSTEM_H
 
+#include "jolt_job_queue.h"
+#include "jolt_step_profiler.h"
+
+#include "core/os/semaphore.h"
 #include "core/os/spin_lock.h"
+#include "core/os/thread.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 
 #include "Jolt/Jolt.h"
 
 #include "Jolt/Core/FixedSizeFreeList.h"
 #include "Jolt/Core/JobSystemWithBarrier.h"
+#include "Jolt/Physics/PhysicsSettings.h"
 
 #include <stdint.h>
 #include <atomic>
 
 class JoltJobSystem final : public JPH::JobSystemWithBarrier {
+public:
+	// Every space being stepped at the same time needs its own barrier and its own share of jobs.
+	static constexpr int MAX_PARALLEL_STEPS = JPH::cMaxPhysicsBarriers;
+	static constexpr uint32_t MAX_JOBS = JPH::cMaxPhysicsJobs * MAX_PARALLEL_STEPS;
+
+private:
 	class Job : public JPH::JobSystem::Job {
 		inline static std::atomic<Job *> completed_head = nullptr;
 
@@ -52,18 +65,27 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 
 		int64_t task_id = -1;
 
+		JoltStepProfiler::Stage stage = JoltStepProfiler::STAGE_SOLVER;
+
+		// Barriers also run jobs directly, bypassing `_execute`, so the timing wraps the job function itself.
+		JPH::JobSystem::JobFunction job_function;
+
 		std::atomic<Job *> completed_next = nullptr;
 
-		static void _execute(void *p_user_data);
+		void _run();
 
 	public:
+		static void _execute(void *p_user_data);
+
 		Job(const char *p_name, JPH::ColorArg p_color, JPH::JobSystem *p_job_system, const JPH::JobSystem::JobFunction &p_job_function, JPH::uint32 p_dependency_count);
 		Job(const Job &p_other) = delete;
 		Job(Job &&p_other) = delete;
 		~Job();
 
 		static void push_completed(Job *p_job);
-		static Job *pop_completed();
+		static Job *take_completed();
+
+		Job *get_completed_next() const { return completed_next.load(std::memory_order_relaxed); }
 
 		void queue();
 
@@ -84,6 +106,19 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 
 	int thread_count = 0;
 
+	// Dedicated worker threads that wait for `pre_step` and then spin on the job queue until `post_step`,
+	// which avoids going through the `WorkerThreadPool` task bookkeeping for every job.
+	bool use_dedicated_threads = false;
+	LocalVector<Thread *> worker_threads;
+	Semaphore step_semaphore;
+	std::atomic<bool> stepping = false;
+	std::atomic<bool> exiting = false;
+
+	// Every job is queued at most once while it's alive, so this can never overflow.
+	JoltJobQueue<Job *, MAX_JOBS> job_queue;
+
+	static void _worker_thread(void *p_user_data);
+
 	virtual int GetMaxConcurrency() const override;
 
 	virtual JPH::JobHandle CreateJob(const char *p_name, JPH::ColorArg p_color, const JPH::JobSystem::JobFunction &p_job_function, JPH::uint32 p_dependency_count = 0) override;
@@ -92,9 +127,11 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 	virtual void FreeJob(JPH::JobSystem::Job *p_job) override;
 
 	void _reclaim_jobs();
+	void _run_queued_jobs();
 
 public:
 	JoltJobSystem();
+	~JoltJobSystem();
 
 	void pre_step();
 	void post_step();
@@ -43,6 +43,8 @@
 #include "jolt_query_filter_3d.h"
 #include "jolt_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 #include "Jolt/Geometry/GJKClosestPoint.h"
 #include "Jolt/Physics/Body/Body.h"
 #include "Jolt/Physics/Body/BodyFilter.h"
@@ -54,6 +56,13 @@
 #include "Jolt/Physics/Collision/Shape/MeshShape.h"
 #include "Jolt/Physics/PhysicsSystem.h"
 
+namespace {
+
+// Number of queries handled by one worker thread pool task when running a batch.
+constexpr int BATCH_CHUNK_SIZE = 64;
+
+} // namespace
+
 bool JoltPhysicsDirectSpaceState3D::_cast_motion_impl(const JPH::Shape &p_jolt_shape, const Transform3D &p_transform_com, const Vector3 &p_scale, const Vector3 &p_motion, bool p_use_edge_removal, bool p_ignore_overlaps, const JPH::CollideShapeSettings &p_settings, const JPH::BroadPhaseLayerFilter &p_broad_phase_layer_filter, const JPH::ObjectLayerFilter &p_object_layer_filter, const JPH::BodyFilter &p_body_filter, const JPH::ShapeFilter &p_shape_filter, real_t &r_closest_safe, real_t &r_closest_unsafe) const {
 	r_closest_safe = 1.0f;
 	r_closest_unsafe = 1.0f;
@@ -468,26 +477,20 @@ JoltPhysicsDirectSpaceState3D::JoltPhysicsDirectSpaceState3D(JoltSpace3D *p_spac
 		space(p_space) {
 }
 
-bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
-
-	space->try_optimize();
-
-	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
-
-	const JPH::RVec3 from = to_jolt_r(p_parameters.from);
-	const JPH::RVec3 to = to_jolt_r(p_parameters.to);
+bool JoltPhysicsDirectSpaceState3D::_intersect_ray_impl(const JoltQueryFilter3D &p_query_filter, const Vector3 &p_from, const Vector3 &p_to, bool p_hit_from_inside, bool p_hit_back_faces, RayResult &r_result) const {
+	const JPH::RVec3 from = to_jolt_r(p_from);
+	const JPH::RVec3 to = to_jolt_r(p_to);
 	const JPH::Vec3 vector = JPH::Vec3(to - from);
 	const JPH::RRayCast ray(from, vector);
 
-	const JPH::EBackFaceMode back_face_mode = p_parameters.hit_back_faces ? JPH::EBackFaceMode::CollideWithBackFaces : JPH::EBackFaceMode::IgnoreBackFaces;
+	const JPH::EBackFaceMode back_face_mode = p_hit_back_faces ? JPH::EBackFaceMode::CollideWithBackFaces : JPH::EBackFaceMode::IgnoreBackFaces;
 
 	JPH::RayCastSettings settings;
-	settings.mTreatConvexAsSolid = p_parameters.hit_from_inside;
+	settings.mTreatConvexAsSolid = p_hit_from_inside;
 	settings.mBackFaceModeTriangles = back_face_mode;
 
 	JoltQueryCollectorClosest<JPH::CastRayCollector> collector;
-	space->get_narrow_phase_query().CastRay(ray, settings, collector, query_filter, query_filter, query_filter);
+	space->get_narrow_phase_query().CastRay(ray, settings, collector, p_query_filter, p_query_filter, p_query_filter);
 
 	if (!collector.had_hit()) {
 		return false;
@@ -506,7 +509,7 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 
 	JPH::Vec3 normal = JPH::Vec3::sZero();
 
-	if (!p_parameters.hit_from_inside || hit.mFraction > 0.0f) {
+	if (!p_hit_from_inside || hit.mFraction > 0.0f) {
 		normal = body->GetWorldSpaceSurfaceNormal(sub_shape_id, position);
 
 		// If we got a back-face normal we need to flip it.
@@ -532,6 +535,93 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 	return true;
 }
 
+void JoltPhysicsDirectSpaceState3D::_intersect_rays_batch_chunk(void *p_userdata, uint32_t p_chunk) {
+	const RayBatch &batch = *(const RayBatch *)p_userdata;
+
+	const int begin = (int)p_chunk * BATCH_CHUNK_SIZE;
+	const int end = MIN(begin + BATCH_CHUNK_SIZE, batch.count);
+
+	for (int i = begin; i < end; ++i) {
+		batch.hits[i] = batch.space_state->_intersect_ray_impl(*batch.query_filter, batch.from[i], batch.to[i], batch.parameters->hit_from_inside, batch.parameters->hit_back_faces, batch.results[i]);
+	}
+}
+
+void JoltPhysicsDirectSpaceState3D::_cast_motion_batch_chunk(void *p_userdata, uint32_t p_chunk) {
+	const MotionBatch &batch = *(const MotionBatch *)p_userdata;
+
+	const int begin = (int)p_chunk * BATCH_CHUNK_SIZE;
+	const int end = MIN(begin + BATCH_CHUNK_SIZE, batch.count);
+
+	for (int i = begin; i < end; ++i) {
+		const Transform3D transform_com(batch.basis, batch.origins[i] + batch.com_offset);
+		batch.space_state->_cast_motion_impl(*batch.jolt_shape, transform_com, batch.scale, batch.motions[i], batch.use_edge_removal, true, *batch.settings, *batch.query_filter, *batch.query_filter, *batch.query_filter, JPH::ShapeFilter(), batch.closest_safe[i], batch.closest_unsafe[i]);
+	}
+}
+
+bool JoltPhysicsDirectSpaceState3D::_can_run_batch_on_threads(int p_count) {
+	if (p_count <= BATCH_CHUNK_SIZE) {
+		return false;
+	}
+
+	// Waiting on a group task from within the pool blocks that thread, so leave at least one other thread to do the work.
+	WorkerThreadPool *thread_pool = WorkerThreadPool::get_singleton();
+	return WorkerThreadPool::get_thread_index() == -1 || thread_pool->get_thread_count() > 1;
+}
+
+bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
+
+	space->try_optimize();
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
+
+	return _intersect_ray_impl(query_filter, p_parameters.from, p_parameters.to, p_parameters.hit_from_inside, p_parameters.hit_back_faces, r_result);
+}
+
+int JoltPhysicsDirectSpaceState3D::intersect_rays_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), 0, "intersect_rays_batch must not be called while the physics space is being stepped.");
+
+	if (p_ray_count <= 0) {
+		return 0;
+	}
+
+	space->try_optimize();
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
+
+	RayBatch batch;
+	batch.space_state = this;
+	batch.parameters = &p_parameters;
+	batch.query_filter = &query_filter;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.count = p_ray_count;
+
+	const uint32_t chunk_count = (uint32_t)((p_ray_count + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE);
+
+	if (_can_run_batch_on_threads(p_ray_count)) {
+		WorkerThreadPool *thread_pool = WorkerThreadPool::get_singleton();
+		const WorkerThreadPool::GroupID group_id = thread_pool->add_native_group_task(&_intersect_rays_batch_chunk, &batch, chunk_count, -1, true, SNAME("JoltIntersectRaysBatch"));
+		thread_pool->wait_for_group_task_completion(group_id);
+	} else {
+		for (uint32_t i = 0; i < chunk_count; ++i) {
+			_intersect_rays_batch_chunk(&batch, i);
+		}
+	}
+
+	int hit_count = 0;
+
+	for (int i = 0; i < p_ray_count; ++i) {
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
 int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_point must not be called while the physics space is being stepped.");
 
@@ -664,6 +754,64 @@ bool JoltPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_paramet
 	return true;
 }
 
+bool JoltPhysicsDirectSpaceState3D::cast_motion_batch(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "cast_motion_batch must not be called while the physics space is being stepped.");
+
+	if (p_count <= 0) {
+		return true;
+	}
+
+	space->try_optimize();
+
+	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL_V(jolt_shape, false);
+
+	Transform3D transform = p_parameters.transform;
+	JOLT_ENSURE_SCALE_NOT_ZERO(transform, "cast_motion_batch was passed an invalid transform.");
+
+	Vector3 scale = transform.basis.get_scale();
+	JOLT_ENSURE_SCALE_VALID(jolt_shape, scale, "cast_motion_batch was passed an invalid transform.");
+
+	transform.basis.orthonormalize();
+
+	JPH::CollideShapeSettings settings;
+	settings.mMaxSeparationDistance = (float)p_parameters.margin;
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+
+	MotionBatch batch;
+	batch.space_state = this;
+	batch.jolt_shape = jolt_shape;
+	batch.query_filter = &query_filter;
+	batch.settings = &settings;
+	batch.basis = transform.basis;
+	batch.scale = scale;
+	batch.com_offset = transform.basis.xform(to_godot(jolt_shape->GetCenterOfMass()));
+	batch.use_edge_removal = JoltProjectSettings::use_enhanced_internal_edge_removal_for_queries();
+	batch.origins = p_origins;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+	batch.count = p_count;
+
+	const uint32_t chunk_count = (uint32_t)((p_count + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE);
+
+	if (_can_run_batch_on_threads(p_count)) {
+		WorkerThreadPool *thread_pool = WorkerThreadPool::get_singleton();
+		const WorkerThreadPool::GroupID group_id = thread_pool->add_native_group_task(&_cast_motion_batch_chunk, &batch, chunk_count, -1, true, SNAME("JoltCastMotionBatch"));
+		thread_pool->wait_for_group_task_completion(group_id);
+	} else {
+		for (uint32_t i = 0; i < chunk_count; ++i) {
+			_cast_motion_batch_chunk(&batch, i);
+		}
+	}
+
+	return true;
+}
+
 bool JoltPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
 	r_result_count = 0;
 
@@ -33,6 +33,7 @@
 #include "../joints/jolt_joint_3d.h"
 #include "../jolt_physics_server_3d.h"
 #include "../jolt_project_settings.h"
+#include "../misc/jolt_state_recorder.h"
 #include "../misc/jolt_stream_wrappers.h"
 #include "../objects/jolt_area_3d.h"
 #include "../objects/jolt_body_3d.h"
@@ -41,9 +42,11 @@
 #include "jolt_contact_listener_3d.h"
 #include "jolt_layers.h"
 #include "jolt_physics_direct_space_state_3d.h"
+#include "jolt_step_profiler.h"
 #include "jolt_temp_allocator.h"
 
 #include "core/io/file_access.h"
+#include "core/io/marshalls.h"
 #include "core/os/time.h"
 #include "core/string/print_string.h"
 #include "core/variant/variant_utility.h"
@@ -60,6 +63,98 @@ constexpr double DEFAULT_SLEEP_THRESHOLD_LINEAR = 0.1;
 constexpr double DEFAULT_SLEEP_THRESHOLD_ANGULAR = 8.0 * Math_tau_over_2 / 180;
 constexpr double DEFAULT_SOLVER_ITERATIONS = 8;
 
+// Saved states start with a header of four 32-bit values: magic, flags, body count and the size of the Jolt state.
+constexpr uint32_t STATE_MAGIC = 0x3153534a; // "JSS1"
+constexpr uint32_t STATE_FLAG_DELTA = 1 << 0;
+constexpr uint32_t STATE_HEADER_SIZE = 16;
+
+// Minimum number of bytes equal to the previous state worth encoding as a copy rather than as literal bytes.
+constexpr uint32_t STATE_DELTA_MIN_COPY = 8;
+
+bool read_state_header(const PackedByteArray &p_state, uint32_t &r_flags, uint32_t &r_body_count, uint32_t &r_size) {
+	if (p_state.size() < STATE_HEADER_SIZE) {
+		return false;
+	}
+
+	const uint8_t *data = p_state.ptr();
+
+	if (decode_uint32(data) != STATE_MAGIC) {
+		return false;
+	}
+
+	r_flags = decode_uint32(data + 4);
+	r_body_count = decode_uint32(data + 8);
+	r_size = decode_uint32(data + 12);
+
+	return true;
+}
+
+// Encodes the state as a sequence of operations, each copying a number of bytes from the previous state and then
+// appending a number of literal bytes. Bodies that didn't move between the two states turn into long copies.
+void encode_state_delta(const uint8_t *p_state, uint32_t p_size, const uint8_t *p_base, uint32_t p_base_size, LocalVector<uint8_t> &r_delta) {
+	uint32_t position = 0;
+
+	while (position < p_size) {
+		uint32_t copy_end = position;
+
+		while (copy_end < p_size && copy_end < p_base_size && p_state[copy_end] == p_base[copy_end]) {
+			copy_end++;
+		}
+
+		uint32_t literal_end = copy_end;
+		uint32_t matching = 0;
+
+		while (literal_end + matching < p_size && matching < STATE_DELTA_MIN_COPY) {
+			const uint32_t index = literal_end + matching;
+
+			if (index < p_base_size && p_state[index] == p_base[index]) {
+				matching++;
+			} else {
+				literal_end = index + 1;
+				matching = 0;
+			}
+		}
+
+		const uint32_t literal_size = literal_end - copy_end;
+		const uint32_t offset = r_delta.size();
+
+		r_delta.resize(offset + 8 + literal_size);
+		encode_uint32(copy_end - position, r_delta.ptr() + offset);
+		encode_uint32(literal_size, r_delta.ptr() + offset + 4);
+		memcpy(r_delta.ptr() + offset + 8, p_state + copy_end, literal_size);
+
+		position = literal_end;
+	}
+}
+
+bool decode_state_delta(const uint8_t *p_delta, uint32_t p_delta_size, const uint8_t *p_base, uint32_t p_base_size, uint8_t *r_state, uint32_t p_size) {
+	uint64_t read_position = 0;
+	uint64_t write_position = 0;
+
+	while (read_position < p_delta_size) {
+		if (read_position + 8 > p_delta_size) {
+			return false;
+		}
+
+		const uint32_t copy_size = decode_uint32(p_delta + read_position);
+		const uint32_t literal_size = decode_uint32(p_delta + read_position + 4);
+		read_position += 8;
+
+		if (write_position + copy_size > p_base_size || write_position + copy_size + literal_size > p_size || read_position + literal_size > p_delta_size) {
+			return false;
+		}
+
+		memcpy(r_state + write_position, p_base + write_position, copy_size);
+		write_position += copy_size;
+
+		memcpy(r_state + write_position, p_delta + read_position, literal_size);
+		write_position += literal_size;
+		read_position += literal_size;
+	}
+
+	return write_position == p_size;
+}
+
 } // namespace
 
 void JoltSpace3D::_pre_step(float p_step) {
@@ -117,6 +212,10 @@ JoltSpace3D::JoltSpace3D(JPH::JobSystem *p_job_system) :
 		layers(new JoltLayers()),
 		contact_listener(new JoltContactListener3D(this)),
 		physics_system(new JPH::PhysicsSystem()) {
+#ifdef THREADS_ENABLED
+	pipelined_step = JoltProjectSettings::use_pipelined_step();
+#endif
+
 	physics_system->Init((JPH::uint)JoltProjectSettings::get_max_bodies(), 0, (JPH::uint)JoltProjectSettings::get_max_pairs(), (JPH::uint)JoltProjectSettings::get_max_contact_constraints(), *layers, *layers, *layers);
 
 	JPH::PhysicsSettings settings;
@@ -176,13 +275,49 @@ JoltSpace3D::~JoltSpace3D() {
 	}
 }
 
+void JoltSpace3D::_wait_for_update() const {
+	if (unlikely(update_pending.is_set())) {
+		JoltPhysicsServer3D::get_singleton()->finish_pipelined_step();
+	}
+}
+
 void JoltSpace3D::step(float p_step) {
+	begin_step(p_step);
+	update();
+	end_step();
+}
+
+void JoltSpace3D::begin_step(float p_step) {
+	const uint64_t step_start = JoltStepProfiler::get_ticks();
+
 	stepping = true;
 	last_step = p_step;
 
 	_pre_step(p_step);
 
-	const JPH::EPhysicsUpdateError update_error = physics_system->Update(p_step, 1, temp_allocator, job_system);
+	step_time = JoltStepProfiler::get_ticks() - step_start;
+
+	if (pipelined_step) {
+		// The update itself happens on another thread, so let the calling thread keep using the space in the meantime,
+		// with any access to it waiting for the update to finish first.
+		update_pending.set();
+		stepping = false;
+	}
+}
+
+void JoltSpace3D::update() {
+	const uint64_t update_start = JoltStepProfiler::get_ticks();
+
+	update_error = physics_system->Update(last_step, 1, temp_allocator, job_system);
+
+	step_time += JoltStepProfiler::get_ticks() - update_start;
+}
+
+void JoltSpace3D::end_step() {
+	const uint64_t end_start = JoltStepProfiler::get_ticks();
+
+	stepping = true;
+	update_pending.clear();
 
 	if ((update_error & JPH::EPhysicsUpdateError::ManifoldCacheFull) != JPH::EPhysicsUpdateError::None) {
 		WARN_PRINT_ONCE(vformat("Jolt Physics manifold cache exceeded capacity and contacts were ignored. "
@@ -205,11 +340,13 @@ void JoltSpace3D::step(float p_step) {
 				JoltProjectSettings::get_max_contact_constraints()));
 	}
 
-	_post_step(p_step);
+	_post_step(last_step);
 
 	bodies_added_since_optimizing = 0;
 	has_stepped = true;
 	stepping = false;
+
+	step_time += JoltStepProfiler::get_ticks() - end_start;
 }
 
 void JoltSpace3D::call_queries() {
@@ -281,6 +418,8 @@ double JoltSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 }
 
 void JoltSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, double p_value) {
+	_wait_for_update();
+
 	switch (p_param) {
 		case PhysicsServer3D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS: {
 			WARN_PRINT("Space-specific contact recycle radius is not supported when using Jolt Physics. Any such value will be ignored.");
@@ -313,14 +452,17 @@ void JoltSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, double p_va
 }
 
 JPH::BodyInterface &JoltSpace3D::get_body_iface() {
+	_wait_for_update();
 	return physics_system->GetBodyInterfaceNoLock();
 }
 
 const JPH::BodyInterface &JoltSpace3D::get_body_iface() const {
+	_wait_for_update();
 	return physics_system->GetBodyInterfaceNoLock();
 }
 
 const JPH::BodyLockInterface &JoltSpace3D::get_lock_iface() const {
+	_wait_for_update();
 	return physics_system->GetBodyLockInterfaceNoLock();
 }
 
@@ -388,8 +530,34 @@ void JoltSpace3D::set_default_area(JoltArea3D *p_area) {
 	}
 }
 
+void JoltSpace3D::_add_batched_bodies(LocalVector<JPH::BodyID> &p_body_ids, JPH::EActivation p_activation) {
+	if (p_body_ids.is_empty()) {
+		return;
+	}
+
+	JPH::BodyInterface &body_iface = get_body_iface();
+
+	// Adding the bodies together builds a single balanced subtree in the broad phase, rather than one node per body.
+	const JPH::BodyInterface::AddState add_state = body_iface.AddBodiesPrepare(p_body_ids.ptr(), (int)p_body_ids.size());
+	body_iface.AddBodiesFinalize(p_body_ids.ptr(), (int)p_body_ids.size(), add_state, p_activation);
+
+	bodies_added_since_optimizing += 1;
+
+	p_body_ids.clear();
+}
+
 JPH::BodyID JoltSpace3D::add_rigid_body(const JoltObject3D &p_object, const JPH::BodyCreationSettings &p_settings, bool p_sleeping) {
-	const JPH::BodyID body_id = get_body_iface().CreateAndAddBody(p_settings, p_sleeping ? JPH::EActivation::DontActivate : JPH::EActivation::Activate);
+	JPH::BodyID body_id;
+
+	if (batching_bodies) {
+		const JPH::Body *jolt_body = get_body_iface().CreateBody(p_settings);
+		if (jolt_body != nullptr) {
+			body_id = jolt_body->GetID();
+			(p_sleeping ? batched_sleeping_bodies : batched_active_bodies).push_back(body_id);
+		}
+	} else {
+		body_id = get_body_iface().CreateAndAddBody(p_settings, p_sleeping ? JPH::EActivation::DontActivate : JPH::EActivation::Activate);
+	}
 
 	if (unlikely(body_id.IsInvalid())) {
 		ERR_PRINT_ONCE(vformat("Failed to create underlying Jolt Physics body for '%s'. "
@@ -400,7 +568,9 @@ JPH::BodyID JoltSpace3D::add_rigid_body(const JoltObject3D &p_object, const JPH:
 		return JPH::BodyID();
 	}
 
-	bodies_added_since_optimizing += 1;
+	if (!batching_bodies) {
+		bodies_added_since_optimizing += 1;
+	}
 
 	return body_id;
 }
@@ -429,7 +599,28 @@ void JoltSpace3D::remove_body(const JPH::BodyID &p_body_id) {
 	body_iface.DestroyBody(p_body_id);
 }
 
+void JoltSpace3D::begin_body_batch() {
+	ERR_FAIL_COND(batching_bodies);
+	batching_bodies = true;
+}
+
+void JoltSpace3D::end_body_batch() {
+	ERR_FAIL_COND(!batching_bodies);
+	batching_bodies = false;
+
+	_add_batched_bodies(batched_active_bodies, JPH::EActivation::Activate);
+	_add_batched_bodies(batched_sleeping_bodies, JPH::EActivation::DontActivate);
+
+	for (JoltObject3D *object : batched_objects) {
+		object->finish_batched_add();
+	}
+
+	batched_objects.clear();
+}
+
 void JoltSpace3D::try_optimize() {
+	_wait_for_update();
+
 	// This makes assumptions about the underlying acceleration structure of Jolt's broad-phase, which currently uses a
 	// quadtree, and which gets walked with a fixed-size node stack of 128. This means that when the quadtree is
 	// completely unbalanced, as is the case if we add bodies one-by-one without ever stepping the simulation, like in
@@ -446,6 +637,7 @@ void JoltSpace3D::try_optimize() {
 }
 
 void JoltSpace3D::add_joint(JPH::Constraint *p_jolt_ref) {
+	_wait_for_update();
 	physics_system->AddConstraint(p_jolt_ref);
 }
 
@@ -454,6 +646,7 @@ void JoltSpace3D::add_joint(JoltJoint3D *p_joint) {
 }
 
 void JoltSpace3D::remove_joint(JPH::Constraint *p_jolt_ref) {
+	_wait_for_update();
 	physics_system->RemoveConstraint(p_jolt_ref);
 }
 
@@ -461,6 +654,108 @@ void JoltSpace3D::remove_joint(JoltJoint3D *p_joint) {
 	remove_joint(p_joint->get_jolt_ref());
 }
 
+PackedByteArray JoltSpace3D::save_state(const PackedByteArray &p_previous_state) const {
+	ERR_FAIL_COND_V_MSG(stepping, PackedByteArray(), "Saving the state of a physics space is not allowed while it's being stepped.");
+
+	const JPH::PhysicsSystem &system = get_physics_system();
+
+	JoltStateRecorder recorder;
+	recorder.get_buffer().reserve(MAX(p_previous_state.size(), (int64_t)STATE_HEADER_SIZE));
+	system.SaveState(recorder);
+
+	const LocalVector<uint8_t> &state = recorder.get_buffer();
+
+	uint32_t flags = 0;
+	LocalVector<uint8_t> delta;
+
+	if (!p_previous_state.is_empty()) {
+		uint32_t base_flags = 0;
+		uint32_t base_body_count = 0;
+		uint32_t base_size = 0;
+		ERR_FAIL_COND_V_MSG(!read_state_header(p_previous_state, base_flags, base_body_count, base_size), PackedByteArray(), "Failed to save physics space state. The previous state is not a valid physics space state.");
+		ERR_FAIL_COND_V_MSG((base_flags & STATE_FLAG_DELTA) != 0 || p_previous_state.size() != STATE_HEADER_SIZE + base_size, PackedByteArray(), "Failed to save physics space state. The previous state must be a full state, not a delta-encoded one.");
+
+		delta.reserve(state.size() / 4);
+		encode_state_delta(state.ptr(), state.size(), p_previous_state.ptr() + STATE_HEADER_SIZE, base_size, delta);
+
+		// Fall back to a full state in the rare case where nearly everything changed.
+		if (delta.size() < state.size()) {
+			flags |= STATE_FLAG_DELTA;
+		}
+	}
+
+	const LocalVector<uint8_t> &payload = (flags & STATE_FLAG_DELTA) != 0 ? delta : state;
+
+	PackedByteArray result;
+	result.resize(STATE_HEADER_SIZE + payload.size());
+
+	uint8_t *result_ptr = result.ptrw();
+	encode_uint32(STATE_MAGIC, result_ptr);
+	encode_uint32(flags, result_ptr + 4);
+	encode_uint32(system.GetNumBodies(), result_ptr + 8);
+	encode_uint32(state.size(), result_ptr + 12);
+	memcpy(result_ptr + STATE_HEADER_SIZE, payload.ptr(), payload.size());
+
+	return result;
+}
+
+bool JoltSpace3D::restore_state(const PackedByteArray &p_state, const PackedByteArray &p_previous_state) {
+	ERR_FAIL_COND_V_MSG(stepping, false, "Restoring the state of a physics space is not allowed while it's being stepped.");
+
+	uint32_t flags = 0;
+	uint32_t body_count = 0;
+	uint32_t size = 0;
+	ERR_FAIL_COND_V_MSG(!read_state_header(p_state, flags, body_count, size), false, "Failed to restore physics space state. The data is not a valid physics space state.");
+
+	JPH::PhysicsSystem &system = get_physics_system();
+	ERR_FAIL_COND_V_MSG(body_count != system.GetNumBodies(), false, vformat("Failed to restore physics space state. It was saved with %d bodies, but the space currently has %d. Bodies must not be added or removed between saving and restoring.", body_count, system.GetNumBodies()));
+
+	const uint8_t *payload = p_state.ptr() + STATE_HEADER_SIZE;
+	const uint32_t payload_size = (uint32_t)(p_state.size() - STATE_HEADER_SIZE);
+
+	JoltStateRecorder recorder;
+	LocalVector<uint8_t> &state = recorder.get_buffer();
+
+	if ((flags & STATE_FLAG_DELTA) != 0) {
+		uint32_t base_flags = 0;
+		uint32_t base_body_count = 0;
+		uint32_t base_size = 0;
+		ERR_FAIL_COND_V_MSG(!read_state_header(p_previous_state, base_flags, base_body_count, base_size) || (base_flags & STATE_FLAG_DELTA) != 0 || p_previous_state.size() != STATE_HEADER_SIZE + base_size, false, "Failed to restore physics space state. Restoring a delta-encoded state requires the full state it was encoded against.");
+
+		// Every byte of the state is either copied from the previous state or stored in the delta, which bounds its size
+		// before anything gets allocated for it.
+		ERR_FAIL_COND_V_MSG((uint64_t)size > (uint64_t)base_size + payload_size, false, "Failed to restore physics space state. The data is corrupted.");
+
+		state.resize(size);
+		ERR_FAIL_COND_V_MSG(!decode_state_delta(payload, payload_size, p_previous_state.ptr() + STATE_HEADER_SIZE, base_size, state.ptr(), size), false, "Failed to restore physics space state. The delta-encoded state does not match the given previous state.");
+	} else {
+		ERR_FAIL_COND_V_MSG(payload_size != size, false, "Failed to restore physics space state. The data is truncated.");
+		state.resize(size);
+		memcpy(state.ptr(), payload, size);
+	}
+
+	const bool restored = system.RestoreState(recorder);
+	ERR_FAIL_COND_V_MSG(!restored || recorder.IsFailed(), false, "Failed to restore physics space state. Jolt Physics rejected the state, which likely means that the bodies in the space have changed since it was saved.");
+
+	// Bodies that were asleep before or after restoring would otherwise never report their new transform.
+	body_accessor.acquire_all();
+
+	const int accessed_count = body_accessor.get_count();
+
+	for (int i = 0; i < accessed_count; ++i) {
+		if (JPH::Body *jolt_body = body_accessor.try_get(i)) {
+			if (!jolt_body->IsSensor() && !jolt_body->IsSoftBody()) {
+				JoltBody3D *body = reinterpret_cast<JoltBody3D *>(jolt_body->GetUserData());
+				body->request_state_sync();
+			}
+		}
+	}
+
+	body_accessor.release();
+
+	return true;
+}
+
 #ifdef DEBUG_ENABLED
 
 void JoltSpace3D::dump_debug_snapshot(const String &p_dir) {
@@ -33,6 +33,7 @@
 
 #include "jolt_body_accessor_3d.h"
 
+#include "core/templates/safe_refcount.h"
 #include "servers/physics_server_3d.h"
 
 #include "Jolt/Jolt.h"
@@ -67,13 +68,28 @@ class JoltSpace3D {
 	JoltPhysicsDirectSpaceState3D *direct_state = nullptr;
 	JoltArea3D *default_area = nullptr;
 
+	LocalVector<JPH::BodyID> batched_active_bodies;
+	LocalVector<JPH::BodyID> batched_sleeping_bodies;
+	LocalVector<JoltObject3D *> batched_objects;
+
+	JPH::EPhysicsUpdateError update_error = JPH::EPhysicsUpdateError::None;
+
 	float last_step = 0.0f;
 
+	uint64_t step_time = 0;
+
 	int bodies_added_since_optimizing = 0;
 
 	bool active = false;
 	bool stepping = false;
 	bool has_stepped = false;
+	bool pipelined_step = false;
+	SafeFlag update_pending;
+	bool batching_bodies = false;
+
+	void _wait_for_update() const;
+
+	void _add_batched_bodies(LocalVector<JPH::BodyID> &p_body_ids, JPH::EActivation p_activation);
 
 	void _pre_step(float p_step);
 	void _post_step(float p_step);
@@ -84,6 +100,10 @@ public:
 
 	void step(float p_step);
 
+	void begin_step(float p_step);
+	void update();
+	void end_step();
+
 	void call_queries();
 
 	RID get_rid() const { return rid; }
@@ -93,11 +113,16 @@ public:
 	void set_active(bool p_active) { active = p_active; }
 
 	bool is_stepping() const { return stepping; }
+	bool is_step_pipelined() const { return pipelined_step; }
+	bool is_update_pending() const { return update_pending.is_set(); }
 
 	double get_param(PhysicsServer3D::SpaceParameter p_param) const;
 	void set_param(PhysicsServer3D::SpaceParameter p_param, double p_value);
 
-	JPH::PhysicsSystem &get_physics_system() const { return *physics_system; }
+	JPH::PhysicsSystem &get_physics_system() const {
+		_wait_for_update();
+		return *physics_system;
+	}
 
 	JPH::BodyInterface &get_body_iface();
 	const JPH::BodyInterface &get_body_iface() const;
@@ -124,12 +149,18 @@ public:
 	void set_default_area(JoltArea3D *p_area);
 
 	float get_last_step() const { return last_step; }
+	uint64_t get_step_time() const { return step_time; }
 
 	JPH::BodyID add_rigid_body(const JoltObject3D &p_object, const JPH::BodyCreationSettings &p_settings, bool p_sleeping = false);
 	JPH::BodyID add_soft_body(const JoltObject3D &p_object, const JPH::SoftBodyCreationSettings &p_settings, bool p_sleeping = false);
 
 	void remove_body(const JPH::BodyID &p_body_id);
 
+	void begin_body_batch();
+	void end_body_batch();
+	bool is_batching_bodies() const { return batching_bodies; }
+	void defer_batched_add(JoltObject3D *p_object) { batched_objects.push_back(p_object); }
+
 	void try_optimize();
 
 	void add_joint(JPH::Constraint *p_jolt_ref);
@@ -137,6 +168,9 @@ public:
 	void remove_joint(JPH::Constraint *p_jolt_ref);
 	void remove_joint(JoltJoint3D *p_joint);
 
+	PackedByteArray save_state(const PackedByteArray &p_previous_state) const;
+	bool restore_state(const PackedByteArray &p_state, const PackedByteArray &p_previous_state);
+
 #ifdef DEBUG_ENABLED
 	void dump_debug_snapshot(const String &p_dir);
 	const PackedVector3Array &get_debug_contacts() const;
@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  jolt_step_profiler.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "jolt_step_profiler.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/error/error_macros.h"
+#include "core/os/time.h"
+#include "core/variant/array.h"
+
+#include <string.h>
+
+namespace {
+
+struct JobStage {
+	const char *job_name = nullptr;
+	JoltStepProfiler::Stage stage = JoltStepProfiler::STAGE_SOLVER;
+};
+
+// Any job not listed here is considered part of the solver, which covers island building, constraint setup and
+// solving, integration and CCD resolution. Contact listener callbacks invoked by Jolt run as part of the narrowphase
+// jobs, so the contact callback stage only covers contact removal and our own flushing of the collected contacts.
+constexpr JobStage JOB_STAGES[] = {
+	{ "UpdateBroadPhasePrepare", JoltStepProfiler::STAGE_BROADPHASE },
+	{ "UpdateBroadPhaseFinalize", JoltStepProfiler::STAGE_BROADPHASE },
+	{ "FindCollisions", JoltStepProfiler::STAGE_NARROWPHASE },
+	{ "FindCCDContacts", JoltStepProfiler::STAGE_NARROWPHASE },
+	{ "SoftBodyCollide", JoltStepProfiler::STAGE_NARROWPHASE },
+	{ "ContactRemovedCallbacks", JoltStepProfiler::STAGE_CONTACT_CALLBACKS },
+};
+
+} // namespace
+
+JoltStepProfiler::Stage JoltStepProfiler::get_job_stage(const char *p_job_name) {
+	if (p_job_name == nullptr) {
+		return STAGE_SOLVER;
+	}
+
+	for (const JobStage &job_stage : JOB_STAGES) {
+		if (strcmp(job_stage.job_name, p_job_name) == 0) {
+			return job_stage.stage;
+		}
+	}
+
+	return STAGE_SOLVER;
+}
+
+const char *JoltStepProfiler::get_stage_name(Stage p_stage) {
+	static const char *names[STAGE_MAX] = {
+		"Broadphase",
+		"Narrowphase",
+		"Solver",
+		"Contact Callbacks",
+		"Area Overlaps",
+		"Call Queries",
+	};
+
+	ERR_FAIL_INDEX_V(p_stage, STAGE_MAX, "");
+	return names[p_stage];
+}
+
+uint64_t JoltStepProfiler::get_ticks() {
+	return Time::get_singleton()->get_ticks_usec();
+}
+
+uint64_t JoltStepProfiler::get_last_time(Stage p_stage) {
+	ERR_FAIL_INDEX_V(p_stage, STAGE_MAX, 0);
+	return last_stage_timings[p_stage];
+}
+
+void JoltStepProfiler::flush() {
+	for (int i = 0; i < STAGE_MAX; ++i) {
+		last_stage_timings[i] = stage_timings[i].exchange(0, std::memory_order_relaxed);
+	}
+
+#ifdef DEBUG_ENABLED
+	static const StringName profiler_name("servers");
+
+	if (EngineDebugger::is_profiling(profiler_name)) {
+		Array timings;
+		timings.push_back("physics_3d_step");
+
+		for (int i = 0; i < STAGE_MAX; ++i) {
+			timings.push_back(get_stage_name((Stage)i));
+			timings.push_back(USEC_TO_SEC(last_stage_timings[i]));
+		}
+
+		EngineDebugger::profiler_add_frame_data(profiler_name, timings);
+	}
+#endif
+}
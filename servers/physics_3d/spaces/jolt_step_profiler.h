@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  jolt_step_profiler.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JOLT_STEP_PROFILER_H
+#define JOLT_STEP_PROFILER_H
+
+#include "core/typedefs.h"
+
+#include <stdint.h>
+#include <atomic>
+
+class JoltStepProfiler {
+public:
+	enum Stage {
+		STAGE_BROADPHASE,
+		STAGE_NARROWPHASE,
+		STAGE_SOLVER,
+		STAGE_CONTACT_CALLBACKS,
+		STAGE_AREA_OVERLAPS,
+		STAGE_CALL_QUERIES,
+		STAGE_MAX
+	};
+
+private:
+	// Accumulated across all spaces and threads, in microseconds, so the stages that run as jobs report CPU time rather
+	// than wall time.
+	inline static std::atomic<uint64_t> stage_timings[STAGE_MAX];
+	inline static uint64_t last_stage_timings[STAGE_MAX] = {};
+
+public:
+	static Stage get_job_stage(const char *p_job_name);
+	static const char *get_stage_name(Stage p_stage);
+
+	static uint64_t get_ticks();
+
+	_FORCE_INLINE_ static void add_time(Stage p_stage, uint64_t p_usec) { stage_timings[p_stage].fetch_add(p_usec, std::memory_order_relaxed); }
+	_FORCE_INLINE_ static void add_time_since(Stage p_stage, uint64_t p_ticks_start) { add_time(p_stage, get_ticks() - p_ticks_start); }
+
+	static uint64_t get_last_time(Stage p_stage);
+
+	static void flush();
+};
+
+#endif // JOLT_STEP_PROFILER_H
@@ -435,6 +435,95 @@ Vector<real_t> PhysicsDirectSpaceState3D::_cast_motion(const Ref<PhysicsShapeQue
 	return ret;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The 'from' and 'to' arrays must have the same size.");
+
+	const int ray_count = p_from.size();
+
+	Vector<RayResult> results;
+	results.resize(ray_count);
+	Vector<bool> hits;
+	hits.resize(ray_count);
+
+	const int hit_count = intersect_rays_batch(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), ray_count, results.ptrw(), hits.ptrw());
+
+	PackedByteArray hit;
+	PackedVector3Array position;
+	PackedVector3Array normal;
+	PackedInt64Array collider_id;
+	PackedInt32Array shape;
+	PackedInt32Array face_index;
+	hit.resize(ray_count);
+	position.resize(ray_count);
+	normal.resize(ray_count);
+	collider_id.resize(ray_count);
+	shape.resize(ray_count);
+	face_index.resize(ray_count);
+
+	uint8_t *hit_w = hit.ptrw();
+	Vector3 *position_w = position.ptrw();
+	Vector3 *normal_w = normal.ptrw();
+	int64_t *collider_id_w = collider_id.ptrw();
+	int32_t *shape_w = shape.ptrw();
+	int32_t *face_index_w = face_index.ptrw();
+
+	for (int i = 0; i < ray_count; i++) {
+		if (hits[i]) {
+			const RayResult &result = results[i];
+			hit_w[i] = 1;
+			position_w[i] = result.position;
+			normal_w[i] = result.normal;
+			collider_id_w[i] = (int64_t)result.collider_id;
+			shape_w[i] = result.shape;
+			face_index_w[i] = result.face_index;
+		} else {
+			hit_w[i] = 0;
+			position_w[i] = Vector3();
+			normal_w[i] = Vector3();
+			collider_id_w[i] = 0;
+			shape_w[i] = 0;
+			face_index_w[i] = -1;
+		}
+	}
+
+	Dictionary d;
+	d["hit_count"] = hit_count;
+	d["hit"] = hit;
+	d["position"] = position;
+	d["normal"] = normal;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+	d["face_index"] = face_index;
+
+	return d;
+}
+
+PackedVector2Array PhysicsDirectSpaceState3D::_cast_motion_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), PackedVector2Array());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_motions.size(), PackedVector2Array(), "The 'origins' and 'motions' arrays must have the same size.");
+
+	const int count = p_origins.size();
+
+	Vector<real_t> closest_safe;
+	Vector<real_t> closest_unsafe;
+	closest_safe.resize(count);
+	closest_unsafe.resize(count);
+
+	bool res = cast_motion_batch(p_shape_query->get_parameters(), p_origins.ptr(), p_motions.ptr(), count, closest_safe.ptrw(), closest_unsafe.ptrw());
+	if (!res) {
+		return PackedVector2Array();
+	}
+
+	PackedVector2Array ret;
+	ret.resize(count);
+	Vector2 *ret_w = ret.ptrw();
+	for (int i = 0; i < count; i++) {
+		ret_w[i] = Vector2(closest_safe[i], closest_unsafe[i]);
+	}
+	return ret;
+}
+
 TypedArray<Vector3> PhysicsDirectSpaceState3D::_collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results) {
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), TypedArray<Vector3>());
 
@@ -474,6 +563,38 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+int PhysicsDirectSpaceState3D::intersect_rays_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	int hit_count = 0;
+
+	for (int i = 0; i < p_ray_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
+bool PhysicsDirectSpaceState3D::cast_motion_batch(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform.origin = p_origins[i];
+		parameters.motion = p_motions[i];
+		r_closest_safe[i] = 1.0f;
+		r_closest_unsafe[i] = 1.0f;
+		if (!cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
@@ -482,6 +603,8 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
+	ClassDB::bind_method(D_METHOD("intersect_rays_batch", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays_batch);
+	ClassDB::bind_method(D_METHOD("cast_motion_batch", "parameters", "origins", "motions"), &PhysicsDirectSpaceState3D::_cast_motion_batch);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
 }
@@ -660,6 +783,97 @@ bool PhysicsServer3D::_body_test_motion(RID p_body, const Ref<PhysicsTestMotionP
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+TypedArray<RID> PhysicsServer3D::_body_create_batch(RID p_space, BodyMode p_mode, RID p_shape, const TypedArray<Transform3D> &p_transforms, uint32_t p_collision_layer, uint32_t p_collision_mask) {
+	Vector<Transform3D> transforms;
+	transforms.resize(p_transforms.size());
+	for (int i = 0; i < p_transforms.size(); i++) {
+		transforms.write[i] = p_transforms[i];
+	}
+
+	const Vector<RID> bodies = body_create_batch(p_space, p_mode, p_shape, transforms, p_collision_layer, p_collision_mask);
+
+	TypedArray<RID> ret;
+	ret.resize(bodies.size());
+	for (int i = 0; i < bodies.size(); i++) {
+		ret[i] = bodies[i];
+	}
+	return ret;
+}
+
+Vector<RID> PhysicsServer3D::body_create_batch(RID p_space, BodyMode p_mode, RID p_shape, const Vector<Transform3D> &p_transforms, uint32_t p_collision_layer, uint32_t p_collision_mask) {
+	Vector<RID> bodies;
+	bodies.resize(p_transforms.size());
+
+	for (int i = 0; i < p_transforms.size(); i++) {
+		const RID body = body_create();
+		body_set_mode(body, p_mode);
+		if (p_shape.is_valid()) {
+			body_add_shape(body, p_shape);
+		}
+		body_set_collision_layer(body, p_collision_layer);
+		body_set_collision_mask(body, p_collision_mask);
+		body_set_state(body, BODY_STATE_TRANSFORM, p_transforms[i]);
+		body_set_space(body, p_space);
+		bodies.write[i] = body;
+	}
+
+	return bodies;
+}
+
+void PhysicsServer3D::heightmap_shape_update_region(RID p_shape, const Rect2i &p_region, const Vector<real_t> &p_heights) {
+	ERR_FAIL_COND(shape_get_type(p_shape) != SHAPE_HEIGHTMAP);
+
+	Dictionary data = shape_get_data(p_shape);
+
+	const int width = data["width"];
+	const int depth = data["depth"];
+	Vector<real_t> heights = data["heights"];
+
+	ERR_FAIL_COND(p_region.size.x <= 0 || p_region.size.y <= 0);
+	ERR_FAIL_COND_MSG(!Rect2i(0, 0, width, depth).encloses(p_region), "The region must lie within the height map.");
+	ERR_FAIL_COND_MSG(p_heights.size() != p_region.size.x * p_region.size.y, "Height count must be the product of the region's width and depth.");
+
+	real_t min_height = data.get("min_height", 0.0);
+	real_t max_height = data.get("max_height", 0.0);
+
+	real_t *heights_ptr = heights.ptrw();
+	const real_t *region_ptr = p_heights.ptr();
+
+	for (int z = 0; z < p_region.size.y; ++z) {
+		for (int x = 0; x < p_region.size.x; ++x) {
+			const real_t height = region_ptr[z * p_region.size.x + x];
+			heights_ptr[(p_region.position.y + z) * width + (p_region.position.x + x)] = height;
+			min_height = MIN(min_height, height);
+			max_height = MAX(max_height, height);
+		}
+	}
+
+	data["heights"] = heights;
+
+	if (data.has("min_height")) {
+		data["min_height"] = min_height;
+		data["max_height"] = max_height;
+	}
+
+	shape_set_data(p_shape, data);
+}
+
+void PhysicsServer3D::area_set_monitor_batching(RID p_area, bool p_enable) {
+	ERR_FAIL_MSG("Batched area monitoring is not supported by this physics server.");
+}
+
+double PhysicsServer3D::space_get_step_time(RID p_space) const {
+	ERR_FAIL_V_MSG(0.0, "Per-space step timings are not supported by this physics server.");
+}
+
+PackedByteArray PhysicsServer3D::space_save_state(RID p_space, const PackedByteArray &p_previous_state) const {
+	ERR_FAIL_V_MSG(PackedByteArray(), "Saving the state of a physics space is not supported by this physics server.");
+}
+
+bool PhysicsServer3D::space_restore_state(RID p_space, const PackedByteArray &p_state, const PackedByteArray &p_previous_state) {
+	ERR_FAIL_V_MSG(false, "Restoring the state of a physics space is not supported by this physics server.");
+}
+
 RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	switch (p_shape) {
 		case SHAPE_WORLD_BOUNDARY:
@@ -706,12 +920,17 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("shape_get_data", "shape"), &PhysicsServer3D::shape_get_data);
 	ClassDB::bind_method(D_METHOD("shape_get_margin", "shape"), &PhysicsServer3D::shape_get_margin);
 
+	ClassDB::bind_method(D_METHOD("heightmap_shape_update_region", "shape", "region", "heights"), &PhysicsServer3D::heightmap_shape_update_region);
+
 	ClassDB::bind_method(D_METHOD("space_create"), &PhysicsServer3D::space_create);
 	ClassDB::bind_method(D_METHOD("space_set_active", "space", "active"), &PhysicsServer3D::space_set_active);
 	ClassDB::bind_method(D_METHOD("space_is_active", "space"), &PhysicsServer3D::space_is_active);
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space", "previous_state"), &PhysicsServer3D::space_save_state, DEFVAL(PackedByteArray()));
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state", "previous_state"), &PhysicsServer3D::space_restore_state, DEFVAL(PackedByteArray()));
+	ClassDB::bind_method(D_METHOD("space_get_step_time", "space"), &PhysicsServer3D::space_get_step_time);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -746,11 +965,13 @@ void PhysicsServer3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("area_set_monitor_callback", "area", "callback"), &PhysicsServer3D::area_set_monitor_callback);
 	ClassDB::bind_method(D_METHOD("area_set_area_monitor_callback", "area", "callback"), &PhysicsServer3D::area_set_area_monitor_callback);
+	ClassDB::bind_method(D_METHOD("area_set_monitor_batching", "area", "enable"), &PhysicsServer3D::area_set_monitor_batching);
 	ClassDB::bind_method(D_METHOD("area_set_monitorable", "area", "monitorable"), &PhysicsServer3D::area_set_monitorable);
 
 	ClassDB::bind_method(D_METHOD("area_set_ray_pickable", "area", "enable"), &PhysicsServer3D::area_set_ray_pickable);
 
 	ClassDB::bind_method(D_METHOD("body_create"), &PhysicsServer3D::body_create);
+	ClassDB::bind_method(D_METHOD("body_create_batch", "space", "mode", "shape", "transforms", "collision_layer", "collision_mask"), &PhysicsServer3D::_body_create_batch, DEFVAL(1), DEFVAL(1));
 
 	ClassDB::bind_method(D_METHOD("body_set_space", "body", "space"), &PhysicsServer3D::body_set_space);
 	ClassDB::bind_method(D_METHOD("body_get_space", "body"), &PhysicsServer3D::body_get_space);
@@ -1097,6 +1318,12 @@ void PhysicsServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_BROADPHASE_TIME);
+	BIND_ENUM_CONSTANT(INFO_NARROWPHASE_TIME);
+	BIND_ENUM_CONSTANT(INFO_SOLVER_TIME);
+	BIND_ENUM_CONSTANT(INFO_CONTACT_CALLBACKS_TIME);
+	BIND_ENUM_CONSTANT(INFO_AREA_OVERLAPS_TIME);
+	BIND_ENUM_CONSTANT(INFO_CALL_QUERIES_TIME);
 
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_MAX_SEPARATION);
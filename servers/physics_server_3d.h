@@ -125,6 +125,8 @@ private:
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
+	Dictionary _intersect_rays_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
+	PackedVector2Array _cast_motion_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions);
 	TypedArray<Vector3> _collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
 
@@ -159,6 +161,10 @@ public:
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
 
+	// Casts `p_ray_count` rays sharing the filtering options of `p_parameters`, using `p_from` and `p_to` instead of its endpoints.
+	// `r_hits[i]` tells whether `r_results[i]` is valid. Returns the number of rays that hit something.
+	virtual int intersect_rays_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits);
+
 	struct ShapeResult {
 		RID rid;
 		ObjectID collider_id;
@@ -200,6 +206,8 @@ public:
 
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) = 0;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) = 0;
+	// Casts the shape of `p_parameters` from each of `p_origins` along the matching `p_motions`, keeping the basis of its transform.
+	virtual bool cast_motion_batch(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
@@ -240,6 +248,10 @@ protected:
 
 public:
 	static PhysicsServer3D *get_singleton();
+#ifdef TESTS_ENABLED
+	// Creating another server replaces the singleton, tests use this to restore the previous one.
+	static void set_singleton_for_tests(PhysicsServer3D *p_singleton) { singleton = p_singleton; }
+#endif
 
 	enum ShapeType {
 		SHAPE_WORLD_BOUNDARY, ///< plane:"plane"
@@ -279,6 +291,8 @@ public:
 
 	virtual real_t shape_get_custom_solver_bias(RID p_shape) const = 0;
 
+	virtual void heightmap_shape_update_region(RID p_shape, const Rect2i &p_region, const Vector<real_t> &p_heights);
+
 	/* SPACE API */
 
 	virtual RID space_create() = 0;
@@ -306,6 +320,11 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual PackedByteArray space_save_state(RID p_space, const PackedByteArray &p_previous_state = PackedByteArray()) const;
+	virtual bool space_restore_state(RID p_space, const PackedByteArray &p_state, const PackedByteArray &p_previous_state = PackedByteArray());
+
+	virtual double space_get_step_time(RID p_space) const;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -374,6 +393,7 @@ public:
 
 	virtual void area_set_monitor_callback(RID p_area, const Callable &p_callback) = 0;
 	virtual void area_set_area_monitor_callback(RID p_area, const Callable &p_callback) = 0;
+	virtual void area_set_monitor_batching(RID p_area, bool p_enable);
 
 	virtual void area_set_ray_pickable(RID p_area, bool p_enable) = 0;
 
@@ -395,6 +415,14 @@ public:
 
 	virtual RID body_create() = 0;
 
+	// Creates one body per transform, all sharing the given mode, shape and collision layers, and adds them to the space in one go.
+	virtual Vector<RID> body_create_batch(RID p_space, BodyMode p_mode, RID p_shape, const Vector<Transform3D> &p_transforms, uint32_t p_collision_layer = 1, uint32_t p_collision_mask = 1);
+
+private:
+	TypedArray<RID> _body_create_batch(RID p_space, BodyMode p_mode, RID p_shape, const TypedArray<Transform3D> &p_transforms, uint32_t p_collision_layer = 1, uint32_t p_collision_mask = 1);
+
+public:
+
 	virtual void body_set_space(RID p_body, RID p_space) = 0;
 	virtual RID body_get_space(RID p_body) const = 0;
 
@@ -567,6 +595,33 @@ public:
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) = 0;
 
+	struct CharacterMotionParameters {
+		Transform3D from;
+		Vector3 velocity;
+		real_t delta = 0.0;
+		real_t margin = 0.001;
+		Vector3 up_direction = Vector3(0.0, 1.0, 0.0);
+		real_t floor_max_angle = Math::deg_to_rad((real_t)45.0);
+		real_t floor_snap_length = 0.0;
+		int max_slides = 6;
+		HashSet<RID> exclude_bodies;
+		HashSet<ObjectID> exclude_objects;
+	};
+
+	struct CharacterMotionResult {
+		Transform3D transform;
+		Vector3 travel;
+		Vector3 velocity;
+
+		static const int MAX_COLLISIONS = 32;
+		MotionCollision collisions[MAX_COLLISIONS];
+		int collision_count = 0;
+	};
+
+	// Moves a kinematic body with a native character controller, in a single call rather than one motion test per slide.
+	// Returns false if the server has no such controller, in which case callers should fall back to `body_test_motion`.
+	virtual bool body_move_character(RID p_body, const CharacterMotionParameters &p_parameters, CharacterMotionResult *r_result) { return false; }
+
 	/* SOFT BODY */
 
 	virtual RID soft_body_create() = 0;
@@ -805,7 +860,13 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_BROADPHASE_TIME,
+		INFO_NARROWPHASE_TIME,
+		INFO_SOLVER_TIME,
+		INFO_CONTACT_CALLBACKS_TIME,
+		INFO_AREA_OVERLAPS_TIME,
+		INFO_CALL_QUERIES_TIME,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
@@ -32,6 +32,81 @@
 
 #include "core/os/os.h"
 
+Variant PhysicsServer3DWrapMT::BodyStateMirror::get(BodyState p_state) const {
+	switch (p_state) {
+		case BODY_STATE_TRANSFORM:
+			return transform;
+		case BODY_STATE_LINEAR_VELOCITY:
+			return linear_velocity;
+		case BODY_STATE_ANGULAR_VELOCITY:
+			return angular_velocity;
+		case BODY_STATE_SLEEPING:
+			return sleeping;
+		case BODY_STATE_CAN_SLEEP:
+			return can_sleep;
+	}
+
+	return Variant();
+}
+
+bool PhysicsServer3DWrapMT::BodyStateMirror::set(BodyState p_state, const Variant &p_value) {
+	// Values of an unexpected type are left to the server, so that it can report them.
+	switch (p_state) {
+		case BODY_STATE_TRANSFORM: {
+			if (p_value.get_type() != Variant::TRANSFORM3D) {
+				return false;
+			}
+			transform = p_value;
+		} break;
+		case BODY_STATE_LINEAR_VELOCITY: {
+			if (p_value.get_type() != Variant::VECTOR3) {
+				return false;
+			}
+			linear_velocity = p_value;
+		} break;
+		case BODY_STATE_ANGULAR_VELOCITY: {
+			if (p_value.get_type() != Variant::VECTOR3) {
+				return false;
+			}
+			angular_velocity = p_value;
+		} break;
+		case BODY_STATE_SLEEPING: {
+			if (p_value.get_type() != Variant::BOOL) {
+				return false;
+			}
+			sleeping = p_value;
+		} break;
+		case BODY_STATE_CAN_SLEEP: {
+			if (p_value.get_type() != Variant::BOOL) {
+				return false;
+			}
+			can_sleep = p_value;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void PhysicsServer3DWrapMT::PendingBodyState::add(BodyState p_state) {
+	if (mask & (1 << p_state)) {
+		// Only the last write is applied, so it takes the place of the earlier one in the order.
+		uint32_t i = 0;
+		while (order[i] != p_state) {
+			++i;
+		}
+		for (; i + 1 < order_count; ++i) {
+			order[i] = order[i + 1];
+		}
+		order_count--;
+	}
+
+	mask |= 1 << p_state;
+	order[order_count++] = p_state;
+}
+
 void PhysicsServer3DWrapMT::_assign_mt_ids(WorkerThreadPool::TaskID p_pump_task_id) {
 	server_thread = Thread::get_caller_id();
 	server_task_id = p_pump_task_id;
@@ -41,6 +116,16 @@ void PhysicsServer3DWrapMT::_thread_exit() {
 	exit = true;
 }
 
+void PhysicsServer3DWrapMT::_thread_step(real_t p_delta, uint64_t p_serial) {
+	physics_server_3d->step(p_delta);
+	_publish_body_states(p_serial);
+}
+
+void PhysicsServer3DWrapMT::_thread_free(RID p_rid) {
+	mirrored_bodies.remove(p_rid);
+	physics_server_3d->free(p_rid);
+}
+
 void PhysicsServer3DWrapMT::_thread_loop() {
 	while (!exit) {
 		WorkerThreadPool::get_singleton()->yield();
@@ -48,11 +133,138 @@ void PhysicsServer3DWrapMT::_thread_loop() {
 	}
 }
 
+/* BODY STATE MIRROR */
+
+void PhysicsServer3DWrapMT::_mirror_body_state(RID p_body) {
+	if (physics_server_3d->body_get_state(p_body, BODY_STATE_TRANSFORM).get_type() == Variant::NIL) {
+		return; // Not a body, which has already been reported.
+	}
+
+	mirrored_bodies.set(p_body, true);
+}
+
+void PhysicsServer3DWrapMT::_publish_body_states(uint64_t p_serial) {
+	OAHashMap<RID, BodyStateMirror> &buffer = body_state_buffers[body_state_write_index];
+	buffer.clear();
+
+	for (OAHashMap<RID, bool>::Iterator it = mirrored_bodies.iter(); it.valid; it = mirrored_bodies.next_iter(it)) {
+		const RID &body = *it.key;
+
+		BodyStateMirror mirror;
+		mirror.transform = physics_server_3d->body_get_state(body, BODY_STATE_TRANSFORM);
+		mirror.linear_velocity = physics_server_3d->body_get_state(body, BODY_STATE_LINEAR_VELOCITY);
+		mirror.angular_velocity = physics_server_3d->body_get_state(body, BODY_STATE_ANGULAR_VELOCITY);
+		mirror.sleeping = physics_server_3d->body_get_state(body, BODY_STATE_SLEEPING);
+		mirror.can_sleep = physics_server_3d->body_get_state(body, BODY_STATE_CAN_SLEEP);
+
+		buffer.insert(body, mirror);
+	}
+
+	body_state_serials[body_state_write_index] = p_serial;
+	body_state_write_index = body_state_shared_index.exchange(body_state_write_index | BODY_STATE_FRESH, std::memory_order_acq_rel) & BODY_STATE_INDEX_MASK;
+}
+
+void PhysicsServer3DWrapMT::_acquire_body_states() const {
+	if ((body_state_shared_index.load(std::memory_order_relaxed) & BODY_STATE_FRESH) == 0) {
+		return;
+	}
+
+	// Only the server thread sets the fresh flag, so the buffer we get back is always fresh.
+	PhysicsServer3DWrapMT *self = const_cast<PhysicsServer3DWrapMT *>(this);
+	body_state_read_index = self->body_state_shared_index.exchange(body_state_read_index, std::memory_order_acq_rel) & BODY_STATE_INDEX_MASK;
+
+	if (body_state_serials[body_state_read_index] > max_stale_body_serial) {
+		stale_body_mirrors.clear();
+	}
+}
+
+bool PhysicsServer3DWrapMT::_get_mirrored_body_state(RID p_body, BodyState p_state, Variant &r_value) const {
+	const PendingBodyState *pending = pending_body_states.lookup_ptr(p_body);
+	if (pending != nullptr) {
+		if ((pending->mask & (1 << p_state)) == 0) {
+			return false; // The other states might depend on the pending ones.
+		}
+
+		r_value = pending->values.get(p_state);
+		return true;
+	}
+
+	_acquire_body_states();
+
+	const BodyStateMirror *mirror = body_state_buffers[body_state_read_index].lookup_ptr(p_body);
+	if (mirror == nullptr) {
+		if (!requested_body_mirrors.has(p_body)) {
+			requested_body_mirrors.insert(p_body, true);
+			command_queue.push(const_cast<PhysicsServer3DWrapMT *>(this), &PhysicsServer3DWrapMT::_mirror_body_state, p_body);
+		}
+		return false;
+	}
+
+	const uint64_t *stale_serial = stale_body_mirrors.lookup_ptr(p_body);
+	if (stale_serial != nullptr && *stale_serial >= body_state_serials[body_state_read_index]) {
+		return false; // Written to since this state was published.
+	}
+
+	r_value = mirror->get(p_state);
+	return true;
+}
+
+void PhysicsServer3DWrapMT::_flush_pending_body_states() const {
+	for (OAHashMap<RID, PendingBodyState>::Iterator it = pending_body_states.iter(); it.valid; it = pending_body_states.next_iter(it)) {
+		const RID &body = *it.key;
+		const PendingBodyState &pending = *it.value;
+
+		for (uint32_t i = 0; i < pending.order_count; ++i) {
+			const BodyState state = pending.order[i];
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_set_state, body, state, pending.values.get(state));
+		}
+
+		_invalidate_body_mirror(body);
+	}
+
+	pending_body_states.clear();
+}
+
+void PhysicsServer3DWrapMT::_apply_pending_body_states(RID p_body) const {
+	// Used ahead of calls that bypass the command queue, which need the pending states applied right away.
+	for (OAHashMap<RID, PendingBodyState>::Iterator it = pending_body_states.iter(); it.valid; it = pending_body_states.next_iter(it)) {
+		const RID &body = *it.key;
+		if (p_body.is_valid() && body != p_body) {
+			continue;
+		}
+
+		const PendingBodyState &pending = *it.value;
+
+		for (uint32_t i = 0; i < pending.order_count; ++i) {
+			const BodyState state = pending.order[i];
+			physics_server_3d->body_set_state(body, state, pending.values.get(state));
+		}
+
+		_invalidate_body_mirror(body);
+	}
+
+	if (p_body.is_valid()) {
+		pending_body_states.remove(p_body);
+	} else {
+		pending_body_states.clear();
+	}
+}
+
+void PhysicsServer3DWrapMT::_invalidate_body_mirrors() const {
+	for (OAHashMap<RID, bool>::Iterator it = requested_body_mirrors.iter(); it.valid; it = requested_body_mirrors.next_iter(it)) {
+		stale_body_mirrors.set(*it.key, pushed_steps);
+	}
+
+	max_stale_body_serial = pushed_steps;
+}
+
 /* EVENT QUEUING */
 
 void PhysicsServer3DWrapMT::step(real_t p_step) {
 	if (create_thread) {
-		command_queue.push(physics_server_3d, &PhysicsServer3D::step, p_step);
+		_flush_pending_body_states();
+		pushed_steps++;
+		command_queue.push(this, &PhysicsServer3DWrapMT::_thread_step, p_step, pushed_steps);
 	} else {
 		physics_server_3d->step(p_step);
 	}
@@ -60,6 +272,7 @@ void PhysicsServer3DWrapMT::step(real_t p_step) {
 
 void PhysicsServer3DWrapMT::sync() {
 	if (create_thread) {
+		_flush_pending_body_states();
 		command_queue.sync();
 	} else {
 		command_queue.flush_all(); // Flush all pending from other threads.
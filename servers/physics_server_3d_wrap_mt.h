@@ -35,8 +35,11 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
+#include "core/templates/oa_hash_map.h"
 #include "servers/physics_server_3d.h"
 
+#include <atomic>
+
 #ifdef DEBUG_SYNC
 #define SYNC_DEBUG print_line("sync on: " + String(__FUNCTION__));
 #else
@@ -61,16 +64,100 @@ class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	bool exit = false;
 	bool create_thread = false;
 
+	// Body states published by the server thread after each step, so that the
+	// main thread can read them without synchronizing with the server thread.
+	struct BodyStateMirror {
+		Transform3D transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		bool sleeping = false;
+		bool can_sleep = true;
+
+		Variant get(BodyState p_state) const;
+		bool set(BodyState p_state, const Variant &p_value);
+	};
+
+	struct PendingBodyState {
+		BodyStateMirror values;
+		uint32_t mask = 0;
+
+		// States in the order of their last write, since applying them in another order can change the result.
+		BodyState order[BODY_STATE_CAN_SLEEP + 1] = {};
+		uint32_t order_count = 0;
+
+		void add(BodyState p_state);
+	};
+
+	static constexpr uint32_t BODY_STATE_INDEX_MASK = 0b11;
+	static constexpr uint32_t BODY_STATE_FRESH = 0b100;
+
+	// Triple buffer, where the server thread owns one buffer, the main thread owns another,
+	// and the last one is swapped between them through `body_state_shared_index`.
+	OAHashMap<RID, BodyStateMirror> body_state_buffers[3];
+	uint64_t body_state_serials[3] = {};
+	std::atomic<uint32_t> body_state_shared_index = 1;
+	uint32_t body_state_write_index = 0;
+	mutable uint32_t body_state_read_index = 2;
+
+	// Only accessed from the server thread.
+	OAHashMap<RID, bool> mirrored_bodies;
+
+	// Only accessed from the main thread.
+	uint64_t pushed_steps = 0;
+	mutable uint64_t max_stale_body_serial = 0;
+	mutable OAHashMap<RID, bool> requested_body_mirrors;
+	mutable OAHashMap<RID, uint64_t> stale_body_mirrors;
+	mutable OAHashMap<RID, PendingBodyState> pending_body_states;
+
 	void _assign_mt_ids(WorkerThreadPool::TaskID p_pump_task_id);
 	void _thread_exit();
-	void _thread_step(real_t p_delta);
+	void _thread_step(real_t p_delta, uint64_t p_serial);
+	void _thread_free(RID p_rid);
 	void _thread_loop();
 
+	void _mirror_body_state(RID p_body);
+	void _publish_body_states(uint64_t p_serial);
+	void _acquire_body_states() const;
+	bool _get_mirrored_body_state(RID p_body, BodyState p_state, Variant &r_value) const;
+	void _flush_pending_body_states() const;
+	void _apply_pending_body_states(RID p_body = RID()) const;
+	void _invalidate_body_mirrors() const;
+
+	_FORCE_INLINE_ void _invalidate_body_mirror(RID p_body) const {
+		if (requested_body_mirrors.has(p_body)) {
+			stale_body_mirrors.set(p_body, pushed_steps);
+			max_stale_body_serial = pushed_steps;
+		}
+	}
+
+	_FORCE_INLINE_ bool _is_mirroring() const {
+		return create_thread && Thread::is_main_thread();
+	}
+
+	// Called at the start of every command. Pending body states are flushed first so that
+	// commands keep their order, and writes invalidate the mirrored state of the body.
+	template <typename T>
+	_FORCE_INLINE_ void _write_action(const T &p_arg) const {
+		if (!pending_body_states.is_empty() && _is_mirroring()) {
+			_flush_pending_body_states();
+		}
+	}
+
+	_FORCE_INLINE_ void _write_action(const RID &p_rid) {
+		if (_is_mirroring()) {
+			if (!pending_body_states.is_empty()) {
+				_flush_pending_body_states();
+			}
+
+			_invalidate_body_mirror(p_rid);
+		}
+	}
+
 public:
 #define ServerName PhysicsServer3D
 #define ServerNameWrapMT PhysicsServer3DWrapMT
 #define server_name physics_server_3d
-#define WRITE_ACTION
+#define WRITE_ACTION _write_action(p1);
 
 #include "servers/server_wrap_mt_common.h"
 
@@ -95,6 +182,8 @@ public:
 	FUNC1RC(ShapeType, shape_get_type, RID);
 	FUNC1RC(Variant, shape_get_data, RID);
 	FUNC1RC(real_t, shape_get_custom_solver_bias, RID);
+
+	FUNC3(heightmap_shape_update_region, RID, const Rect2i &, const Vector<real_t> &);
 #if 0
 	//these work well, but should be used from the main thread only
 	bool shape_collide(RID p_shape_A, const Transform &p_xform_A, const Vector3 &p_motion_A, RID p_shape_B, const Transform &p_xform_B, const Vector3 &p_motion_B, Vector3 *r_results, int p_result_max, int &r_result_count) {
@@ -128,6 +217,26 @@ public:
 		return physics_server_3d->space_get_contact_count(p_space);
 	}
 
+	virtual PackedByteArray space_save_state(RID p_space, const PackedByteArray &p_previous_state = PackedByteArray()) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), PackedByteArray());
+		return physics_server_3d->space_save_state(p_space, p_previous_state);
+	}
+
+	virtual bool space_restore_state(RID p_space, const PackedByteArray &p_state, const PackedByteArray &p_previous_state = PackedByteArray()) override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), false);
+		if (_is_mirroring()) {
+			// This bypasses the command queue, and moves the bodies of the space without any of the mirrors knowing.
+			_apply_pending_body_states();
+			_invalidate_body_mirrors();
+		}
+		return physics_server_3d->space_restore_state(p_space, p_state, p_previous_state);
+	}
+
+	virtual double space_get_step_time(RID p_space) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), 0.0);
+		return physics_server_3d->space_get_step_time(p_space);
+	}
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -167,11 +276,13 @@ public:
 
 	FUNC2(area_set_monitor_callback, RID, const Callable &);
 	FUNC2(area_set_area_monitor_callback, RID, const Callable &);
+	FUNC2(area_set_monitor_batching, RID, bool);
 
 	/* BODY API */
 
 	//FUNC2RID(body,BodyMode,bool);
 	FUNCRID(body)
+	FUNC6R(Vector<RID>, body_create_batch, RID, BodyMode, RID, const Vector<Transform3D> &, uint32_t, uint32_t);
 
 	FUNC2(body_set_space, RID, RID);
 	FUNC1RC(RID, body_get_space, RID);
@@ -215,8 +326,53 @@ public:
 
 	FUNC1(body_reset_mass_properties, RID);
 
-	FUNC3(body_set_state, RID, BodyState, const Variant &);
-	FUNC2RC(Variant, body_get_state, RID, BodyState);
+	virtual void body_set_state(RID p_body, BodyState p_state, const Variant &p_value) override {
+		if (_is_mirroring()) {
+			// Coalesce until the next command, so repeated writes in a frame cost a single command.
+			PendingBodyState *pending = pending_body_states.lookup_ptr(p_body);
+			if (pending == nullptr) {
+				pending_body_states.insert(p_body, PendingBodyState());
+				pending = pending_body_states.lookup_ptr(p_body);
+			}
+
+			if (pending->values.set(p_state, p_value)) {
+				pending->add(p_state);
+				return;
+			}
+
+			if (pending->mask == 0) {
+				pending_body_states.remove(p_body);
+			}
+		}
+
+		_write_action(p_body);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_set_state, p_body, p_state, p_value);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_set_state(p_body, p_state, p_value);
+		}
+	}
+
+	virtual Variant body_get_state(RID p_body, BodyState p_state) const override {
+		if (Thread::get_caller_id() != server_thread) {
+			if (_is_mirroring()) {
+				Variant mirrored;
+				if (_get_mirrored_body_state(p_body, p_state, mirrored)) {
+					return mirrored;
+				}
+				_flush_pending_body_states();
+			}
+			Variant ret;
+			command_queue.push_and_ret(physics_server_3d, &PhysicsServer3D::body_get_state, p_body, p_state, &ret);
+			SYNC_DEBUG
+			MAIN_THREAD_SYNC_CHECK
+			return ret;
+		} else {
+			command_queue.flush_if_pending();
+			return physics_server_3d->body_get_state(p_body, p_state);
+		}
+	}
 
 	FUNC2(body_apply_torque_impulse, RID, const Vector3 &);
 	FUNC2(body_apply_central_impulse, RID, const Vector3 &);
@@ -264,6 +420,17 @@ public:
 		return physics_server_3d->body_test_motion(p_body, p_parameters, r_result);
 	}
 
+	bool body_move_character(RID p_body, const CharacterMotionParameters &p_parameters, CharacterMotionResult *r_result) override {
+		// Characters may be moved from the worker threads of a node processing group, as long as the server is not on its own thread.
+		ERR_FAIL_COND_V(create_thread && !Thread::is_main_thread(), false);
+		if (_is_mirroring()) {
+			// This bypasses the command queue, so any pending state has to be applied first.
+			_apply_pending_body_states(p_body);
+			_invalidate_body_mirror(p_body);
+		}
+		return physics_server_3d->body_move_character(p_body, p_parameters, r_result);
+	}
+
 	// this function only works on physics process, errors and returns null otherwise
 	PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), nullptr);
@@ -379,7 +546,20 @@ public:
 
 	/* MISC */
 
-	FUNC1(free, RID);
+	virtual void free(RID p_rid) override {
+		_write_action(p_rid);
+		if (_is_mirroring()) {
+			requested_body_mirrors.remove(p_rid);
+			stale_body_mirrors.remove(p_rid);
+		}
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(this, &PhysicsServer3DWrapMT::_thread_free, p_rid);
+		} else {
+			command_queue.flush_if_pending();
+			_thread_free(p_rid);
+		}
+	}
+
 	FUNC1(set_active, bool);
 
 	virtual void init() override;
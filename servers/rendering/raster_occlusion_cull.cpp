@@ -0,0 +1,463 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	tile_grid_size = Size2i();
+	tile_triangles.clear();
+	triangles.clear();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	tile_grid_size = Size2i((p_size.x + TILE_WIDTH - 1) / TILE_WIDTH, (p_size.y + TILE_HEIGHT - 1) / TILE_HEIGHT);
+	tile_triangles.clear();
+	tile_triangles.resize(tile_grid_size.x * tile_grid_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::bin_triangles() {
+	for (LocalVector<uint32_t> &tile : tile_triangles) {
+		tile.clear();
+	}
+
+	for (uint32_t i = 0; i < triangles.size(); i++) {
+		const Triangle &triangle = triangles[i];
+
+		for (int y = triangle.min_y / TILE_HEIGHT; y <= triangle.max_y / TILE_HEIGHT; y++) {
+			for (int x = triangle.min_x / TILE_WIDTH; x <= triangle.max_x / TILE_WIDTH; x++) {
+				tile_triangles[y * tile_grid_size.x + x].push_back(i);
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize_tile(uint32_t p_tile) {
+	const Size2i &buffer_size = sizes[0];
+	const int tile_x = (p_tile % tile_grid_size.x) * TILE_WIDTH;
+	const int tile_y = (p_tile / tile_grid_size.x) * TILE_HEIGHT;
+	const int width = MIN(TILE_WIDTH, buffer_size.x - tile_x);
+	const int height = MIN(TILE_HEIGHT, buffer_size.y - tile_y);
+
+	// Rasterize into a full size local tile, so the inner loop has a fixed width and no bounds checks,
+	// which lets the compiler turn it into SIMD code.
+	float depth[TILE_HEIGHT][TILE_WIDTH];
+	for (int y = 0; y < TILE_HEIGHT; y++) {
+		for (int x = 0; x < TILE_WIDTH; x++) {
+			depth[y][x] = FLT_MAX;
+		}
+	}
+
+	float pixel_x[TILE_WIDTH];
+	for (int x = 0; x < TILE_WIDTH; x++) {
+		pixel_x[x] = tile_x + x + 0.5f;
+	}
+
+	float tile_max_depth = FLT_MAX;
+
+	for (const uint32_t &index : tile_triangles[p_tile]) {
+		const Triangle &triangle = triangles[index];
+
+		if (triangle.min_depth >= tile_max_depth) {
+			// Entirely behind what was already drawn in this tile.
+			continue;
+		}
+
+		const int from_y = MAX(triangle.min_y - tile_y, 0);
+		const int to_y = MIN(triangle.max_y - tile_y, height - 1);
+
+		for (int y = from_y; y <= to_y; y++) {
+			const float pixel_y = tile_y + y + 0.5f;
+			const float edge_0 = triangle.edge_b[0] * pixel_y + triangle.edge_c[0];
+			const float edge_1 = triangle.edge_b[1] * pixel_y + triangle.edge_c[1];
+			const float edge_2 = triangle.edge_b[2] * pixel_y + triangle.edge_c[2];
+			const float inv_w = triangle.inv_w[1] * pixel_y + triangle.inv_w[2];
+			const float depth_w = triangle.depth_w[1] * pixel_y + triangle.depth_w[2];
+
+			float *row = depth[y];
+
+			for (int x = 0; x < TILE_WIDTH; x++) {
+				const float e0 = triangle.edge_a[0] * pixel_x[x] + edge_0;
+				const float e1 = triangle.edge_a[1] * pixel_x[x] + edge_1;
+				const float e2 = triangle.edge_a[2] * pixel_x[x] + edge_2;
+				const float d = (triangle.depth_w[0] * pixel_x[x] + depth_w) / (triangle.inv_w[0] * pixel_x[x] + inv_w);
+				const bool write = (e0 >= 0.0f) & (e1 >= 0.0f) & (e2 >= 0.0f) & (d < row[x]);
+				row[x] = write ? d : row[x];
+			}
+		}
+
+		tile_max_depth = 0.0f;
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				tile_max_depth = MAX(tile_max_depth, depth[y][x]);
+			}
+		}
+	}
+
+	for (int y = 0; y < height; y++) {
+		memcpy(&mips[0][(tile_y + y) * buffer_size.x + tile_x], depth[y], width * sizeof(float));
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::_rasterize_tile(uint32_t p_tile, RasterHZBuffer *p_buffer) {
+	p_buffer->rasterize_tile(p_tile);
+}
+
+void RasterOcclusionCull::_add_triangle(RasterHZBuffer &p_buffer, const Vector3 p_view[3], const Projection &p_projection) {
+	const Size2i buffer_size = p_buffer.get_occlusion_buffer_size();
+
+	Vector2 screen[3];
+	float inv_w[3];
+	float depth_w[3];
+
+	for (int i = 0; i < 3; i++) {
+		const Plane projected = p_projection.xform4(Plane(p_view[i], 1.0));
+		const float w = projected.d;
+		if (w <= 0.0f) {
+			return;
+		}
+
+		screen[i] = Vector2((projected.normal.x / w * 0.5f + 0.5f) * buffer_size.x, (projected.normal.y / w * 0.5f + 0.5f) * buffer_size.y);
+		inv_w[i] = 1.0f / w;
+		depth_w[i] = -p_view[i].z / w;
+	}
+
+	Triangle triangle;
+
+	// Edge i is the one opposite to vertex i, so its value divided by the area is the barycentric coordinate of vertex i.
+	for (int i = 0; i < 3; i++) {
+		const Vector2 &a = screen[(i + 1) % 3];
+		const Vector2 &b = screen[(i + 2) % 3];
+		triangle.edge_a[i] = a.y - b.y;
+		triangle.edge_b[i] = b.x - a.x;
+		triangle.edge_c[i] = a.x * b.y - a.y * b.x;
+	}
+
+	float area = triangle.edge_a[0] * screen[0].x + triangle.edge_b[0] * screen[0].y + triangle.edge_c[0];
+	if (Math::abs(area) < CMP_EPSILON) {
+		return;
+	}
+
+	// Occluders are double sided, so flip the edges of back facing triangles instead of skipping them.
+	if (area < 0.0f) {
+		for (int i = 0; i < 3; i++) {
+			triangle.edge_a[i] = -triangle.edge_a[i];
+			triangle.edge_b[i] = -triangle.edge_b[i];
+			triangle.edge_c[i] = -triangle.edge_c[i];
+		}
+		area = -area;
+	}
+
+	const Vector2 screen_min = screen[0].min(screen[1]).min(screen[2]);
+	const Vector2 screen_max = screen[0].max(screen[1]).max(screen[2]);
+
+	// Pixels are sampled at their centers.
+	triangle.min_x = MAX(0, (int)Math::ceil(screen_min.x - 0.5f));
+	triangle.min_y = MAX(0, (int)Math::ceil(screen_min.y - 0.5f));
+	triangle.max_x = MIN(buffer_size.x - 1, (int)Math::floor(screen_max.x - 0.5f));
+	triangle.max_y = MIN(buffer_size.y - 1, (int)Math::floor(screen_max.y - 0.5f));
+
+	if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+		return;
+	}
+
+	// Interpolating 1 / w and depth / w linearly in screen space gives perspective correct depth for both projection types.
+	for (int i = 0; i < 3; i++) {
+		triangle.inv_w[i] = 0.0f;
+		triangle.depth_w[i] = 0.0f;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		const float edge[3] = { triangle.edge_a[i] / area, triangle.edge_b[i] / area, triangle.edge_c[i] / area };
+		for (int j = 0; j < 3; j++) {
+			triangle.inv_w[j] += edge[j] * inv_w[i];
+			triangle.depth_w[j] += edge[j] * depth_w[i];
+		}
+	}
+
+	triangle.min_depth = MIN(MIN(-p_view[0].z, -p_view[1].z), -p_view[2].z);
+
+	p_buffer.triangles.push_back(triangle);
+}
+
+void RasterOcclusionCull::_clip_and_add_triangle(RasterHZBuffer &p_buffer, const Vector3 p_view[3], const Projection &p_projection, float p_z_near) {
+	const bool inside[3] = { -p_view[0].z >= p_z_near, -p_view[1].z >= p_z_near, -p_view[2].z >= p_z_near };
+
+	if (inside[0] && inside[1] && inside[2]) {
+		_add_triangle(p_buffer, p_view, p_projection);
+		return;
+	}
+
+	if (!inside[0] && !inside[1] && !inside[2]) {
+		return;
+	}
+
+	// Clip against the near plane, which leaves either a triangle or a quad.
+	Vector3 clipped[4];
+	int clipped_count = 0;
+
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &a = p_view[i];
+		const Vector3 &b = p_view[(i + 1) % 3];
+
+		if (inside[i]) {
+			clipped[clipped_count++] = a;
+		}
+
+		if (inside[i] != inside[(i + 1) % 3]) {
+			const real_t t = (-p_z_near - a.z) / (b.z - a.z);
+			clipped[clipped_count++] = a.lerp(b, t);
+		}
+	}
+
+	for (int i = 2; i < clipped_count; i++) {
+		const Vector3 triangle[3] = { clipped[0], clipped[i - 1], clipped[i] };
+		_add_triangle(p_buffer, triangle, p_projection);
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	// Occluders are read every frame, so there is nothing else to update.
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	for (const InstanceID &E : occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		if (scenario && scenario->instances.has(E.instance)) {
+			scenario->instances[E.instance].occluder = RID();
+		}
+	}
+
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		Occluder *occluder = occluder_owner.get_or_null(E.value.occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, E.key));
+		}
+	}
+
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance &instance = scenario->instances[p_instance];
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+	}
+
+	instance.xform = p_xform;
+	instance.enabled = p_enabled;
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (!instance) {
+		return;
+	}
+
+	Occluder *occluder = occluder_owner.get_or_null(instance->occluder);
+	if (occluder) {
+		occluder->users.erase(InstanceID(p_scenario, p_instance));
+	}
+
+	scenario->instances.erase(p_instance);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	RasterHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer) {
+		return;
+	}
+
+	const Scenario *scenario = scenarios.getptr(buffer->scenario_rid);
+	if (buffer->is_empty() || !scenario) {
+		return;
+	}
+
+	const Projection projection = _jitter_projection(p_cam_projection, buffer->get_occlusion_buffer_size());
+	const Transform3D inv_cam_transform = p_cam_transform.affine_inverse();
+	const float z_near = projection.get_z_near();
+
+	buffer->triangles.clear();
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		const OccluderInstance &instance = E.value;
+		const Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+
+		if (!occluder || !instance.enabled) {
+			continue;
+		}
+
+		const Transform3D view_xform = inv_cam_transform * instance.xform;
+		const Vector3 *vertices = occluder->vertices.ptr();
+		const int32_t *indices = occluder->indices.ptr();
+		const int vertex_count = occluder->vertices.size();
+		const int index_count = occluder->indices.size() - occluder->indices.size() % 3;
+
+		for (int i = 0; i < index_count; i += 3) {
+			if (unlikely((uint32_t)indices[i] >= (uint32_t)vertex_count || (uint32_t)indices[i + 1] >= (uint32_t)vertex_count || (uint32_t)indices[i + 2] >= (uint32_t)vertex_count)) {
+				continue;
+			}
+
+			const Vector3 view[3] = {
+				view_xform.xform(vertices[indices[i]]),
+				view_xform.xform(vertices[indices[i + 1]]),
+				view_xform.xform(vertices[indices[i + 2]]),
+			};
+
+			_clip_and_add_triangle(*buffer, view, projection, z_near);
+		}
+	}
+
+	buffer->bin_triangles();
+	buffer->set_debug_range(projection.get_z_far());
+
+	// Tiles don't overlap, so each one can be rasterized on its own thread without any locking.
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_rasterize_tile, buffer, buffer->tile_triangles.size(), -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	buffer->update_mips();
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	List<RID> occluders;
+	occluder_owner.get_owned_list(&occluders);
+
+	for (const RID &occluder_rid : occluders) {
+		memdelete(occluder_owner.get_or_null(occluder_rid));
+		occluder_owner.free(occluder_rid);
+	}
+}
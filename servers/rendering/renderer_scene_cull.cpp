@@ -30,6 +30,8 @@
 
 #include "renderer_scene_cull.h"
 
+#include "servers/rendering/raster_occlusion_cull.h"
+
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
@@ -436,6 +438,8 @@ RID RendererSceneCull::scenario_get_environment(RID p_scenario) {
 void RendererSceneCull::scenario_remove_viewport_visibility_mask(RID p_scenario, RID p_viewport) {
 	Scenario *scenario = scenario_owner.get_or_null(p_scenario);
 	ERR_FAIL_NULL(scenario);
+	scenario->camera_cull_caches.erase(p_viewport);
+
 	if (!scenario->viewport_visibility_masks.has(p_viewport)) {
 		return;
 	}
@@ -872,6 +876,7 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 	instance->layer_mask = p_mask;
 	if (instance->scenario && instance->array_index >= 0) {
 		instance->scenario->instance_data[instance->array_index].layer_mask = p_mask;
+		instance->scenario->instance_cull_blocks.set_layer_mask(instance->array_index, p_mask);
 	}
 
 	if ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK && instance->base_data) {
@@ -1096,6 +1101,7 @@ void RendererSceneCull::instance_set_ignore_culling(RID p_instance, bool p_enabl
 		} else {
 			idata.flags &= ~uint32_t(InstanceData::FLAG_IGNORE_ALL_CULLING);
 		}
+		instance->scenario->instance_cull_blocks.set_cull_flags(instance->array_index, instance->ignore_all_culling ? RendererSceneCullBlocks::CULL_FLAG_IGNORE_ALL_CULLING : 0);
 	}
 }
 
@@ -1795,6 +1801,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 
 		p_instance->scenario->instance_data.push_back(idata);
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		p_instance->scenario->instance_cull_blocks.push_back(p_instance->transformed_aabb, idata.layer_mask, p_instance->ignore_all_culling ? RendererSceneCullBlocks::CULL_FLAG_IGNORE_ALL_CULLING : 0);
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1803,6 +1810,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_cull_blocks.set_aabb(p_instance->array_index, p_instance->transformed_aabb);
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1890,6 +1898,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		p_instance->scenario->instance_cull_blocks.copy(swap_with_index, p_instance->array_index);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -1906,6 +1915,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 	// pop last
 	p_instance->scenario->instance_data.pop_back();
 	p_instance->scenario->instance_aabbs.pop_back();
+	p_instance->scenario->instance_cull_blocks.pop_back();
 
 	//uninitialize
 	p_instance->array_index = -1;
@@ -2309,13 +2319,18 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
-bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers) {
+bool RendererSceneCull::_light_instance_setup_shadow(Instance *p_instance, int32_t p_regular_light_id, float p_coverage, bool p_atlas_redraw, bool p_update_version) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform3D light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
+	ShadowCullLight shadow_light;
+	shadow_light.instance = p_instance;
+	shadow_light.first_job = shadow_cull_job_count;
+	shadow_light.coverage = p_coverage;
+	shadow_light.atlas_redraw = p_atlas_redraw;
+	shadow_light.update_version = p_update_version;
 
 	switch (RSG::light_storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
@@ -2324,13 +2339,11 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			RS::LightOmniShadowMode shadow_mode = RSG::light_storage->light_omni_get_shadow_mode(p_instance->base);
 
 			if (shadow_mode == RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID || !RSG::light_storage->light_instances_can_render_shadow_cube()) {
-				if (max_shadows_used + 2 > MAX_UPDATE_SHADOWS) {
-					return true;
+				if (max_shadows_used + shadow_cull_job_count + 2 > MAX_UPDATE_SHADOWS) {
+					return false;
 				}
 				for (int i = 0; i < 2; i++) {
 					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Paraboloid, Half " + itos(i));
-
 					real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
 					real_t z = i == 0 ? -1 : 1;
@@ -2343,57 +2356,14 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
+					_add_shadow_cull_job(planes, p_regular_light_id, light->instance, i);
 
 					RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, i, 0);
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
 				}
 			} else { //shadow cube
 
-				if (max_shadows_used + 6 > MAX_UPDATE_SHADOWS) {
-					return true;
+				if (max_shadows_used + shadow_cull_job_count + 6 > MAX_UPDATE_SHADOWS) {
+					return false;
 				}
 
 				real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
@@ -2401,7 +2371,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				cm.set_perspective(90, 1, radius * 0.005f, radius);
 
 				for (int i = 0; i < 6; i++) {
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Cube, Side " + itos(i));
 					//using this one ensures that raster deferred will have it
 
 					static const Vector3 view_normals[6] = {
@@ -2423,53 +2392,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Transform3D xform = light_transform * Transform3D().looking_at(view_normals[i], view_up[i]);
 
-					Vector<Plane> planes = cm.get_projection_planes(xform);
-
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
+					_add_shadow_cull_job(cm.get_projection_planes(xform), p_regular_light_id, light->instance, i);
 
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
 					RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
-
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
 				}
 
 				//restore the regular DP matrix
@@ -2478,10 +2403,8 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 		} break;
 		case RS::LIGHT_SPOT: {
-			RENDER_TIMESTAMP("Cull SpotLight3D Shadow");
-
-			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
-				return true;
+			if (max_shadows_used + shadow_cull_job_count + 1 > MAX_UPDATE_SHADOWS) {
+				return false;
 			}
 
 			real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
@@ -2490,58 +2413,150 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			Projection cm;
 			cm.set_perspective(angle * 2.0, 1.0, 0.005f * radius, radius);
 
-			Vector<Plane> planes = cm.get_projection_planes(light_transform);
+			_add_shadow_cull_job(cm.get_projection_planes(light_transform), p_regular_light_id, light->instance, 0);
 
-			instance_shadow_cull_result.clear();
+			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
 
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+		} break;
+	}
 
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
+	shadow_light.job_count = shadow_cull_job_count - shadow_light.first_job;
+	shadow_cull_lights.push_back(shadow_light);
+
+	return true;
+}
+
+void RendererSceneCull::_add_shadow_cull_job(const Vector<Plane> &p_planes, int32_t p_regular_light_id, RID p_light_instance, int p_pass) {
+	ShadowCullJob &job = shadow_cull_jobs[shadow_cull_job_count++];
+	job.planes = p_planes;
+	job.regular_light_id = p_regular_light_id;
+	job.light_instance = p_light_instance;
+	job.pass = p_pass;
+}
+
+void RendererSceneCull::_shadow_cull_job(uint32_t p_job, ShadowCullData *p_cull_data) {
+	ShadowCullJob &job = shadow_cull_jobs[p_job];
+
+	Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(job.planes.ptr(), job.planes.size());
+
+	struct CullConvex {
+		PagedArray<Instance *> *result;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			result->push_back(p_instance);
+			return false;
+		}
+	};
+
+	CullConvex cull_convex;
+	cull_convex.result = &job.casters;
+
+	p_cull_data->scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(job.planes.ptr(), job.planes.size(), points.ptr(), points.size(), cull_convex);
+
+	if (job.regular_light_id != -1) {
+		light_culler->cull_regular_light(job.casters, job.regular_light_id);
+	}
+
+	for (int i = 0; i < (int)job.casters.size(); i++) {
+		Instance *instance = job.casters[i];
+		if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_cull_data->visible_layers & instance->layer_mask)) {
+			job.casters.remove_at_unordered(i);
+			i--;
+		}
+	}
+}
 
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
+void RendererSceneCull::_cull_shadow_casters(Scenario *p_scenario, RID p_shadow_atlas, uint32_t p_visible_layers, RenderingMethod::RenderInfo *r_render_info) {
+	ShadowCullData cull_data;
+	cull_data.scenario = p_scenario;
+	cull_data.visible_layers = p_visible_layers;
 
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+	RENDER_TIMESTAMP("Cull Light3D Shadows");
 
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+	// All passes of all lights are culled at once, each into its own result array, so they don't need to wait on each other.
+	if (shadow_cull_job_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_shadow_cull_job, &cull_data, shadow_cull_job_count, -1, true, SNAME("RenderCullShadows"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (shadow_cull_job_count == 1) {
+		_shadow_cull_job(0, &cull_data);
+	}
+
+	uint32_t skipped_lights = 0;
+
+	// Merging is done on this thread, since updating mesh instances is not thread safe.
+	for (const ShadowCullLight &shadow_light : shadow_cull_lights) {
+		InstanceLightData *light = static_cast<InstanceLightData *>(shadow_light.instance->base_data);
 
-			if (!light->is_shadow_update_full()) {
-				light_culler->cull_regular_light(instance_shadow_cull_result);
+		// Identifies what would be drawn: the light itself, and each caster with its version in each pass.
+		// Summing keeps it independent of the order the casters were culled in.
+		uint64_t caster_signature = _shadow_caster_hash(shadow_light.instance->self.get_id(), shadow_light.instance->version, shadow_light.job_count);
+		bool animated_material_found = false;
+
+		for (uint32_t i = shadow_light.first_job; i < shadow_light.first_job + shadow_light.job_count; i++) {
+			const ShadowCullJob &job = shadow_cull_jobs[i];
+			for (uint32_t j = 0; j < job.casters.size(); j++) {
+				const Instance *instance = job.casters[j];
+				caster_signature += _shadow_caster_hash(instance->self.get_id(), instance->version, job.pass);
+				if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
+					animated_material_found = true;
+				}
 			}
+		}
 
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-					continue;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
+		bool draw = true;
+
+		if (shadow_light.update_version) {
+			// The light was made dirty, but if it would draw the same casters as last time into the same atlas spot,
+			// the previous contents are still valid.
+			if (!shadow_light.atlas_redraw && !animated_material_found && caster_signature == light->shadow_caster_signature && p_shadow_atlas == light->shadow_caster_atlas) {
+				draw = false;
+				skipped_lights++;
+			} else {
+				light->last_version++;
+				draw = RSG::light_storage->shadow_atlas_update_light(p_shadow_atlas, light->instance, shadow_light.coverage, light->last_version);
+			}
+		}
+
+		for (uint32_t i = shadow_light.first_job; i < shadow_light.first_job + shadow_light.job_count; i++) {
+			ShadowCullJob &job = shadow_cull_jobs[i];
+
+			if (draw) {
+				RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+				shadow_data.light = job.light_instance;
+				shadow_data.pass = job.pass;
 
+				for (uint32_t j = 0; j < job.casters.size(); j++) {
+					Instance *instance = job.casters[j];
 					if (instance->mesh_instance.is_valid()) {
 						RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
 					}
+
+					shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
 				}
-				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
 			}
 
-			RSG::mesh_storage->update_mesh_instances();
+			job.casters.clear();
+			job.planes.clear();
+		}
 
-			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
-			shadow_data.light = light->instance;
-			shadow_data.pass = 0;
+		if (draw) {
+			light->shadow_caster_signature = caster_signature;
+			light->shadow_caster_atlas = p_shadow_atlas;
+		}
 
-		} break;
+		if (animated_material_found) {
+			light->make_shadow_dirty();
+		}
+	}
+
+	RSG::mesh_storage->update_mesh_instances();
+
+	if (r_render_info) {
+		r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_SHADOW_LIGHTS_SKIPPED_IN_FRAME] += skipped_lights;
 	}
 
-	return animated_material_found;
+	shadow_cull_job_count = 0;
+	shadow_cull_lights.clear();
 }
 
 void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, uint32_t p_jitter_phase_count, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info) {
@@ -2741,6 +2756,110 @@ bool RendererSceneCull::_visibility_parent_check(const CullData &p_cull_data, co
 	return ((parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE) || (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 }
 
+void RendererSceneCull::_update_camera_cull_cache(CameraCullCache &r_cache, const Scenario *p_scenario, const Transform3D &p_cam_transform, const Projection &p_cam_projection, const Vector<Plane> &p_planes, uint32_t p_visible_layers, bool p_persistent, RenderingMethod::RenderInfo *r_render_info) {
+	const RendererSceneCullBlocks &blocks = p_scenario->instance_cull_blocks;
+
+	const real_t margin = p_persistent ? cull_cache_margin : 0.0;
+
+	Vector3 frustum_corners[8];
+	bool reuse = p_persistent && r_cache.valid && r_cache.visible_layers == p_visible_layers && p_cam_projection.get_endpoints(p_cam_transform, frustum_corners);
+
+	for (int i = 0; i < 8 && reuse; i++) {
+		reuse = frustum_corners[i].distance_squared_to(r_cache.frustum_corners[i]) <= margin * margin;
+	}
+
+	if (!reuse) {
+		Vector<Plane> planes = p_planes;
+		Plane *planes_ptrw = planes.ptrw();
+		for (int i = 0; i < planes.size(); i++) {
+			planes_ptrw[i].d += margin;
+		}
+
+		r_cache.planes = RendererSceneCullBlocks::Planes(planes.ptr(), planes.size());
+		r_cache.visible_layers = p_visible_layers;
+		r_cache.valid = p_persistent && p_cam_projection.get_endpoints(p_cam_transform, r_cache.frustum_corners);
+	}
+
+	r_cache.block_masks.resize(blocks.get_block_count());
+
+	CameraCullCacheUpdate update;
+	update.cache = &r_cache;
+	update.blocks = &blocks;
+	update.reuse = reuse;
+
+	// The grown frustum only tells which results can be reused, what gets drawn is tested against the exact one.
+	r_cache.refined = margin > 0.0;
+	if (r_cache.refined) {
+		update.exact_planes = RendererSceneCullBlocks::Planes(p_planes.ptr(), p_planes.size());
+		r_cache.visible_masks.resize(blocks.get_block_count());
+	}
+
+	uint32_t tested_count = 0;
+
+	if (blocks.size() > thread_cull_threshold) {
+		update.thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+		update.tested_counts.resize(update.thread_count);
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_camera_cull_cache_update_threaded, &update, update.thread_count, -1, true, SNAME("RenderCullCameraCache"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (const uint32_t &count : update.tested_counts) {
+			tested_count += count;
+		}
+	} else {
+		tested_count = _camera_cull_cache_update(update, 0, blocks.get_block_count());
+	}
+
+	r_cache.version = blocks.get_version();
+
+	if (r_render_info) {
+		r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_CULL_TESTED_IN_FRAME] += tested_count;
+		r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_CULL_CACHED_IN_FRAME] += blocks.size() - tested_count;
+	}
+}
+
+void RendererSceneCull::_camera_cull_cache_update_threaded(uint32_t p_thread, CameraCullCacheUpdate *p_update) {
+	// Split on block boundaries, so that no two threads write to the same mask.
+	uint32_t block_total = p_update->blocks->get_block_count();
+	uint32_t total_threads = p_update->thread_count;
+	uint32_t from = p_thread * block_total / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? block_total : ((p_thread + 1) * block_total / total_threads);
+
+	p_update->tested_counts[p_thread] = _camera_cull_cache_update(*p_update, from, to);
+}
+
+uint32_t RendererSceneCull::_camera_cull_cache_update(CameraCullCacheUpdate &p_update, uint32_t p_from_block, uint32_t p_to_block) {
+	const RendererSceneCullBlocks &blocks = *p_update.blocks;
+	CameraCullCache &cache = *p_update.cache;
+	uint32_t tested_count = 0;
+
+	for (uint32_t i = p_from_block; i < p_to_block; i++) {
+		bool tested = false;
+
+		// Blocks are only tested again when something in them changed since they were last tested.
+		if (!p_update.reuse || blocks.get_block_version(i) > cache.version) {
+			cache.block_masks[i] = blocks.cull_block(i, cache.planes, cache.visible_layers);
+			tested = true;
+		}
+
+		if (cache.refined) {
+			// Instances outside of the grown frustum are outside of the exact one too.
+			if (cache.block_masks[i]) {
+				cache.visible_masks[i] = cache.block_masks[i] & blocks.cull_block(i, p_update.exact_planes, cache.visible_layers);
+				tested = true;
+			} else {
+				cache.visible_masks[i] = 0;
+			}
+		}
+
+		if (tested) {
+			tested_count += MIN(uint32_t(RendererSceneCullBlocks::BLOCK_SIZE), blocks.size() - i * RendererSceneCullBlocks::BLOCK_SIZE);
+		}
+	}
+
+	return tested_count;
+}
+
 void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_data) {
 	uint32_t cull_total = cull_data->scenario->instance_data.size();
 	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
@@ -2762,7 +2881,17 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// The camera frustum and layer checks were already done for all instances by _update_camera_cull_cache().
+	const uint8_t *frustum_masks = cull_data.frustum_masks;
+	const bool has_other_culls = cull_data.cull->shadow_count > 0 || cull_data.cull->sdfgi.region_count > 0;
+
 	for (uint64_t i = p_from; i < p_to; i++) {
+		const bool in_camera_frustum = (frustum_masks[i / RendererSceneCullBlocks::BLOCK_SIZE] >> (i % RendererSceneCullBlocks::BLOCK_SIZE)) & 1;
+		if (!in_camera_frustum && !has_other_culls) {
+			// Nothing else can make this instance relevant, so don't even touch its data.
+			continue;
+		}
+
 		bool mesh_visible = false;
 
 		InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2778,7 +2907,8 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, cull_data.scenario->instance_data[i].occlusion_timeout))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			// in_camera_frustum already accounts for the layer check and FLAG_IGNORE_ALL_CULLING.
+			if (in_camera_frustum && ((idata.flags & InstanceData::FLAG_IGNORE_ALL_CULLING) || (VIS_CHECK && !OCCLUSION_CULLED))) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -3079,6 +3209,10 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 	Vector<Plane> planes = p_camera_data->main_projection.get_projection_planes(p_camera_data->main_transform);
 	cull.frustum = Frustum(planes);
 
+	// Reflection probes render a different face every step, so there is nothing to gain from keeping their results.
+	CameraCullCache &camera_cull_cache = render_reflection_probe ? probe_cull_cache : scenario->camera_cull_caches[p_viewport];
+	_update_camera_cull_cache(camera_cull_cache, scenario, p_camera_data->main_transform, p_camera_data->main_projection, planes, p_visible_layers, render_reflection_probe == nullptr, r_render_info);
+
 	Vector<RID> directional_lights;
 	// directional lights
 	{
@@ -3158,6 +3292,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
+		cull_data.frustum_masks = camera_cull_cache.refined ? camera_cull_cache.visible_masks.ptr() : camera_cull_cache.block_masks.ptr();
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -3221,6 +3356,9 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		}
 
 		// Positional Shadows
+		uint64_t shadow_cull_begin = OS::get_singleton()->get_ticks_usec();
+		int32_t regular_light_count = 0;
+
 		for (uint32_t i = 0; i < (uint32_t)scene_cull_result.lights.size(); i++) {
 			Instance *ins = scene_cull_result.lights[i];
 
@@ -3308,14 +3446,18 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			// so that we can turn off tighter caster culling.
 			light->detect_light_intersects_multiple_cameras(Engine::get_singleton()->get_frames_drawn());
 
+			int32_t regular_light_id = -1;
+			bool update_version = false;
+
 			if (light->is_shadow_dirty()) {
 				// Dirty shadows have no need to be drawn if
 				// the light volume doesn't intersect the camera frustum.
 
 				// Returns false if the entire light can be culled.
-				bool allow_redraw = light_culler->prepare_regular_light(*ins);
+				regular_light_id = regular_light_count++;
+				bool allow_redraw = light_culler->prepare_regular_light(*ins, regular_light_id);
 
-				// Directional lights aren't handled here, _light_instance_update_shadow is called from elsewhere.
+				// Directional lights aren't handled here, _light_instance_setup_shadow is called from elsewhere.
 				// Checking for this in case this changes, as this is assumed.
 				DEV_CHECK_ONCE(RSG::light_storage->light_get_type(ins->base) != RS::LIGHT_DIRECTIONAL);
 
@@ -3325,27 +3467,35 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 				// There is however a cost to tighter shadow culling in this situation (2 shadow updates in 1 frame),
 				// so we should detect this and switch off tighter caster culling automatically.
 				// This is done in the logic for `decrement_shadow_dirty()`.
+				// The version is only increased once the casters are culled, and only if they changed since the last
+				// time the shadow was drawn. Otherwise the shadow atlas keeps its previous contents.
 				if (allow_redraw) {
-					light->last_version++;
+					update_version = true;
 					light->decrement_shadow_dirty();
 				}
 			}
 
+			// This only redraws when the light needs a new spot in the atlas, as the version didn't change yet.
 			bool redraw = RSG::light_storage->shadow_atlas_update_light(p_shadow_atlas, light->instance, coverage, light->last_version);
 
-			if (redraw && max_shadows_used < MAX_UPDATE_SHADOWS) {
-				//must redraw!
-				RENDER_TIMESTAMP("> Render Light3D " + itos(i));
-				if (_light_instance_update_shadow(ins, p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect, p_shadow_atlas, scenario, p_screen_mesh_lod_threshold, p_visible_layers)) {
+			if ((redraw || update_version) && max_shadows_used + shadow_cull_job_count < MAX_UPDATE_SHADOWS) {
+				//must redraw! casters are culled below, together with the other lights.
+				// Full updates render every caster, otherwise they are culled to the ones that can shadow the camera frustum.
+				if (!_light_instance_setup_shadow(ins, light->is_shadow_update_full() ? -1 : regular_light_id, coverage, redraw, update_version)) {
 					light->make_shadow_dirty();
 				}
-				RENDER_TIMESTAMP("< Render Light3D " + itos(i));
 			} else {
-				if (redraw) {
+				if (redraw || update_version) {
 					light->make_shadow_dirty();
 				}
 			}
 		}
+
+		_cull_shadow_casters(scenario, p_shadow_atlas, p_visible_layers, r_render_info);
+
+		if (r_render_info) {
+			r_render_info->shadow_cull_usec += OS::get_singleton()->get_ticks_usec() - shadow_cull_begin;
+		}
 	}
 
 	//render SDFGI
@@ -4159,6 +4309,7 @@ bool RendererSceneCull::free(RID p_rid) {
 			instance_set_scenario(scenario->instances.first()->self()->self, RID());
 		}
 		scenario->instance_aabbs.reset();
+		scenario->instance_cull_blocks.reset();
 		scenario->instance_data.reset();
 		scenario->instance_visibility.reset();
 
@@ -4241,10 +4392,10 @@ RendererSceneCull::RendererSceneCull() {
 	singleton = this;
 
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
-	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
+		shadow_cull_jobs[i].casters.set_page_pool(&instance_cull_page_pool);
 	}
 	for (uint32_t i = 0; i < SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE; i++) {
 		render_sdfgi_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
@@ -4259,9 +4410,15 @@ RendererSceneCull::RendererSceneCull() {
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
+	cull_cache_margin = MAX((real_t)GLOBAL_GET("rendering/limits/spatial_indexer/cull_cache_margin"), 0);
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	if (int(GLOBAL_GET("rendering/occlusion_culling/method")) == RendererSceneOcclusionCull::METHOD_RASTERIZER) {
+		default_occlusion_culling = memnew(RasterOcclusionCull);
+	} else {
+		// Replaced by the raycast module when it's available.
+		default_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	}
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4272,10 +4429,10 @@ RendererSceneCull::RendererSceneCull() {
 
 RendererSceneCull::~RendererSceneCull() {
 	instance_cull_result.reset();
-	instance_shadow_cull_result.reset();
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.reset();
+		shadow_cull_jobs[i].casters.reset();
 	}
 	for (uint32_t i = 0; i < SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE; i++) {
 		render_sdfgi_data[i].instances.reset();
@@ -4287,8 +4444,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (default_occlusion_culling) {
+		memdelete(default_occlusion_culling);
 	}
 
 	if (light_culler) {
@@ -39,6 +39,7 @@
 #include "core/templates/pass_func.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
+#include "servers/rendering/renderer_scene_cull_blocks.h"
 #include "servers/rendering/renderer_scene_occlusion_cull.h"
 #include "servers/rendering/renderer_scene_render.h"
 #include "servers/rendering/rendering_method.h"
@@ -121,7 +122,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *default_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -319,6 +320,21 @@ public:
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 	PagedArrayPool<InstanceVisibilityData> instance_visibility_data_page_pool;
 
+	// Camera frustum cull results, kept between frames.
+	// They are computed against the frustum grown by cull_cache_margin, so they remain valid for instances
+	// that didn't change since, as long as no corner of the camera frustum moved further than the margin.
+	// Instances found inside the grown frustum are tested against the exact one every frame, into visible_masks.
+	struct CameraCullCache {
+		LocalVector<uint8_t> block_masks; // One bit per instance, see RendererSceneCullBlocks::cull_block().
+		LocalVector<uint8_t> visible_masks; // Only used when refined, block_masks hold the exact results otherwise.
+		RendererSceneCullBlocks::Planes planes;
+		Vector3 frustum_corners[8];
+		uint64_t version = 0;
+		uint32_t visible_layers = 0;
+		bool valid = false;
+		bool refined = false;
+	};
+
 	struct Scenario {
 		enum IndexerType {
 			INDEXER_GEOMETRY, //for geometry
@@ -346,6 +362,8 @@ public:
 
 		PagedArray<InstanceBounds> instance_aabbs;
 		PagedArray<InstanceData> instance_data;
+		RendererSceneCullBlocks instance_cull_blocks;
+		HashMap<RID, CameraCullCache> camera_cull_caches;
 		VisibilityArray instance_visibility;
 
 		Scenario() {
@@ -703,6 +721,11 @@ public:
 		RS::LightBakeMode bake_mode;
 		uint32_t max_sdfgi_cascade = 2;
 
+		// What was drawn the last time the shadow was updated, and where to.
+		// Used to skip updates that would draw the exact same casters again.
+		uint64_t shadow_caster_signature = 0;
+		RID shadow_caster_atlas;
+
 	private:
 		// Instead of a single dirty flag, we maintain a count
 		// so that we can detect lights that are being made dirty
@@ -877,7 +900,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct InstanceCullResult {
 		PagedArray<RenderGeometryInstance *> geometry_instances;
@@ -1005,10 +1027,44 @@ public:
 	RendererSceneRender::RenderShadowData render_shadow_data[MAX_UPDATE_SHADOWS];
 	uint32_t max_shadows_used = 0;
 
+	// One per omni/spot shadow pass, culled in parallel and merged into render_shadow_data afterwards.
+	struct ShadowCullJob {
+		Vector<Plane> planes;
+		int32_t regular_light_id = -1; // Caster culling planes in the light culler, -1 to keep all casters.
+		RID light_instance;
+		int pass = 0;
+		PagedArray<Instance *> casters;
+	};
+
+	struct ShadowCullLight {
+		Instance *instance = nullptr;
+		uint32_t first_job = 0;
+		uint32_t job_count = 0;
+		float coverage = 0.0;
+		bool atlas_redraw = false; // The light got a new spot in the shadow atlas, so it must be drawn.
+		bool update_version = false; // The light was dirty, it's drawn only if its casters changed.
+	};
+
+	struct ShadowCullData {
+		Scenario *scenario = nullptr;
+		uint32_t visible_layers = 0;
+	};
+
+	ShadowCullJob shadow_cull_jobs[MAX_UPDATE_SHADOWS];
+	uint32_t shadow_cull_job_count = 0;
+	LocalVector<ShadowCullLight> shadow_cull_lights;
+
+	static _FORCE_INLINE_ uint64_t _shadow_caster_hash(uint64_t p_id, uint64_t p_version, uint32_t p_pass) {
+		uint32_t h = hash_murmur3_one_64(p_id, hash_murmur3_one_32(p_pass));
+		return (uint64_t(hash_murmur3_one_64(p_version, h)) << 32) | hash_murmur3_one_64(p_version, ~h);
+	}
+
 	RendererSceneRender::RenderSDFGIData render_sdfgi_data[SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE];
 	RendererSceneRender::RenderSDFGIUpdateData sdfgi_update_data;
 
 	uint32_t thread_cull_threshold = 200;
+	real_t cull_cache_margin = 0.5;
+	CameraCullCache probe_cull_cache;
 
 	RID_Owner<Instance, true> instance_owner;
 
@@ -1074,7 +1130,10 @@ public:
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_mesh_lod_threshold, uint32_t p_visible_layers = 0xFFFFFF);
+	bool _light_instance_setup_shadow(Instance *p_instance, int32_t p_regular_light_id, float p_coverage, bool p_atlas_redraw, bool p_update_version);
+	void _add_shadow_cull_job(const Vector<Plane> &p_planes, int32_t p_regular_light_id, RID p_light_instance, int p_pass);
+	void _shadow_cull_job(uint32_t p_job, ShadowCullData *p_cull_data);
+	void _cull_shadow_casters(Scenario *p_scenario, RID p_shadow_atlas, uint32_t p_visible_layers, RenderingMethod::RenderInfo *r_render_info);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
 	RID _render_get_compositor(RID p_camera, RID p_scenario);
@@ -1140,8 +1199,22 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		const uint8_t *frustum_masks = nullptr;
+	};
+
+	struct CameraCullCacheUpdate {
+		CameraCullCache *cache = nullptr;
+		const RendererSceneCullBlocks *blocks = nullptr;
+		RendererSceneCullBlocks::Planes exact_planes;
+		bool reuse = false;
+		uint32_t thread_count = 1;
+		LocalVector<uint32_t> tested_counts;
 	};
 
+	void _update_camera_cull_cache(CameraCullCache &r_cache, const Scenario *p_scenario, const Transform3D &p_cam_transform, const Projection &p_cam_projection, const Vector<Plane> &p_planes, uint32_t p_visible_layers, bool p_persistent, RenderingMethod::RenderInfo *r_render_info);
+	void _camera_cull_cache_update_threaded(uint32_t p_thread, CameraCullCacheUpdate *p_update);
+	uint32_t _camera_cull_cache_update(CameraCullCacheUpdate &p_update, uint32_t p_from_block, uint32_t p_to_block);
+
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
@@ -0,0 +1,329 @@
+/**************************************************************************/
+/*  renderer_scene_cull_blocks.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "renderer_scene_cull_blocks.h"
+
+// The kernels work on single precision floats, double precision builds use the scalar version.
+#ifndef REAL_T_IS_DOUBLE
+#if defined(AVX2_ENABLED)
+// Only defined by math_defs.h when the compiler itself targets AVX2.
+#define CULL_BLOCKS_AVX2
+#include <immintrin.h>
+#elif defined(SSE_ENABLED) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+// Only SSE2 is needed, which every x86_64 CPU has.
+#define CULL_BLOCKS_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// Default builds don't target AVX2, so its kernel is compiled for it separately and picked at runtime.
+#define CULL_BLOCKS_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+#elif defined(NEON_ENABLED) && (defined(__aarch64__) || defined(_M_ARM64))
+#define CULL_BLOCKS_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+RendererSceneCullBlocks::Planes::Planes(const Plane *p_planes, uint32_t p_count) {
+	ERR_FAIL_COND(p_count > MAX_PLANES);
+
+	count = p_count;
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Plane &plane = p_planes[i];
+		normal_x[i] = plane.normal.x;
+		normal_y[i] = plane.normal.y;
+		normal_z[i] = plane.normal.z;
+		d[i] = plane.d;
+		signs[i][0] = plane.normal.x > 0 ? 0 : 3;
+		signs[i][1] = plane.normal.y > 0 ? 1 : 4;
+		signs[i][2] = plane.normal.z > 0 ? 2 : 5;
+	}
+}
+
+#if defined(CULL_BLOCKS_AVX2) || defined(CULL_BLOCKS_AVX2_DISPATCH)
+
+#ifdef CULL_BLOCKS_AVX2_DISPATCH
+__attribute__((target("avx2")))
+#endif
+static uint32_t _cull_block_avx2(const RendererSceneCullBlocks::Block &p_block, const RendererSceneCullBlocks::Planes &p_planes, uint32_t p_layer_mask) {
+	const __m256 zero = _mm256_setzero_ps();
+	__m256 outside = zero;
+
+	for (uint32_t i = 0; i < p_planes.count; i++) {
+		const __m256 x = _mm256_loadu_ps(p_block.bounds[p_planes.signs[i][0]]);
+		const __m256 y = _mm256_loadu_ps(p_block.bounds[p_planes.signs[i][1]]);
+		const __m256 z = _mm256_loadu_ps(p_block.bounds[p_planes.signs[i][2]]);
+		__m256 distance = _mm256_mul_ps(x, _mm256_set1_ps(p_planes.normal_x[i]));
+		distance = _mm256_add_ps(distance, _mm256_mul_ps(y, _mm256_set1_ps(p_planes.normal_y[i])));
+		distance = _mm256_add_ps(distance, _mm256_mul_ps(z, _mm256_set1_ps(p_planes.normal_z[i])));
+		distance = _mm256_sub_ps(distance, _mm256_set1_ps(p_planes.d[i]));
+		outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+	}
+
+	const __m256i zero_i = _mm256_setzero_si256();
+	const __m256i layers = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)p_block.layer_mask), _mm256_set1_epi32((int)p_layer_mask));
+	const __m256i ignore = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)p_block.cull_flags), _mm256_set1_epi32(RendererSceneCullBlocks::CULL_FLAG_IGNORE_ALL_CULLING));
+
+	const uint32_t outside_bits = _mm256_movemask_ps(outside);
+	const uint32_t hidden_bits = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(layers, zero_i)));
+	const uint32_t ignore_bits = ~uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(ignore, zero_i))));
+
+	return (~(outside_bits | hidden_bits) | ignore_bits) & 0xFF;
+}
+
+#endif
+
+#if defined(CULL_BLOCKS_AVX2)
+
+uint32_t RendererSceneCullBlocks::_cull_block(const Block &p_block, const Planes &p_planes, uint32_t p_layer_mask) {
+	return _cull_block_avx2(p_block, p_planes, p_layer_mask);
+}
+
+#elif defined(CULL_BLOCKS_SSE2)
+
+uint32_t RendererSceneCullBlocks::_cull_block(const Block &p_block, const Planes &p_planes, uint32_t p_layer_mask) {
+#ifdef CULL_BLOCKS_AVX2_DISPATCH
+	static const bool has_avx2 = __builtin_cpu_supports("avx2");
+	if (has_avx2) {
+		return _cull_block_avx2(p_block, p_planes, p_layer_mask);
+	}
+#endif
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128i zero_i = _mm_setzero_si128();
+	const __m128i layer_mask = _mm_set1_epi32((int)p_layer_mask);
+	const __m128i ignore_flag = _mm_set1_epi32(CULL_FLAG_IGNORE_ALL_CULLING);
+
+	uint32_t result = 0;
+
+	for (uint32_t half = 0; half < BLOCK_SIZE; half += 4) {
+		__m128 outside = zero;
+
+		for (uint32_t i = 0; i < p_planes.count; i++) {
+			const __m128 x = _mm_loadu_ps(p_block.bounds[p_planes.signs[i][0]] + half);
+			const __m128 y = _mm_loadu_ps(p_block.bounds[p_planes.signs[i][1]] + half);
+			const __m128 z = _mm_loadu_ps(p_block.bounds[p_planes.signs[i][2]] + half);
+			__m128 distance = _mm_mul_ps(x, _mm_set1_ps(p_planes.normal_x[i]));
+			distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(p_planes.normal_y[i])));
+			distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(p_planes.normal_z[i])));
+			distance = _mm_sub_ps(distance, _mm_set1_ps(p_planes.d[i]));
+			outside = _mm_or_ps(outside, _mm_cmpge_ps(distance, zero));
+		}
+
+		const __m128i layers = _mm_and_si128(_mm_loadu_si128((const __m128i *)(p_block.layer_mask + half)), layer_mask);
+		const __m128i ignore = _mm_and_si128(_mm_loadu_si128((const __m128i *)(p_block.cull_flags + half)), ignore_flag);
+
+		const uint32_t outside_bits = _mm_movemask_ps(outside);
+		const uint32_t hidden_bits = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(layers, zero_i)));
+		const uint32_t ignore_bits = ~uint32_t(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(ignore, zero_i))));
+
+		result |= ((~(outside_bits | hidden_bits) | ignore_bits) & 0xF) << half;
+	}
+
+	return result;
+}
+
+#elif defined(CULL_BLOCKS_NEON)
+
+uint32_t RendererSceneCullBlocks::_cull_block(const Block &p_block, const Planes &p_planes, uint32_t p_layer_mask) {
+	static const uint32_t lane_bits_data[4] = { 1, 2, 4, 8 };
+	const uint32x4_t lane_bits = vld1q_u32(lane_bits_data);
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const uint32x4_t layer_mask = vdupq_n_u32(p_layer_mask);
+	const uint32x4_t ignore_flag = vdupq_n_u32(CULL_FLAG_IGNORE_ALL_CULLING);
+
+	uint32_t result = 0;
+
+	for (uint32_t half = 0; half < BLOCK_SIZE; half += 4) {
+		uint32x4_t outside = vdupq_n_u32(0);
+
+		for (uint32_t i = 0; i < p_planes.count; i++) {
+			const float32x4_t x = vld1q_f32(p_block.bounds[p_planes.signs[i][0]] + half);
+			const float32x4_t y = vld1q_f32(p_block.bounds[p_planes.signs[i][1]] + half);
+			const float32x4_t z = vld1q_f32(p_block.bounds[p_planes.signs[i][2]] + half);
+			float32x4_t distance = vmulq_n_f32(x, p_planes.normal_x[i]);
+			distance = vaddq_f32(distance, vmulq_n_f32(y, p_planes.normal_y[i]));
+			distance = vaddq_f32(distance, vmulq_n_f32(z, p_planes.normal_z[i]));
+			distance = vsubq_f32(distance, vdupq_n_f32(p_planes.d[i]));
+			outside = vorrq_u32(outside, vcgeq_f32(distance, zero));
+		}
+
+		const uint32x4_t on_layer = vtstq_u32(vld1q_u32(p_block.layer_mask + half), layer_mask);
+		const uint32x4_t ignore = vtstq_u32(vld1q_u32(p_block.cull_flags + half), ignore_flag);
+		const uint32x4_t visible = vorrq_u32(vbicq_u32(on_layer, outside), ignore);
+
+		result |= vaddvq_u32(vandq_u32(visible, lane_bits)) << half;
+	}
+
+	return result;
+}
+
+#else
+
+uint32_t RendererSceneCullBlocks::_cull_block(const Block &p_block, const Planes &p_planes, uint32_t p_layer_mask) {
+	uint32_t result = 0;
+
+	for (uint32_t lane = 0; lane < BLOCK_SIZE; lane++) {
+		if (p_block.cull_flags[lane] & CULL_FLAG_IGNORE_ALL_CULLING) {
+			result |= 1 << lane;
+			continue;
+		}
+
+		if (!(p_block.layer_mask[lane] & p_layer_mask)) {
+			continue;
+		}
+
+		bool inside = true;
+
+		for (uint32_t i = 0; i < p_planes.count; i++) {
+			const real_t distance = p_block.bounds[p_planes.signs[i][0]][lane] * p_planes.normal_x[i] + p_block.bounds[p_planes.signs[i][1]][lane] * p_planes.normal_y[i] + p_block.bounds[p_planes.signs[i][2]][lane] * p_planes.normal_z[i] - p_planes.d[i];
+			if (distance >= 0.0) {
+				inside = false;
+				break;
+			}
+		}
+
+		if (inside) {
+			result |= 1 << lane;
+		}
+	}
+
+	return result;
+}
+
+#endif
+
+void RendererSceneCullBlocks::push_back(const AABB &p_aabb, uint32_t p_layer_mask, uint32_t p_cull_flags) {
+	if (count % BLOCK_SIZE == 0) {
+		Block block;
+		memset(&block, 0, sizeof(Block));
+		blocks.push_back(block);
+		block_versions.push_back(0);
+	}
+
+	count++;
+	set_aabb(count - 1, p_aabb);
+	set_layer_mask(count - 1, p_layer_mask);
+	set_cull_flags(count - 1, p_cull_flags);
+}
+
+void RendererSceneCullBlocks::pop_back() {
+	ERR_FAIL_COND(count == 0);
+
+	count--;
+
+	if (count % BLOCK_SIZE == 0) {
+		blocks.resize(blocks.size() - 1);
+		block_versions.resize(block_versions.size() - 1);
+	} else {
+		// Keep unused lanes cleared, so stale instances never show up as visible.
+		Block &block = blocks[count / BLOCK_SIZE];
+		const uint32_t lane = count % BLOCK_SIZE;
+		block.layer_mask[lane] = 0;
+		block.cull_flags[lane] = 0;
+		_block_changed(count / BLOCK_SIZE);
+	}
+}
+
+void RendererSceneCullBlocks::copy(uint32_t p_from, uint32_t p_to) {
+	ERR_FAIL_UNSIGNED_INDEX(p_from, count);
+	ERR_FAIL_UNSIGNED_INDEX(p_to, count);
+
+	const Block &from = blocks[p_from / BLOCK_SIZE];
+	const uint32_t from_lane = p_from % BLOCK_SIZE;
+	Block &to = blocks[p_to / BLOCK_SIZE];
+	const uint32_t to_lane = p_to % BLOCK_SIZE;
+
+	for (uint32_t i = 0; i < 6; i++) {
+		to.bounds[i][to_lane] = from.bounds[i][from_lane];
+	}
+	to.layer_mask[to_lane] = from.layer_mask[from_lane];
+	to.cull_flags[to_lane] = from.cull_flags[from_lane];
+	_block_changed(p_to / BLOCK_SIZE);
+}
+
+void RendererSceneCullBlocks::reset() {
+	blocks.reset();
+	block_versions.reset();
+	count = 0;
+}
+
+void RendererSceneCullBlocks::set_aabb(uint32_t p_index, const AABB &p_aabb) {
+	ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+
+	Block &block = blocks[p_index / BLOCK_SIZE];
+	const uint32_t lane = p_index % BLOCK_SIZE;
+	block.bounds[0][lane] = p_aabb.position.x;
+	block.bounds[1][lane] = p_aabb.position.y;
+	block.bounds[2][lane] = p_aabb.position.z;
+	block.bounds[3][lane] = p_aabb.position.x + p_aabb.size.x;
+	block.bounds[4][lane] = p_aabb.position.y + p_aabb.size.y;
+	block.bounds[5][lane] = p_aabb.position.z + p_aabb.size.z;
+	_block_changed(p_index / BLOCK_SIZE);
+}
+
+void RendererSceneCullBlocks::set_layer_mask(uint32_t p_index, uint32_t p_layer_mask) {
+	ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+	blocks[p_index / BLOCK_SIZE].layer_mask[p_index % BLOCK_SIZE] = p_layer_mask;
+	_block_changed(p_index / BLOCK_SIZE);
+}
+
+void RendererSceneCullBlocks::set_cull_flags(uint32_t p_index, uint32_t p_cull_flags) {
+	ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+	blocks[p_index / BLOCK_SIZE].cull_flags[p_index % BLOCK_SIZE] = p_cull_flags;
+	_block_changed(p_index / BLOCK_SIZE);
+}
+
+uint64_t RendererSceneCullBlocks::cull(const Planes &p_planes, uint32_t p_layer_mask, uint32_t p_from, uint32_t p_count) const {
+	ERR_FAIL_COND_V(p_count > MAX_CULL_COUNT, 0);
+	ERR_FAIL_COND_V(p_from + p_count > count, 0);
+
+	if (p_count == 0) {
+		return 0;
+	}
+
+	const uint32_t first_block = p_from / BLOCK_SIZE;
+	const uint32_t last_block = (p_from + p_count - 1) / BLOCK_SIZE;
+	const uint32_t first_lane = p_from % BLOCK_SIZE;
+
+	uint64_t result = _cull_block(blocks[first_block], p_planes, p_layer_mask) >> first_lane;
+	uint32_t shift = BLOCK_SIZE - first_lane;
+
+	for (uint32_t i = first_block + 1; i <= last_block; i++) {
+		result |= uint64_t(_cull_block(blocks[i], p_planes, p_layer_mask)) << shift;
+		shift += BLOCK_SIZE;
+	}
+
+	if (p_count < MAX_CULL_COUNT) {
+		result &= (uint64_t(1) << p_count) - 1;
+	}
+
+	return result;
+}
@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  renderer_scene_cull_blocks.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RENDERER_SCENE_CULL_BLOCKS_H
+#define RENDERER_SCENE_CULL_BLOCKS_H
+
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/templates/local_vector.h"
+
+// Structure-of-arrays copy of the data needed to frustum cull scenario instances,
+// stored in blocks of BLOCK_SIZE instances so that a whole block can be tested at once with SIMD.
+// Indices match the scenario's instance_data and instance_aabbs arrays.
+class RendererSceneCullBlocks {
+public:
+	enum CullFlags {
+		CULL_FLAG_IGNORE_ALL_CULLING = (1 << 0),
+	};
+
+	enum {
+		BLOCK_SIZE = 8,
+		MAX_PLANES = 8,
+		MAX_CULL_COUNT = 64,
+	};
+
+	struct Block {
+		// Same order as InstanceBounds: min x, y, z, then max x, y, z.
+		real_t bounds[6][BLOCK_SIZE];
+		uint32_t layer_mask[BLOCK_SIZE];
+		uint32_t cull_flags[BLOCK_SIZE];
+	};
+
+	struct Planes {
+		real_t normal_x[MAX_PLANES];
+		real_t normal_y[MAX_PLANES];
+		real_t normal_z[MAX_PLANES];
+		real_t d[MAX_PLANES];
+		// Index into Block::bounds of the corner closest to the inside of each plane.
+		uint32_t signs[MAX_PLANES][3];
+		uint32_t count = 0;
+
+		Planes() {}
+		Planes(const Plane *p_planes, uint32_t p_count);
+	};
+
+private:
+	LocalVector<Block> blocks;
+	// Value of version when each block last changed, so cached cull results can tell which blocks are stale.
+	LocalVector<uint64_t> block_versions;
+	uint64_t version = 0;
+	uint32_t count = 0;
+
+	_FORCE_INLINE_ void _block_changed(uint32_t p_block) { block_versions[p_block] = ++version; }
+
+	static uint32_t _cull_block(const Block &p_block, const Planes &p_planes, uint32_t p_layer_mask);
+
+public:
+	void push_back(const AABB &p_aabb, uint32_t p_layer_mask, uint32_t p_cull_flags);
+	void pop_back();
+	void copy(uint32_t p_from, uint32_t p_to);
+	void reset();
+
+	void set_aabb(uint32_t p_index, const AABB &p_aabb);
+	void set_layer_mask(uint32_t p_index, uint32_t p_layer_mask);
+	void set_cull_flags(uint32_t p_index, uint32_t p_cull_flags);
+
+	_FORCE_INLINE_ uint32_t size() const { return count; }
+	_FORCE_INLINE_ uint32_t get_block_count() const { return blocks.size(); }
+	_FORCE_INLINE_ uint64_t get_version() const { return version; }
+	_FORCE_INLINE_ uint64_t get_block_version(uint32_t p_block) const { return block_versions[p_block]; }
+
+	// Same as cull(), for the BLOCK_SIZE instances of a single block.
+	_FORCE_INLINE_ uint32_t cull_block(uint32_t p_block, const Planes &p_planes, uint32_t p_layer_mask) const {
+		return _cull_block(blocks[p_block], p_planes, p_layer_mask);
+	}
+
+	// Tests up to MAX_CULL_COUNT instances starting at p_from, and returns one bit per instance.
+	// A bit is set when the instance is inside the frustum and on one of the given layers, or when it ignores culling.
+	// Like InstanceBounds::in_frustum, this is not a full SAT check, so false positives are possible.
+	uint64_t cull(const Planes &p_planes, uint32_t p_layer_mask, uint32_t p_from, uint32_t p_count) const;
+};
+
+#endif // RENDERER_SCENE_CULL_BLOCKS_H
@@ -39,7 +39,14 @@ class RendererSceneOcclusionCull {
 protected:
 	static RendererSceneOcclusionCull *singleton;
 
+	Projection _jitter_projection(const Projection &p_cam_projection, const Size2i &p_viewport_size) const;
+
 public:
+	enum Method {
+		METHOD_RAYCAST,
+		METHOD_RASTERIZER,
+	};
+
 	class HZBuffer {
 	protected:
 		static const Vector3 corners[8];
@@ -273,6 +273,7 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 			p_viewport->render_info.info[i][j] = 0;
 		}
 	}
+	p_viewport->render_info.shadow_cull_usec = 0;
 
 	if (RSG::scene->is_scenario(p_viewport->scenario)) {
 		RID environment = RSG::scene->scenario_get_environment(p_viewport->scenario);
@@ -745,6 +746,7 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 	int vertices_drawn = 0;
 	int objects_drawn = 0;
 	int draw_calls_used = 0;
+	uint64_t shadow_cull_time = 0;
 
 	for (int i = 0; i < sorted_active_viewports.size(); i++) {
 		Viewport *vp = sorted_active_viewports[i];
@@ -835,6 +837,7 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 		objects_drawn += vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] + vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME];
 		vertices_drawn += vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] + vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME];
 		draw_calls_used += vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME] + vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME];
+		shadow_cull_time += vp->render_info.shadow_cull_usec;
 		// 2D render info.
 		objects_drawn += vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME];
 		vertices_drawn += vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME];
@@ -845,6 +848,7 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 	total_objects_drawn = objects_drawn;
 	total_vertices_drawn = vertices_drawn;
 	total_draw_calls_used = draw_calls_used;
+	total_shadow_cull_time = shadow_cull_time;
 
 	RENDER_TIMESTAMP("< Render Viewports");
 
@@ -1540,6 +1544,9 @@ int RendererViewport::get_total_primitives_drawn() const {
 int RendererViewport::get_total_draw_calls_used() const {
 	return total_draw_calls_used;
 }
+uint64_t RendererViewport::get_total_shadow_cull_time() const {
+	return total_shadow_cull_time;
+}
 
 int RendererViewport::get_num_viewports_with_motion_vectors() const {
 	return num_viewports_with_motion_vectors;
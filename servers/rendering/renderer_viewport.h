@@ -199,6 +199,7 @@ public:
 	int total_objects_drawn = 0;
 	int total_vertices_drawn = 0;
 	int total_draw_calls_used = 0;
+	uint64_t total_shadow_cull_time = 0;
 
 	int num_viewports_with_motion_vectors = 0;
 
@@ -308,6 +309,7 @@ public:
 	int get_total_objects_drawn() const;
 	int get_total_primitives_drawn() const;
 	int get_total_draw_calls_used() const;
+	uint64_t get_total_shadow_cull_time() const;
 	int get_num_viewports_with_motion_vectors() const;
 
 	// Workaround for setting this on thread.
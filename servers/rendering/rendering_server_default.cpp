@@ -281,6 +281,8 @@ uint64_t RenderingServerDefault::get_rendering_info(RenderingInfo p_info) {
 		return RSG::viewport->get_total_primitives_drawn();
 	} else if (p_info == RENDERING_INFO_TOTAL_DRAW_CALLS_IN_FRAME) {
 		return RSG::viewport->get_total_draw_calls_used();
+	} else if (p_info == RENDERING_INFO_SHADOW_CULL_TIME) {
+		return RSG::viewport->get_total_shadow_cull_time();
 	}
 	return RSG::utilities->get_rendering_info(p_info);
 }
@@ -981,6 +981,9 @@ public:
 		VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME,
 		VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME,
 		VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME,
+		VIEWPORT_RENDER_INFO_CULL_TESTED_IN_FRAME,
+		VIEWPORT_RENDER_INFO_CULL_CACHED_IN_FRAME,
+		VIEWPORT_RENDER_INFO_SHADOW_LIGHTS_SKIPPED_IN_FRAME,
 		VIEWPORT_RENDER_INFO_MAX,
 	};
 
@@ -1657,6 +1660,7 @@ public:
 		RENDERING_INFO_TEXTURE_MEM_USED,
 		RENDERING_INFO_BUFFER_MEM_USED,
 		RENDERING_INFO_VIDEO_MEM_USED,
+		RENDERING_INFO_SHADOW_CULL_TIME,
 		RENDERING_INFO_MAX
 	};
 
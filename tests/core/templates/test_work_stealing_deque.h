@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WORK_STEALING_DEQUE_H
+#define TEST_WORK_STEALING_DEQUE_H
+
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner pops in LIFO order, thieves steal in FIFO order") {
+	WorkStealingDeque<uint32_t, 8> deque;
+	uint32_t value = 0;
+
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.pop(value));
+	CHECK_FALSE(deque.steal(value));
+
+	for (uint32_t i = 1; i <= 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.is_empty());
+
+	CHECK(deque.pop(value));
+	CHECK(value == 4);
+	CHECK(deque.steal(value));
+	CHECK(value == 1);
+	CHECK(deque.pop(value));
+	CHECK(value == 3);
+	CHECK(deque.steal(value));
+	CHECK(value == 2);
+
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.pop(value));
+}
+
+TEST_CASE("[WorkStealingDeque] Push fails when full") {
+	WorkStealingDeque<uint32_t, 4> deque;
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.push(4));
+
+	uint32_t value = 0;
+	CHECK(deque.steal(value));
+	CHECK(value == 0);
+	CHECK(deque.push(4)); // Wraps around.
+
+	for (uint32_t i = 4; i > 0; i--) {
+		CHECK(deque.pop(value));
+		CHECK(value == i);
+	}
+	CHECK(deque.is_empty());
+}
+
+static const uint32_t STRESS_ELEMENTS = 100000;
+
+struct StressData {
+	WorkStealingDeque<uint32_t, 64> deque;
+	LocalVector<SafeNumeric<uint32_t>> taken;
+	SafeFlag done;
+};
+
+static void stress_thief(void *p_userdata) {
+	StressData *data = (StressData *)p_userdata;
+	uint32_t value = 0;
+	while (!data->done.is_set()) {
+		if (data->deque.steal(value)) {
+			data->taken[value].increment();
+		}
+	}
+	while (data->deque.steal(value)) {
+		data->taken[value].increment();
+	}
+}
+
+TEST_CASE("[WorkStealingDeque] Every element is taken exactly once under contention") {
+	StressData data;
+	data.taken.resize(STRESS_ELEMENTS);
+
+	Thread thieves[3];
+	for (Thread &thief : thieves) {
+		thief.start(stress_thief, &data);
+	}
+
+	uint32_t value = 0;
+	for (uint32_t i = 0; i < STRESS_ELEMENTS; i++) {
+		while (!data.deque.push(i)) {
+			if (data.deque.pop(value)) {
+				data.taken[value].increment();
+			}
+		}
+		if (i % 3 == 0 && data.deque.pop(value)) {
+			data.taken[value].increment();
+		}
+	}
+	while (data.deque.pop(value)) {
+		data.taken[value].increment();
+	}
+
+	data.done.set();
+	for (Thread &thief : thieves) {
+		thief.wait_to_finish();
+	}
+
+	bool all_taken_once = true;
+	for (uint32_t i = 0; i < STRESS_ELEMENTS; i++) {
+		// Reduce number of check messages.
+		all_taken_once &= data.taken[i].get() == 1;
+	}
+	CHECK(all_taken_once);
+}
+
+} // namespace TestWorkStealingDeque
+
+#endif // TEST_WORK_STEALING_DEQUE_H
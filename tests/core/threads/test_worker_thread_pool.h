@@ -173,6 +173,60 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static const int BENCHMARK_SUBTASK_COUNT = 64;
+
+static void static_benchmark_subtask(void *p_arg) {
+	counter[0].increment();
+}
+
+static void static_benchmark_task(void *p_arg) {
+	// Tasks posted from pool threads go to the local queue of the posting thread, others have to steal them.
+	WorkerThreadPool::TaskID subtasks[BENCHMARK_SUBTASK_COUNT];
+	for (int i = 0; i < BENCHMARK_SUBTASK_COUNT; i++) {
+		subtasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_benchmark_subtask, nullptr, true);
+	}
+	for (int i = 0; i < BENCHMARK_SUBTASK_COUNT; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(subtasks[i]);
+	}
+}
+
+static void static_benchmark_group_element(void *p_arg, uint32_t p_index) {
+	counter[1].increment();
+}
+
+// Too slow for the default run, use `--no-skip` to include it.
+TEST_CASE("[WorkerThreadPool] Benchmark scheduling of many small tasks" * doctest::skip()) {
+	counter.clear();
+	counter.resize(2);
+
+	const int task_count = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 16;
+	const int group_count = 200;
+	const int group_elements = 256;
+
+	const uint64_t tasks_begin = OS::get_singleton()->get_ticks_usec();
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
+	task_ids.resize(task_count);
+	for (int i = 0; i < task_count; i++) {
+		task_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_benchmark_task, nullptr, true);
+	}
+	for (int i = 0; i < task_count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_ids[i]);
+	}
+	const uint64_t tasks_end = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < group_count; i++) {
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(static_benchmark_group_element, nullptr, group_elements, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	}
+	const uint64_t groups_end = OS::get_singleton()->get_ticks_usec();
+
+	CHECK(counter[0].get() == task_count * BENCHMARK_SUBTASK_COUNT);
+	CHECK(counter[1].get() == group_count * group_elements);
+
+	MESSAGE(vformat("Nested tasks: %d in %d usec.", task_count * (BENCHMARK_SUBTASK_COUNT + 1), tasks_end - tasks_begin).utf8().get_data());
+	MESSAGE(vformat("Group tasks: %d groups of %d elements in %d usec.", group_count, group_elements, groups_end - tasks_end).utf8().get_data());
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
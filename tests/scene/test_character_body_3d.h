@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  test_character_body_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CHARACTER_BODY_3D_H
+#define TEST_CHARACTER_BODY_3D_H
+
+#include "scene/3d/physics/character_body_3d.h"
+#include "scene/3d/physics/collision_shape_3d.h"
+#include "scene/3d/physics/static_body_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/3d/box_shape_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCharacterBody3D {
+
+constexpr double FRAME_STEP = 1.0 / 60.0;
+
+struct SlideResult {
+	Vector3 position;
+	Vector3 velocity;
+	bool on_wall = false;
+	bool on_ceiling = false;
+};
+
+static CollisionShape3D *make_box(const Vector3 &p_size) {
+	Ref<BoxShape3D> shape;
+	shape.instantiate();
+	shape->set_size(p_size);
+
+	CollisionShape3D *collision_shape = memnew(CollisionShape3D);
+	collision_shape->set_shape(shape);
+	return collision_shape;
+}
+
+// Moves a 1x1x1 character against a single obstacle for a few frames.
+static SlideResult slide_against(const Vector3 &p_obstacle_position, const Vector3 &p_obstacle_size, const Vector3 &p_from, const Vector3 &p_velocity, bool p_native_controller, bool p_slide_on_ceiling) {
+	Window *root = SceneTree::get_singleton()->get_root();
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	StaticBody3D *obstacle = memnew(StaticBody3D);
+	obstacle->add_child(make_box(p_obstacle_size));
+	obstacle->set_position(p_obstacle_position);
+	root->add_child(obstacle);
+
+	CharacterBody3D *character = memnew(CharacterBody3D);
+	character->add_child(make_box(Vector3(1, 1, 1)));
+	character->set_position(p_from);
+	character->set_native_controller_enabled(p_native_controller);
+	character->set_slide_on_ceiling_enabled(p_slide_on_ceiling);
+	root->add_child(character);
+
+	// move_and_slide() takes the process delta outside of physics frames.
+	SceneTree::get_singleton()->process(FRAME_STEP);
+
+	server->set_active(true);
+	server->step(FRAME_STEP);
+
+	SlideResult result;
+	character->set_velocity(p_velocity);
+
+	for (int i = 0; i < 10; ++i) {
+		character->move_and_slide();
+		result.on_wall |= character->is_on_wall();
+		result.on_ceiling |= character->is_on_ceiling();
+		server->step(FRAME_STEP);
+	}
+
+	server->set_active(false);
+
+	result.position = character->get_position();
+	result.velocity = character->get_velocity();
+
+	root->remove_child(character);
+	root->remove_child(obstacle);
+	memdelete(character);
+	memdelete(obstacle);
+
+	return result;
+}
+
+TEST_CASE("[SceneTree][CharacterBody3D] The native controller should slide like the motion tests") {
+	bool slide_on_ceiling = true;
+
+	SUBCASE("Hitting a wall") {
+		const Vector3 wall_position(3, 0, 0);
+		const Vector3 wall_size(2, 10, 10);
+		const Vector3 velocity(10, 0, 1);
+
+		const SlideResult expected = slide_against(wall_position, wall_size, Vector3(0, 0, 0), velocity, false, slide_on_ceiling);
+		const SlideResult result = slide_against(wall_position, wall_size, Vector3(0, 0, 0), velocity, true, slide_on_ceiling);
+
+		REQUIRE(expected.on_wall);
+		CHECK(result.on_wall);
+		CHECK(result.velocity.is_equal_approx(expected.velocity));
+		CHECK(result.velocity.x == doctest::Approx(0.0));
+		CHECK(result.position.x == doctest::Approx(expected.position.x).epsilon(0.05));
+	}
+
+	SUBCASE("Hitting a ceiling") {
+		const Vector3 ceiling_position(0, 3, 0);
+		const Vector3 ceiling_size(10, 2, 10);
+		const Vector3 velocity(1, 10, 0);
+
+		SUBCASE("With ceiling sliding") {
+			slide_on_ceiling = true;
+		}
+
+		SUBCASE("Without ceiling sliding") {
+			slide_on_ceiling = false;
+		}
+
+		const SlideResult expected = slide_against(ceiling_position, ceiling_size, Vector3(0, 0, 0), velocity, false, slide_on_ceiling);
+		const SlideResult result = slide_against(ceiling_position, ceiling_size, Vector3(0, 0, 0), velocity, true, slide_on_ceiling);
+
+		REQUIRE(expected.on_ceiling);
+		CHECK(result.on_ceiling);
+		CHECK(result.velocity.is_equal_approx(expected.velocity));
+		CHECK(result.velocity.y == doctest::Approx(0.0));
+		CHECK(result.position.y == doctest::Approx(expected.position.y).epsilon(0.05));
+	}
+}
+
+} // namespace TestCharacterBody3D
+
+#endif // TEST_CHARACTER_BODY_3D_H
@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// Creating a RasterOcclusionCull replaces the singleton of the rendering server, which has to be put back afterwards.
+class TestRasterOcclusionCull : public RasterOcclusionCull {
+public:
+	static void restore_singleton(RendererSceneOcclusionCull *p_singleton) { singleton = p_singleton; }
+};
+
+static bool is_box_occluded(RendererSceneOcclusionCull::HZBuffer *p_buffer, const Vector3 &p_center, const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	const AABB aabb(p_center - Vector3(0.5, 0.5, 0.5), Vector3(1, 1, 1));
+	const Vector3 end = aabb.get_end();
+	const real_t bounds[6] = { aabb.position.x, aabb.position.y, aabb.position.z, end.x, end.y, end.z };
+
+	uint64_t occlusion_timeout = 0;
+	return p_buffer->is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near(), occlusion_timeout);
+}
+
+TEST_CASE("[RasterOcclusionCull] Boxes behind a rasterized quad are occluded") {
+	RendererSceneOcclusionCull *main_occlusion_cull = RendererSceneOcclusionCull::get_singleton();
+	const bool jitter_enabled = RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled;
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = false;
+
+	RasterOcclusionCull *occlusion_cull = memnew(TestRasterOcclusionCull);
+
+	const RID scenario = RID::from_uint64(1);
+	const RID instance = RID::from_uint64(2);
+	const RID buffer = RID::from_uint64(3);
+
+	// A 4x4 quad facing the camera, 5 units in front of it.
+	PackedVector3Array vertices;
+	vertices.push_back(Vector3(-2, -2, 0));
+	vertices.push_back(Vector3(2, -2, 0));
+	vertices.push_back(Vector3(2, 2, 0));
+	vertices.push_back(Vector3(-2, 2, 0));
+
+	PackedInt32Array indices;
+	indices.push_back(0);
+	indices.push_back(1);
+	indices.push_back(2);
+	indices.push_back(0);
+	indices.push_back(2);
+	indices.push_back(3);
+
+	const RID occluder = occlusion_cull->occluder_allocate();
+	occlusion_cull->occluder_initialize(occluder);
+	occlusion_cull->occluder_set_mesh(occluder, vertices, indices);
+
+	occlusion_cull->add_scenario(scenario);
+	occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -5)), true);
+
+	occlusion_cull->add_buffer(buffer);
+	occlusion_cull->buffer_set_scenario(buffer, scenario);
+	occlusion_cull->buffer_set_size(buffer, Vector2i(64, 64));
+
+	const Transform3D cam_transform;
+	Projection cam_projection;
+	cam_projection.set_perspective(90.0, 1.0, 0.1, 100.0);
+
+	occlusion_cull->buffer_update(buffer, cam_transform, cam_projection, false);
+
+	RendererSceneOcclusionCull::HZBuffer *hz_buffer = occlusion_cull->buffer_get_ptr(buffer);
+	REQUIRE(hz_buffer != nullptr);
+
+	CHECK_MESSAGE(is_box_occluded(hz_buffer, Vector3(0, 0, -10), cam_transform, cam_projection), "A box behind the quad should be occluded.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(hz_buffer, Vector3(6, 0, -10), cam_transform, cam_projection), "A box beside the quad should not be occluded.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(hz_buffer, Vector3(0, 0, -3), cam_transform, cam_projection), "A box in front of the quad should not be occluded.");
+
+	// Disabled occluders aren't rasterized at all.
+	occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -5)), false);
+	occlusion_cull->buffer_update(buffer, cam_transform, cam_projection, false);
+	CHECK_FALSE_MESSAGE(is_box_occluded(hz_buffer, Vector3(0, 0, -10), cam_transform, cam_projection), "A box behind a disabled quad should not be occluded.");
+
+	occlusion_cull->remove_buffer(buffer);
+	occlusion_cull->scenario_remove_instance(scenario, instance);
+	occlusion_cull->remove_scenario(scenario);
+	occlusion_cull->free_occluder(occluder);
+	memdelete(occlusion_cull);
+
+	TestRasterOcclusionCull::restore_singleton(main_occlusion_cull);
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = jitter_enabled;
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,188 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull_blocks.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_BLOCKS_H
+#define TEST_RENDERER_SCENE_CULL_BLOCKS_H
+
+#include "core/math/projection.h"
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_scene_cull_blocks.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCullBlocks {
+
+static Vector<Plane> make_frustum() {
+	Projection projection;
+	projection.set_perspective(70.0, 16.0 / 9.0, 0.05, 200.0);
+	return projection.get_projection_planes(Transform3D(Basis(Vector3(0, 1, 0), 0.4), Vector3(0, 2, 0)));
+}
+
+// Reference version, same logic as RendererSceneCull::InstanceBounds::in_frustum.
+static bool in_frustum(const AABB &p_aabb, const Vector<Plane> &p_planes) {
+	const Vector3 end = p_aabb.get_end();
+	for (const Plane &plane : p_planes) {
+		const Vector3 corner(
+				plane.normal.x > 0 ? p_aabb.position.x : end.x,
+				plane.normal.y > 0 ? p_aabb.position.y : end.y,
+				plane.normal.z > 0 ? p_aabb.position.z : end.z);
+		if (plane.distance_to(corner) >= 0.0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void fill_random(RendererSceneCullBlocks &r_blocks, LocalVector<AABB> &r_aabbs, uint32_t p_count) {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Vector3 position(rng->randf_range(-300, 300), rng->randf_range(-20, 20), rng->randf_range(-300, 300));
+		const AABB aabb(position, Vector3(rng->randf_range(0.1, 4), rng->randf_range(0.1, 4), rng->randf_range(0.1, 4)));
+		r_aabbs.push_back(aabb);
+		r_blocks.push_back(aabb, 1 << (i % 4), 0);
+	}
+}
+
+TEST_CASE("[RendererSceneCullBlocks] Frustum culling matches the scalar test") {
+	const Vector<Plane> planes = make_frustum();
+	const RendererSceneCullBlocks::Planes cull_planes(planes.ptr(), planes.size());
+
+	RendererSceneCullBlocks blocks;
+	LocalVector<AABB> aabbs;
+	fill_random(blocks, aabbs, 1000);
+
+	const uint32_t layer_mask = 0b0101;
+	uint32_t mismatches = 0;
+
+	// Odd offsets and counts make sure batches don't have to line up with blocks.
+	for (uint32_t from = 3; from < aabbs.size(); from += 61) {
+		const uint32_t count = MIN(61u, aabbs.size() - from);
+		const uint64_t bits = blocks.cull(cull_planes, layer_mask, from, count);
+
+		for (uint32_t i = 0; i < count; i++) {
+			const uint32_t index = from + i;
+			const bool expected = ((1u << (index % 4)) & layer_mask) && in_frustum(aabbs[index], planes);
+			if (bool(bits & (uint64_t(1) << i)) != expected) {
+				mismatches++;
+			}
+		}
+
+		CHECK_EQ(bits >> count, 0u);
+	}
+
+	CHECK_EQ(mismatches, 0u);
+
+	// Removing by swapping with the last instance, like the scenario does.
+	blocks.copy(aabbs.size() - 1, 0);
+	blocks.pop_back();
+	blocks.set_cull_flags(0, RendererSceneCullBlocks::CULL_FLAG_IGNORE_ALL_CULLING);
+	blocks.set_layer_mask(1, 0);
+
+	const uint64_t bits = blocks.cull(cull_planes, layer_mask, 0, 2);
+	CHECK_EQ(bits, 1u);
+	CHECK_EQ(blocks.size(), aabbs.size() - 1);
+}
+
+TEST_CASE("[RendererSceneCullBlocks] Block versions track changes") {
+	RendererSceneCullBlocks blocks;
+	for (int i = 0; i < 20; i++) {
+		blocks.push_back(AABB(Vector3(i, 0, 0), Vector3(1, 1, 1)), 1, 0);
+	}
+	CHECK(blocks.get_block_count() == 3);
+
+	const uint64_t version = blocks.get_version();
+	for (uint32_t i = 0; i < blocks.get_block_count(); i++) {
+		CHECK(blocks.get_block_version(i) <= version);
+	}
+
+	blocks.set_aabb(9, AABB(Vector3(0, 5, 0), Vector3(1, 1, 1)));
+	CHECK_MESSAGE(blocks.get_block_version(0) <= version, "Unchanged blocks should keep their version.");
+	CHECK_MESSAGE(blocks.get_block_version(1) > version, "Changed blocks should get a newer version.");
+	CHECK_MESSAGE(blocks.get_block_version(2) <= version, "Unchanged blocks should keep their version.");
+
+	const uint64_t version_after_move = blocks.get_version();
+	blocks.copy(19, 3);
+	blocks.pop_back();
+	CHECK(blocks.get_block_version(0) > version_after_move);
+	CHECK(blocks.get_block_version(2) > version_after_move);
+	CHECK(blocks.get_block_version(1) <= version_after_move);
+
+	const Vector<Plane> planes = make_frustum();
+	const RendererSceneCullBlocks::Planes cull_planes(planes.ptr(), planes.size());
+	blocks.set_cull_flags(17, RendererSceneCullBlocks::CULL_FLAG_IGNORE_ALL_CULLING);
+	CHECK_EQ(uint64_t(blocks.cull_block(2, cull_planes, 1)), blocks.cull(cull_planes, 1, 16, 3));
+	CHECK((blocks.cull_block(2, cull_planes, 1) & 0b10) != 0);
+}
+
+// Too slow for the default run, use `--no-skip` to include it.
+TEST_CASE("[RendererSceneCullBlocks] Benchmark culling one million instances" * doctest::skip()) {
+	constexpr uint32_t INSTANCE_COUNT = 1000000;
+	constexpr int FRAME_COUNT = 10;
+
+	const Vector<Plane> planes = make_frustum();
+	const RendererSceneCullBlocks::Planes cull_planes(planes.ptr(), planes.size());
+
+	RendererSceneCullBlocks blocks;
+	LocalVector<AABB> aabbs;
+	fill_random(blocks, aabbs, INSTANCE_COUNT);
+
+	uint32_t visible_count = 0;
+	const uint64_t blocks_begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		for (uint32_t from = 0; from < INSTANCE_COUNT; from += RendererSceneCullBlocks::MAX_CULL_COUNT) {
+			const uint32_t count = MIN(uint32_t(RendererSceneCullBlocks::MAX_CULL_COUNT), INSTANCE_COUNT - from);
+			for (uint64_t bits = blocks.cull(cull_planes, 0xFFFFFFFF, from, count); bits != 0; bits &= bits - 1) {
+				visible_count++;
+			}
+		}
+	}
+	const uint64_t blocks_end = OS::get_singleton()->get_ticks_usec();
+
+	uint32_t expected_count = 0;
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		for (const AABB &aabb : aabbs) {
+			expected_count += in_frustum(aabb, planes);
+		}
+	}
+	const uint64_t scalar_end = OS::get_singleton()->get_ticks_usec();
+
+	CHECK_EQ(visible_count, expected_count);
+
+	MESSAGE(vformat("SoA blocks: %d instances in %d usec per frame.", INSTANCE_COUNT, (blocks_end - blocks_begin) / FRAME_COUNT).utf8().get_data());
+	MESSAGE(vformat("Scalar AABBs: %d instances in %d usec per frame.", INSTANCE_COUNT, (scalar_end - blocks_end) / FRAME_COUNT).utf8().get_data());
+}
+
+} // namespace TestRendererSceneCullBlocks
+
+#endif // TEST_RENDERER_SCENE_CULL_BLOCKS_H
@@ -31,6 +31,7 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -76,6 +77,9 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 0);
 			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 0);
 			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), 0);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_CLUSTER_COUNT), 0);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_CACHE_HIT_COUNT), 0);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_CACHE_MISS_COUNT), 0);
 		}
 	}
 
@@ -634,7 +638,10 @@ TEST_SUITE("[Navigation]") {
 		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
 		CHECK_NE(navigation_mesh->get_vertices().size(), 0);
 
+		// The path cache is disabled by default, and maps read its size on creation.
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/path_cache_size", 16);
 		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/path_cache_size", 0);
 		RID region = navigation_server->region_create();
 		navigation_server->map_set_active(map, true);
 		navigation_server->region_set_map(region, map);
@@ -651,6 +658,28 @@ TEST_SUITE("[Navigation]") {
 			CHECK_NE(navigation_server->map_get_path(map, Vector3(0, 0, 0), Vector3(10, 0, 10), false).size(), 0);
 		}
 
+		SUBCASE("Path should start and end on the closest points of the map") {
+			const Vector3 origin = Vector3(-3.0, 2.0, 4.0);
+			const Vector3 destination = Vector3(12.0, -1.0, -7.0);
+			Vector<Vector3> path = navigation_server->map_get_path(map, origin, destination, true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[0].is_equal_approx(navigation_server->map_get_closest_point(map, origin)));
+			CHECK(path[path.size() - 1].is_equal_approx(navigation_server->map_get_closest_point(map, destination)));
+		}
+
+		SUBCASE("Repeated path queries should be served from the path cache") {
+			const Vector3 origin = Vector3(-4.5, 0.0, -4.5);
+			const Vector3 destination = Vector3(4.5, 0.0, 4.5);
+			Vector<Vector3> path = navigation_server->map_get_path(map, origin, destination, true);
+			Vector<Vector3> cached_path = navigation_server->map_get_path(map, origin, destination, true);
+			CHECK_NE(path.size(), 0);
+			CHECK_EQ(cached_path, path);
+
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_CACHE_MISS_COUNT), 1);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_CACHE_HIT_COUNT), 1);
+		}
+
 		SUBCASE("'map_get_closest_point_to_segment' with 'use_collision' should return default if segment doesn't intersect map") {
 			CHECK_EQ(navigation_server->map_get_closest_point_to_segment(map, Vector3(1, 2, 1), Vector3(1, 1, 1), true), Vector3());
 		}
@@ -711,9 +740,229 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched queries should yield the same results as single queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(i - 8, 0, -5));
+				query_parameters->set_target_position(Vector3(8 - i, 0, 5));
+				batch_parameters.push_back(query_parameters);
+				batch_results.push_back(memnew(NavigationPathQueryResult3D));
+			}
+			navigation_server->query_paths(batch_parameters, batch_results);
+
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+				navigation_server->query_path(batch_parameters[i], query_result);
+				Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				CHECK_NE(batch_result->get_path().size(), 0);
+				CHECK_EQ(batch_result->get_path(), query_result->get_path());
+				CHECK_EQ(batch_result->get_path_rids(), query_result->get_path_rids());
+			}
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should only merge changed regions again") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// Two unit squares sharing the edge at x == 1.
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_vertices({ Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(1, 0, 1), Vector3(0, 0, 1) });
+		navigation_mesh->add_polygon({ 0, 1, 2, 3 });
+
+		RID map = navigation_server->map_create();
+		RID region_a = navigation_server->region_create();
+		RID region_b = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_navigation_mesh(region_a, navigation_mesh);
+		navigation_server->region_set_navigation_mesh(region_b, navigation_mesh);
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(1, 0, 0)));
+		navigation_server->region_set_map(region_a, map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 1);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 4);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 0);
+
+		navigation_server->region_set_map(region_b, map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 2);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 7);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 1);
+		CHECK_EQ(navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(1.5, 0, 0.5), true).size(), 2);
+
+		SUBCASE("Removing a region should unmerge its edges") {
+			navigation_server->region_set_map(region_b, RID());
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 1);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 4);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 0);
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(1.5, 0, 0.5)).is_equal_approx(Vector3(1, 0, 0.5)));
+		}
+
+		SUBCASE("Moving a region should merge it again") {
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(5, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 8);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 0);
+
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(1, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 7);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 1);
+			CHECK_EQ(navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(1.5, 0, 0.5), true).size(), 2);
+		}
+
+		navigation_server->free(region_b);
+		navigation_server->free(region_a);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find paths with hierarchical pathfinding") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+
+		// Maps read the settings when they are created, one polygon per cluster forces a corridor search.
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/use_hierarchical_pathfinding", true);
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/hierarchical_cluster_size", 1);
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/use_hierarchical_pathfinding", false);
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/hierarchical_cluster_size", 64);
+
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_CLUSTER_COUNT), navigation_mesh->get_polygon_count());
+
+		const Vector3 origin = Vector3(-4.5, 0.0, -4.5);
+		const Vector3 destination = Vector3(4.5, 0.0, 4.5);
+		Vector<Vector3> path = navigation_server->map_get_path(map, origin, destination, true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[0].is_equal_approx(navigation_server->map_get_closest_point(map, origin)));
+		CHECK(path[path.size() - 1].is_equal_approx(navigation_server->map_get_closest_point(map, destination)));
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_CLUSTER_COUNT), 0);
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should bake and rebake navigation mesh tiles") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+
+		navigation_mesh->set_tile_size(16);
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		const int polygon_count = navigation_mesh->get_polygon_count();
+		CHECK_NE(polygon_count, 0);
+		CHECK_NE(navigation_mesh->get_vertices().size(), 0);
+
+		SUBCASE("Paths should cross the borders of baked tiles") {
+			// Polygons of the same region only connect through shared edges, so the tiles must line up exactly.
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			// The tiles are 4 units wide, the path crosses a tile border on both axes.
+			const Vector3 start = navigation_server->map_get_closest_point(map, Vector3(-3.0, 0.0, -3.0));
+			const Vector3 end = navigation_server->map_get_closest_point(map, Vector3(3.0, 0.0, 3.0));
+			CHECK_NE(navigation_server->map_get_closest_point_owner(map, end), RID());
+			const Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[0].is_equal_approx(start));
+			CHECK(path[path.size() - 1].is_equal_approx(end));
+
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+
+		SUBCASE("Rebaking tiles with unchanged geometry should keep the navigation mesh") {
+			navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, source_geometry, AABB(Vector3(-1.0, -1.0, -1.0), Vector3(2.0, 2.0, 2.0)), Callable());
+			CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+		}
+
+		SUBCASE("Rebaking tiles without geometry should only remove the affected tiles") {
+			Ref<NavigationMeshSourceGeometryData3D> partial_source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+			BoxMesh::create_mesh_array(arr, Vector3(4.0, 0.001, 10.0));
+			partial_source_geometry->add_mesh_array(arr, Transform3D(Basis(), Vector3(-3.0, 0.0, 0.0)));
+			navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, partial_source_geometry, AABB(Vector3(1.0, -1.0, -5.0), Vector3(4.0, 2.0, 10.0)), Callable());
+			CHECK_GT(navigation_mesh->get_polygon_count(), 0);
+			CHECK_LT(navigation_mesh->get_polygon_count(), polygon_count);
+			for (const Vector3 &vertex : navigation_mesh->get_vertices()) {
+				CHECK_LE(vertex.x, 4.0);
+			}
+		}
+
+		SUBCASE("Rebaking tiles after a change should match a full bake of the changed geometry") {
+			Ref<NavigationMeshSourceGeometryData3D> changed_source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+			BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+			changed_source_geometry->add_mesh_array(arr, Transform3D());
+			BoxMesh::create_mesh_array(arr, Vector3(1.0, 2.0, 1.0));
+			changed_source_geometry->add_mesh_array(arr, Transform3D(Basis(), Vector3(2.5, 1.0, 2.5)));
+
+			Ref<NavigationMesh> full_navigation_mesh = memnew(NavigationMesh);
+			full_navigation_mesh->set_tile_size(16);
+			navigation_server->bake_from_source_geometry_data(full_navigation_mesh, changed_source_geometry, Callable());
+			navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, changed_source_geometry, AABB(Vector3(2.0, -1.0, 2.0), Vector3(1.0, 4.0, 1.0)), Callable());
+			REQUIRE_EQ(navigation_mesh->get_polygon_count(), full_navigation_mesh->get_polygon_count());
+
+			// Polygons are merged in a different order, so compare them by their vertex positions.
+			Vector<Vector3> vertices = navigation_mesh->get_vertices();
+			Vector<Vector3> full_vertices = full_navigation_mesh->get_vertices();
+			REQUIRE_EQ(vertices.size(), full_vertices.size());
+			Vector<Vector3> polygon_sums;
+			Vector<Vector3> full_polygon_sums;
+			for (int i = 0; i < navigation_mesh->get_polygon_count(); i++) {
+				Vector3 polygon_sum;
+				for (int index : navigation_mesh->get_polygon(i)) {
+					polygon_sum += vertices[index];
+				}
+				polygon_sums.push_back(polygon_sum);
+				Vector3 full_polygon_sum;
+				for (int index : full_navigation_mesh->get_polygon(i)) {
+					full_polygon_sum += full_vertices[index];
+				}
+				full_polygon_sums.push_back(full_polygon_sum);
+			}
+			vertices.sort();
+			full_vertices.sort();
+			polygon_sums.sort();
+			full_polygon_sums.sort();
+			CHECK_EQ(vertices, full_vertices);
+			CHECK_EQ(polygon_sums, full_polygon_sums);
+		}
 	}
 
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
@@ -0,0 +1,1081 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-2024 Godot Engine contributors (see ORGAUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/thread.h"
+#include "servers/extensions/physics_server_3d_extension.h"
+#include "servers/physics_server_3d.h"
+#include "servers/physics_server_3d_wrap_mt.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestPhysicsServer3D {
+
+constexpr int BODY_COUNT = 8;
+constexpr int FRAME_COUNT = 60;
+constexpr real_t FRAME_STEP = 1.0 / 60.0;
+
+class AreaEventRecorder : public Object {
+	GDCLASS(AreaEventRecorder, Object);
+
+public:
+	int call_count = 0;
+	PackedInt32Array statuses;
+	Array rids;
+
+	void record(const PackedInt32Array &p_statuses, const Array &p_rids, const PackedInt64Array &p_instance_ids, const PackedInt32Array &p_other_shape_indices, const PackedInt32Array &p_self_shape_indices) {
+		call_count++;
+		statuses = p_statuses;
+		rids = p_rids;
+
+		CHECK_EQ(p_rids.size(), p_statuses.size());
+		CHECK_EQ(p_instance_ids.size(), p_statuses.size());
+		CHECK_EQ(p_other_shape_indices.size(), p_statuses.size());
+		CHECK_EQ(p_self_shape_indices.size(), p_statuses.size());
+	}
+};
+
+// Records the body state writes that reach it, to test what PhysicsServer3DWrapMT passes on.
+class RecordingPhysicsServer3D : public PhysicsServer3DExtension {
+	GDCLASS(RecordingPhysicsServer3D, PhysicsServer3DExtension);
+
+public:
+	HashMap<RID, Transform3D> transforms;
+	HashMap<RID, Vector3> linear_velocities;
+	LocalVector<BodyState> written_states;
+	Transform3D restored_transform;
+
+	virtual void init() override {}
+	virtual void step(real_t p_step) override {}
+	virtual void sync() override {}
+	virtual void flush_queries() override {}
+	virtual void end_sync() override {}
+	virtual void finish() override {}
+
+	virtual void body_set_state(RID p_body, BodyState p_state, const Variant &p_value) override {
+		written_states.push_back(p_state);
+		if (p_state == BODY_STATE_TRANSFORM) {
+			transforms[p_body] = p_value;
+		} else if (p_state == BODY_STATE_LINEAR_VELOCITY) {
+			linear_velocities[p_body] = p_value;
+		}
+	}
+
+	virtual Variant body_get_state(RID p_body, BodyState p_state) const override {
+		if (!transforms.has(p_body)) {
+			return Variant();
+		}
+
+		switch (p_state) {
+			case BODY_STATE_TRANSFORM:
+				return transforms[p_body];
+			case BODY_STATE_LINEAR_VELOCITY:
+				return linear_velocities.has(p_body) ? linear_velocities[p_body] : Vector3();
+			case BODY_STATE_ANGULAR_VELOCITY:
+				return Vector3();
+			case BODY_STATE_SLEEPING:
+				return false;
+			case BODY_STATE_CAN_SLEEP:
+				return true;
+		}
+
+		return Variant();
+	}
+
+	virtual bool body_move_character(RID p_body, const CharacterMotionParameters &p_parameters, CharacterMotionResult *r_result) override {
+		transforms[p_body].origin += p_parameters.velocity * p_parameters.delta;
+		return true;
+	}
+
+	virtual bool space_restore_state(RID p_space, const PackedByteArray &p_state, const PackedByteArray &p_previous_state) override {
+		for (KeyValue<RID, Transform3D> &E : transforms) {
+			E.value = restored_transform;
+		}
+		return true;
+	}
+};
+
+struct BodyStateReader {
+	PhysicsServer3D *server = nullptr;
+	RID body;
+	Transform3D transform;
+
+	static void read(void *p_userdata) {
+		BodyStateReader *reader = static_cast<BodyStateReader *>(p_userdata);
+		reader->transform = reader->server->body_get_state(reader->body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	}
+};
+
+struct ShapeCaster {
+	PhysicsDirectSpaceState3D *space_state = nullptr;
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	real_t closest_safe = 1.0;
+	real_t closest_unsafe = 1.0;
+	bool succeeded = false;
+
+	static void cast(void *p_userdata) {
+		ShapeCaster *caster = static_cast<ShapeCaster *>(p_userdata);
+		caster->succeeded = caster->space_state->cast_motion(caster->parameters, caster->closest_safe, caster->closest_unsafe);
+	}
+};
+
+static uint32_t hash_body_transforms(PhysicsServer3D *p_server, const LocalVector<RID> &p_bodies) {
+	uint32_t hash = HASH_MURMUR3_SEED;
+
+	for (const RID &body : p_bodies) {
+		const Transform3D transform = p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		hash = hash_murmur3_buffer(&transform, sizeof(Transform3D), hash);
+	}
+
+	return hash;
+}
+
+static uint32_t simulate(PhysicsServer3D *p_server, const LocalVector<RID> &p_bodies, int p_frame_count) {
+	for (int i = 0; i < p_frame_count; ++i) {
+		p_server->step(FRAME_STEP);
+	}
+
+	return hash_body_transforms(p_server, p_bodies);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Saving and restoring space state") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(shape, Vector3(0.5, 0.5, 0.5));
+
+	RID floor_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(floor_shape, Vector3(50, 0.5, 50));
+
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_space(floor, space);
+
+	LocalVector<RID> bodies;
+
+	for (int i = 0; i < BODY_COUNT; ++i) {
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		server->body_add_shape(body, shape);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(1, 0, 1).normalized(), i * 0.3), Vector3(i * 0.4, 1.0 + i * 1.1, 0)));
+		server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	server->set_active(true);
+
+	// Let the bodies fall for a while first, so that the saved state has contacts in it.
+	simulate(server, bodies, FRAME_COUNT / 2);
+
+	const PackedByteArray state = server->space_save_state(space);
+	REQUIRE_FALSE(state.is_empty());
+
+	const uint32_t first_hash = simulate(server, bodies, FRAME_COUNT);
+	const PackedByteArray first_end_state = server->space_save_state(space);
+
+	SUBCASE("Re-simulating from a restored state should be deterministic") {
+		REQUIRE(server->space_restore_state(space, state));
+		CHECK_EQ(server->space_save_state(space), state);
+
+		const uint32_t second_hash = simulate(server, bodies, FRAME_COUNT);
+		CHECK_EQ(second_hash, first_hash);
+		CHECK_EQ(server->space_save_state(space), first_end_state);
+	}
+
+	SUBCASE("Delta-encoded states should restore identically") {
+		const PackedByteArray delta_state = server->space_save_state(space, state);
+		REQUIRE_FALSE(delta_state.is_empty());
+
+		REQUIRE(server->space_restore_state(space, state));
+		REQUIRE(server->space_restore_state(space, delta_state, state));
+		CHECK_EQ(server->space_save_state(space), first_end_state);
+		CHECK_EQ(hash_body_transforms(server, bodies), first_hash);
+	}
+
+	SUBCASE("Restoring a delta-encoded state without its previous state should fail") {
+		const PackedByteArray delta_state = server->space_save_state(space, state);
+
+		if (delta_state.size() < first_end_state.size()) {
+			ERR_PRINT_OFF;
+			CHECK_FALSE(server->space_restore_state(space, delta_state));
+			ERR_PRINT_ON;
+		}
+	}
+
+	SUBCASE("Restoring invalid data should fail") {
+		ERR_PRINT_OFF;
+		CHECK_FALSE(server->space_restore_state(space, PackedByteArray()));
+		CHECK_FALSE(server->space_restore_state(space, first_end_state.slice(0, first_end_state.size() / 2)));
+
+		// A truncated previous state must not be read past its end.
+		const PackedByteArray delta_state = server->space_save_state(space, state);
+		CHECK_FALSE(server->space_restore_state(space, delta_state, state.slice(0, state.size() / 2)));
+
+		// A header claiming a huge state must be rejected before anything is allocated for it.
+		PackedByteArray huge_state = delta_state.slice(0, 16);
+		encode_uint32(1, huge_state.ptrw() + 4);
+		encode_uint32(0xFFFFFFF0, huge_state.ptrw() + 12);
+		CHECK_FALSE(server->space_restore_state(space, huge_state, state));
+		ERR_PRINT_ON;
+
+		CHECK_EQ(server->space_save_state(space), first_end_state);
+	}
+
+	server->set_active(false);
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+
+	server->free(floor);
+	server->free(floor_shape);
+	server->free(shape);
+	server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Stepping several spaces") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	constexpr int SPACE_COUNT = 4;
+
+	RID shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(shape, Vector3(0.5, 0.5, 0.5));
+
+	RID floor_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(floor_shape, Vector3(50, 0.5, 50));
+
+	LocalVector<RID> spaces;
+	LocalVector<RID> floors;
+	LocalVector<RID> bodies_by_space[SPACE_COUNT];
+
+	for (int space_index = 0; space_index < SPACE_COUNT; ++space_index) {
+		RID space = server->space_create();
+		server->space_set_active(space, true);
+		spaces.push_back(space);
+
+		RID floor = server->body_create();
+		server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(floor, floor_shape);
+		server->body_set_space(floor, space);
+		floors.push_back(floor);
+
+		for (int i = 0; i < BODY_COUNT; ++i) {
+			RID body = server->body_create();
+			server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+			server->body_add_shape(body, shape);
+			server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(1, 0, 1).normalized(), i * 0.3), Vector3(i * 0.4, 1.0 + i * 1.1, 0)));
+			server->body_set_space(body, space);
+			bodies_by_space[space_index].push_back(body);
+		}
+	}
+
+	server->set_active(true);
+
+	for (int i = 0; i < FRAME_COUNT; ++i) {
+		server->step(FRAME_STEP);
+	}
+
+	server->set_active(false);
+
+	// Identical spaces should end up in identical states, regardless of whether they were stepped in parallel.
+	const uint32_t first_hash = hash_body_transforms(server, bodies_by_space[0]);
+
+	for (int space_index = 0; space_index < SPACE_COUNT; ++space_index) {
+		CHECK_EQ(hash_body_transforms(server, bodies_by_space[space_index]), first_hash);
+		CHECK(server->space_get_step_time(spaces[space_index]) >= 0.0);
+
+		for (const RID &body : bodies_by_space[space_index]) {
+			server->free(body);
+		}
+
+		server->free(floors[space_index]);
+		server->free(spaces[space_index]);
+	}
+
+	server->free(floor_shape);
+	server->free(shape);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Reading bodies from another thread during a pipelined step") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	// Spaces pick up the setting when they are created.
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/threading/pipelined_step", true);
+	RID space = server->space_create();
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/threading/pipelined_step", false);
+	server->space_set_active(space, true);
+
+	RID shape = server->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+	server->shape_set_data(shape, 0.5);
+
+	RID body = server->body_create();
+	server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+	server->body_add_shape(body, shape);
+	server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 10, 0)));
+	server->body_set_space(body, space);
+	server->body_set_param(body, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+	server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(0, -5, 0));
+
+	BodyStateReader reader;
+	reader.server = server;
+	reader.body = body;
+
+	server->set_active(true);
+
+	real_t previous_y = 10.0;
+
+	for (int i = 0; i < FRAME_COUNT / 4; ++i) {
+		server->step(FRAME_STEP);
+
+		// The other thread has to wait for the running update, but leaves completing the step to this thread.
+		Thread thread;
+		thread.start(&BodyStateReader::read, &reader);
+		thread.wait_to_finish();
+
+		const Transform3D transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_EQ(reader.transform, transform);
+		CHECK_LT(transform.origin.y, previous_y);
+		previous_y = transform.origin.y;
+	}
+
+	server->set_active(false);
+
+	server->free(body);
+	server->free(shape);
+	server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Building shapes in the background") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/threading/background_shape_building", true);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID floor_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(floor_shape, Vector3(50, 0.5, 50));
+
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_space(floor, space);
+
+	PackedVector3Array vertices;
+	for (int i = 0; i < 8; ++i) {
+		vertices.push_back(Vector3((i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5, (i & 4) ? 0.5 : -0.5));
+	}
+
+	RID shape = server->shape_create(PhysicsServer3D::SHAPE_CONVEX_POLYGON);
+	server->shape_set_data(shape, vertices);
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+	REQUIRE(space_state != nullptr);
+
+	ShapeCaster caster;
+	caster.space_state = space_state;
+	caster.parameters.shape_rid = shape;
+	caster.parameters.transform = Transform3D(Basis(), Vector3(0, 5, 0));
+	caster.parameters.motion = Vector3(0, -10, 0);
+
+	SUBCASE("Queries should wait for the shape to be built") {
+		ShapeCaster::cast(&caster);
+		REQUIRE(caster.succeeded);
+		CHECK(caster.closest_safe == doctest::Approx(0.4).epsilon(0.01));
+	}
+
+	SUBCASE("Queries from pool threads should not have to wait for the older build task") {
+		const WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_singleton()->add_native_task(&ShapeCaster::cast, &caster, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+		REQUIRE(caster.succeeded);
+		CHECK(caster.closest_safe == doctest::Approx(0.4).epsilon(0.01));
+
+		// Any build task left behind by the pool thread is released at the next step.
+		server->set_active(true);
+		server->step(FRAME_STEP);
+		server->set_active(false);
+	}
+
+	SUBCASE("Bodies should pick up the shape once it has been built") {
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(body, shape);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 5, 0)));
+		server->body_set_space(body, space);
+
+		ShapeCaster::cast(&caster);
+
+		server->set_active(true);
+		server->step(FRAME_STEP);
+		server->set_active(false);
+
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		parameters.from = Vector3(0, 10, 0);
+		parameters.to = Vector3(0, -10, 0);
+
+		PhysicsDirectSpaceState3D::RayResult result;
+		REQUIRE(space_state->intersect_ray(parameters, result));
+		CHECK_EQ(result.rid, body);
+		CHECK(result.position.y == doctest::Approx(5.5));
+
+		server->free(body);
+	}
+
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/threading/background_shape_building", false);
+
+	server->free(shape);
+	server->free(floor);
+	server->free(floor_shape);
+	server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Caching built shapes") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	// Removes the cache directory along with anything a previous run left behind.
+	auto remove_cache_dir = [](const String &p_cache_dir) {
+		for (const String &file : DirAccess::get_files_at(p_cache_dir)) {
+			DirAccess::remove_absolute(p_cache_dir.path_join(file));
+		}
+		DirAccess::remove_absolute(p_cache_dir);
+	};
+
+	const String cache_dir = TestUtils::get_temp_path("jolt_shapes");
+	remove_cache_dir(cache_dir);
+	REQUIRE_EQ(DirAccess::make_dir_recursive_absolute(cache_dir), OK);
+
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/collisions/shape_cache", true);
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/collisions/shape_cache_path", cache_dir);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+	REQUIRE(space_state != nullptr);
+
+	const real_t height = 0.25;
+
+	PackedVector3Array faces;
+	faces.push_back(Vector3(-1, height, -1));
+	faces.push_back(Vector3(1, height, -1));
+	faces.push_back(Vector3(1, height, 1));
+	faces.push_back(Vector3(-1, height, -1));
+	faces.push_back(Vector3(1, height, 1));
+	faces.push_back(Vector3(-1, height, 1));
+
+	Dictionary data;
+	data["faces"] = faces;
+	data["backface_collision"] = false;
+
+	LocalVector<RID> shapes;
+	LocalVector<RID> bodies;
+
+	// Builds a new shape from the same faces, and checks that a body using it can be hit.
+	auto add_body = [&]() {
+		RID shape = server->shape_create(PhysicsServer3D::SHAPE_CONCAVE_POLYGON);
+		server->shape_set_data(shape, data);
+		shapes.push_back(shape);
+
+		const Vector3 origin(bodies.size() * 4.0, 0, 0);
+
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(body, shape);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), origin));
+		server->body_set_space(body, space);
+		bodies.push_back(body);
+
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		parameters.from = origin + Vector3(0, 5, 0);
+		parameters.to = origin + Vector3(0, -5, 0);
+
+		PhysicsDirectSpaceState3D::RayResult result;
+		REQUIRE(space_state->intersect_ray(parameters, result));
+		CHECK_EQ(result.rid, body);
+		CHECK(result.position.y == doctest::Approx(height));
+	};
+
+	add_body();
+
+	const PackedStringArray cache_files = DirAccess::get_files_at(cache_dir);
+	REQUIRE_EQ(cache_files.size(), 1);
+	const String cache_path = cache_dir.path_join(cache_files[0]);
+
+	const Vector<uint8_t> cached_bytes = FileAccess::get_file_as_bytes(cache_path);
+	REQUIRE_GT(cached_bytes.size(), 8);
+
+	SUBCASE("Identical geometry should be loaded from the cache") {
+		add_body();
+		CHECK_EQ(DirAccess::get_files_at(cache_dir).size(), 1);
+		CHECK_EQ(FileAccess::get_file_as_bytes(cache_path), cached_bytes);
+	}
+
+	SUBCASE("Corrupted entries should be evicted and cached again") {
+		// Keep the header intact, so that the entry only fails once the shape itself is restored.
+		Ref<FileAccess> file_access = FileAccess::open(cache_path, FileAccess::WRITE);
+		REQUIRE(file_access.is_valid());
+		file_access->store_buffer(cached_bytes.ptr(), 8);
+		file_access->store_32(0xdeadbeef);
+		file_access.unref();
+
+		ERR_PRINT_OFF;
+		add_body();
+		ERR_PRINT_ON;
+
+		CHECK_EQ(FileAccess::get_file_as_bytes(cache_path), cached_bytes);
+	}
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+
+	for (const RID &shape : shapes) {
+		server->free(shape);
+	}
+
+	server->free(space);
+
+	remove_cache_dir(cache_dir);
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/collisions/shape_cache", false);
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/collisions/shape_cache_path", "");
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Creating bodies in a batch") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID shape = server->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+	server->shape_set_data(shape, 0.5);
+
+	Vector<Transform3D> transforms;
+	for (int i = 0; i < BODY_COUNT; ++i) {
+		transforms.push_back(Transform3D(Basis(), Vector3(i * 2.0, 5.0, 0)));
+	}
+
+	const Vector<RID> bodies = server->body_create_batch(space, PhysicsServer3D::BODY_MODE_RIGID, shape, transforms, 2, 3);
+	REQUIRE_EQ(bodies.size(), BODY_COUNT);
+
+	for (int i = 0; i < BODY_COUNT; ++i) {
+		CHECK_EQ(server->body_get_space(bodies[i]), space);
+		CHECK_EQ(server->body_get_shape_count(bodies[i]), 1);
+		CHECK_EQ(server->body_get_collision_layer(bodies[i]), 2u);
+		CHECK_EQ(server->body_get_collision_mask(bodies[i]), 3u);
+		CHECK_EQ(Transform3D(server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM)), transforms[i]);
+	}
+
+	// Bodies added in a batch should be able to take impulses right away.
+	server->body_apply_central_impulse(bodies[0], Vector3(0, 10, 0));
+	CHECK(Vector3(server->body_get_state(bodies[0], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)).y > 0.0);
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+
+	// Freed bodies may be recycled, which should leave no trace of their previous state.
+	RID body = server->body_create();
+	CHECK_EQ(server->body_get_shape_count(body), 0);
+	CHECK_EQ(server->body_get_collision_layer(body), 1u);
+	CHECK_FALSE(server->body_get_space(body).is_valid());
+
+	server->free(body);
+	server->free(shape);
+	server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched area monitoring") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(shape, Vector3(0.5, 0.5, 0.5));
+
+	RID area_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(area_shape, Vector3(10, 10, 10));
+
+	AreaEventRecorder *recorder = memnew(AreaEventRecorder);
+
+	RID area = server->area_create();
+	server->area_add_shape(area, area_shape);
+	server->area_set_monitor_batching(area, true);
+	server->area_set_monitor_callback(area, callable_mp(recorder, &AreaEventRecorder::record));
+	server->area_set_space(area, space);
+
+	LocalVector<RID> bodies;
+
+	for (int i = 0; i < BODY_COUNT; ++i) {
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer3D::BODY_MODE_KINEMATIC);
+		server->body_add_shape(body, shape);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i * 2.0 - BODY_COUNT, 0, 0)));
+		server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	server->set_active(true);
+
+	server->step(FRAME_STEP);
+	server->flush_queries();
+
+	CHECK_EQ(recorder->call_count, 1);
+	REQUIRE_EQ(recorder->statuses.size(), BODY_COUNT);
+
+	for (int i = 0; i < BODY_COUNT; ++i) {
+		CHECK_EQ(recorder->statuses[i], PhysicsServer3D::AREA_BODY_ADDED);
+		CHECK(bodies.has(recorder->rids[i]));
+	}
+
+	for (const RID &body : bodies) {
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 100, 0)));
+	}
+
+	server->step(FRAME_STEP);
+	server->flush_queries();
+
+	CHECK_EQ(recorder->call_count, 2);
+	REQUIRE_EQ(recorder->statuses.size(), BODY_COUNT);
+
+	for (int i = 0; i < BODY_COUNT; ++i) {
+		CHECK_EQ(recorder->statuses[i], PhysicsServer3D::AREA_BODY_REMOVED);
+	}
+
+	// Steps without any changes in overlap shouldn't report anything.
+	server->step(FRAME_STEP);
+	server->flush_queries();
+
+	CHECK_EQ(recorder->call_count, 2);
+
+	server->set_active(false);
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+
+	server->free(area);
+	server->free(area_shape);
+	server->free(shape);
+	server->free(space);
+
+	memdelete(recorder);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Updating a region of a heightmap shape") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	constexpr int MAP_SIZE = 65;
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	Vector<real_t> heights;
+	heights.resize(MAP_SIZE * MAP_SIZE);
+	heights.fill(0.0);
+
+	Dictionary data;
+	data["width"] = MAP_SIZE;
+	data["depth"] = MAP_SIZE;
+	data["heights"] = heights;
+
+	RID shape = server->shape_create(PhysicsServer3D::SHAPE_HEIGHTMAP);
+	server->shape_set_data(shape, data);
+
+	RID body = server->body_create();
+	server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(body, shape);
+	server->body_set_space(body, space);
+
+	// Raise a 5x5 patch around the center of the map, which sits at the origin.
+	Vector<real_t> region_heights;
+	region_heights.resize(5 * 5);
+	region_heights.fill(4.0);
+
+	const Rect2i region(MAP_SIZE / 2 - 2, MAP_SIZE / 2 - 2, 5, 5);
+	server->heightmap_shape_update_region(shape, region, region_heights);
+
+	// Any rebuilt parts of the shape are only guaranteed to be swapped in at the next step.
+	server->set_active(true);
+	server->step(FRAME_STEP);
+	server->set_active(false);
+
+	const Vector<real_t> updated_heights = Dictionary(server->shape_get_data(shape))["heights"];
+	REQUIRE_EQ(updated_heights.size(), MAP_SIZE * MAP_SIZE);
+	CHECK_EQ(updated_heights[(MAP_SIZE / 2) * MAP_SIZE + MAP_SIZE / 2], 4.0);
+	CHECK_EQ(updated_heights[0], 0.0);
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+	REQUIRE(space_state != nullptr);
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	PhysicsDirectSpaceState3D::RayResult result;
+
+	parameters.from = Vector3(0, 10, 0);
+	parameters.to = Vector3(0, -10, 0);
+	REQUIRE(space_state->intersect_ray(parameters, result));
+	CHECK(result.position.y == doctest::Approx(4.0));
+
+	parameters.from = Vector3(20, 10, 20);
+	parameters.to = Vector3(20, -10, 20);
+	REQUIRE(space_state->intersect_ray(parameters, result));
+	CHECK(result.position.y == doctest::Approx(0.0));
+
+	ERR_PRINT_OFF;
+	server->heightmap_shape_update_region(shape, Rect2i(MAP_SIZE - 2, 0, 5, 5), region_heights);
+	ERR_PRINT_ON;
+
+	CHECK_EQ(Dictionary(server->shape_get_data(shape))["heights"], Variant(updated_heights));
+
+	server->free(body);
+	server->free(shape);
+	server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched queries should match single queries") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	constexpr int GRID_SIZE = 12;
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID floor_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(floor_shape, Vector3(50, 0.5, 50));
+
+	RID box_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_space(floor, space);
+
+	LocalVector<RID> bodies;
+
+	for (int i = 0; i < BODY_COUNT; ++i) {
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(body, box_shape);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(0, 1, 0), i * 0.4), Vector3(i * 1.3 - 5.0, 1.0 + i * 0.5, i * 0.7 - 3.0)));
+		server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+	REQUIRE(space_state != nullptr);
+
+	// Enough queries to be split across several worker thread pool tasks.
+	Vector<Vector3> from;
+	Vector<Vector3> to;
+	Vector<Vector3> motions;
+
+	for (int z = 0; z < GRID_SIZE; ++z) {
+		for (int x = 0; x < GRID_SIZE; ++x) {
+			const Vector3 origin(x - GRID_SIZE * 0.5, 8.0, z - GRID_SIZE * 0.5);
+			from.push_back(origin);
+			to.push_back(origin + Vector3(x % 3 - 1.0, -16.0, z % 3 - 1.0));
+			motions.push_back(Vector3((x % 2) * 4.0 - 2.0, -12.0, 0));
+		}
+	}
+
+	const int query_count = from.size();
+
+	SUBCASE("Casting rays") {
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+
+		Vector<PhysicsDirectSpaceState3D::RayResult> results;
+		results.resize(query_count);
+		LocalVector<bool> hits;
+		hits.resize(query_count);
+
+		const int hit_count = space_state->intersect_rays_batch(parameters, from.ptr(), to.ptr(), query_count, results.ptrw(), hits.ptr());
+
+		int single_hit_count = 0;
+
+		for (int i = 0; i < query_count; ++i) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+
+			PhysicsDirectSpaceState3D::RayResult result;
+			const bool hit = space_state->intersect_ray(parameters, result);
+			REQUIRE_EQ(hits[i], hit);
+
+			if (hit) {
+				single_hit_count++;
+				CHECK(results[i].position.is_equal_approx(result.position));
+				CHECK(results[i].normal.is_equal_approx(result.normal));
+				CHECK_EQ(results[i].rid, result.rid);
+				CHECK_EQ(results[i].shape, result.shape);
+			}
+		}
+
+		CHECK_EQ(hit_count, single_hit_count);
+		CHECK_GT(hit_count, 0);
+	}
+
+	SUBCASE("Casting shapes") {
+		RID sphere_shape = server->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+		server->shape_set_data(sphere_shape, 0.4);
+
+		// Non-convex shapes are accepted by both kinds of queries.
+		PackedVector3Array faces;
+		faces.push_back(Vector3(-0.5, 0, -0.5));
+		faces.push_back(Vector3(0.5, 0, -0.5));
+		faces.push_back(Vector3(0.5, 0, 0.5));
+		faces.push_back(Vector3(-0.5, 0, -0.5));
+		faces.push_back(Vector3(0.5, 0, 0.5));
+		faces.push_back(Vector3(-0.5, 0, 0.5));
+
+		Dictionary concave_data;
+		concave_data["faces"] = faces;
+		concave_data["backface_collision"] = false;
+
+		RID concave_shape = server->shape_create(PhysicsServer3D::SHAPE_CONCAVE_POLYGON);
+		server->shape_set_data(concave_shape, concave_data);
+
+		for (const RID &shape : { box_shape, sphere_shape, concave_shape }) {
+			PhysicsDirectSpaceState3D::ShapeParameters parameters;
+			parameters.shape_rid = shape;
+			parameters.transform = Transform3D(Basis(Vector3(1, 0, 0), 0.3), Vector3());
+
+			Vector<real_t> closest_safe;
+			closest_safe.resize(query_count);
+			Vector<real_t> closest_unsafe;
+			closest_unsafe.resize(query_count);
+
+			REQUIRE(space_state->cast_motion_batch(parameters, from.ptr(), motions.ptr(), query_count, closest_safe.ptrw(), closest_unsafe.ptrw()));
+
+			for (int i = 0; i < query_count; ++i) {
+				parameters.transform.origin = from[i];
+				parameters.motion = motions[i];
+
+				real_t safe = 0.0;
+				real_t unsafe = 0.0;
+				REQUIRE(space_state->cast_motion(parameters, safe, unsafe));
+				CHECK(closest_safe[i] == doctest::Approx(safe));
+				CHECK(closest_unsafe[i] == doctest::Approx(unsafe));
+			}
+		}
+
+		server->free(concave_shape);
+		server->free(sphere_shape);
+	}
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+
+	server->free(floor);
+	server->free(box_shape);
+	server->free(floor_shape);
+	server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Moving a character that comes to rest") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID floor_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(floor_shape, Vector3(50, 0.5, 50));
+
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_space(floor, space);
+
+	RID shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(shape, Vector3(0.5, 0.5, 0.5));
+
+	RID character = server->body_create();
+	server->body_set_mode(character, PhysicsServer3D::BODY_MODE_KINEMATIC);
+	server->body_add_shape(character, shape);
+	server->body_set_space(character, space);
+
+	server->set_active(true);
+	server->step(FRAME_STEP);
+	server->sync();
+	server->end_sync();
+
+	PhysicsServer3D::CharacterMotionParameters parameters;
+	parameters.from = Transform3D(Basis(), Vector3(0, 1.2, 0));
+	parameters.delta = FRAME_STEP;
+	parameters.floor_snap_length = 0.1;
+
+	PhysicsServer3D::CharacterMotionResult result;
+
+	// Lands the character on the floor first, so that it is supported.
+	parameters.velocity = Vector3(0, -6, 0);
+	for (int i = 0; i < FRAME_COUNT / 2; ++i) {
+		REQUIRE(server->body_move_character(character, parameters, &result));
+		parameters.from = result.transform;
+	}
+	REQUIRE(result.transform.origin.y == doctest::Approx(1.0).epsilon(0.01));
+
+	parameters.velocity = Vector3(2, 0, 0);
+	REQUIRE(server->body_move_character(character, parameters, &result));
+	CHECK(result.velocity.is_equal_approx(Vector3(2, 0, 0)));
+	CHECK(result.travel.x > 0);
+	parameters.from = result.transform;
+
+	SUBCASE("Stopping should report the new velocity") {
+		parameters.velocity = Vector3();
+		REQUIRE(server->body_move_character(character, parameters, &result));
+		CHECK(result.velocity.is_zero_approx());
+		CHECK(result.travel.is_zero_approx());
+
+		// Moves while at rest should leave the character where it is.
+		const Transform3D resting_transform = result.transform;
+		for (int i = 0; i < 3; ++i) {
+			parameters.from = result.transform;
+			REQUIRE(server->body_move_character(character, parameters, &result));
+			CHECK(result.velocity.is_zero_approx());
+			CHECK(result.transform.is_equal_approx(resting_transform));
+		}
+	}
+
+	SUBCASE("Moving again after resting should not be skipped") {
+		parameters.velocity = Vector3();
+		REQUIRE(server->body_move_character(character, parameters, &result));
+		parameters.from = result.transform;
+
+		parameters.velocity = Vector3(-2, 0, 0);
+		REQUIRE(server->body_move_character(character, parameters, &result));
+		CHECK(result.velocity.is_equal_approx(Vector3(-2, 0, 0)));
+		CHECK(result.travel.x < 0);
+	}
+
+	server->set_active(false);
+
+	server->free(character);
+	server->free(shape);
+	server->free(floor);
+	server->free(floor_shape);
+	server->free(space);
+}
+
+TEST_CASE("[PhysicsServer3D] Mirrored body states on a threaded server") {
+	PhysicsServer3D *main_server = PhysicsServer3D::get_singleton();
+
+	RecordingPhysicsServer3D *recorder = memnew(RecordingPhysicsServer3D);
+	PhysicsServer3DWrapMT *server = memnew(PhysicsServer3DWrapMT(recorder, true));
+	server->init();
+
+	const RID body = RID::from_uint64(1);
+	const RID space = RID::from_uint64(2);
+	const Transform3D start_transform(Basis(), Vector3(1, 2, 3));
+	recorder->transforms[body] = start_transform;
+
+	// Publishes the mirrored states of a step, and waits for the server thread to finish it.
+	auto step = [&]() {
+		server->step(FRAME_STEP);
+		server->sync();
+		server->end_sync();
+	};
+
+	// The first read requests the body to be mirrored from the next step on.
+	CHECK_EQ(Transform3D(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), start_transform);
+	step();
+
+	SUBCASE("Reads should be served from the last published step") {
+		recorder->transforms[body] = Transform3D(Basis(), Vector3(4, 5, 6));
+		CHECK_EQ(Transform3D(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), start_transform);
+
+		step();
+		CHECK_EQ(Transform3D(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), Transform3D(Basis(), Vector3(4, 5, 6)));
+	}
+
+	SUBCASE("Coalesced writes should be applied in call order") {
+		const Transform3D transform(Basis(), Vector3(7, 8, 9));
+
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(1, 0, 0));
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, transform);
+		CHECK_EQ(Vector3(server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)), Vector3(1, 0, 0));
+		CHECK_EQ(Transform3D(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), transform);
+
+		step();
+		REQUIRE_EQ(recorder->written_states.size(), 2u);
+		CHECK_EQ(recorder->written_states[0], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		CHECK_EQ(recorder->written_states[1], PhysicsServer3D::BODY_STATE_TRANSFORM);
+
+		// Only the last write of a state is applied, in the place of that write.
+		recorder->written_states.clear();
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(2, 0, 0));
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, start_transform);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(3, 0, 0));
+
+		step();
+		REQUIRE_EQ(recorder->written_states.size(), 2u);
+		CHECK_EQ(recorder->written_states[0], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_EQ(recorder->written_states[1], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		CHECK_EQ(recorder->linear_velocities[body], Vector3(3, 0, 0));
+	}
+
+	SUBCASE("Moving a character should invalidate its mirror") {
+		const Transform3D transform(Basis(), Vector3(0, 10, 0));
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, transform);
+
+		PhysicsServer3D::CharacterMotionParameters parameters;
+		parameters.velocity = Vector3(0, -60, 0);
+		parameters.delta = FRAME_STEP;
+		REQUIRE(server->body_move_character(body, parameters, nullptr));
+
+		// The pending transform has to reach the server before the move does.
+		CHECK(Transform3D(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)).is_equal_approx(Transform3D(Basis(), Vector3(0, 9, 0))));
+	}
+
+	SUBCASE("Restoring a space should invalidate its mirrors") {
+		recorder->restored_transform = Transform3D(Basis(), Vector3(-1, -2, -3));
+		REQUIRE(server->space_restore_state(space, PackedByteArray()));
+		CHECK_EQ(Transform3D(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)), recorder->restored_transform);
+	}
+
+	server->finish();
+	memdelete(server);
+
+	PhysicsServer3D::set_singleton_for_tests(main_server);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H